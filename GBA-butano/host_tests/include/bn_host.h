@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_HOST_H
+#define BN_HOST_H
+
+// Included before any other header by the host tests makefile.
+//
+// On 64-bit hosts int64_t is long, so the long and int64_t overloads of bn::ostringstream collide.
+// int64_t is replaced by long long as on the GBA, after including every standard header which names it.
+
+#include <cstdint>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <algorithm>
+
+using bn_host_int64 = long long;
+using bn_host_uint64 = unsigned long long;
+
+#define int64_t bn_host_int64
+#define uint64_t bn_host_uint64
+
+#endif
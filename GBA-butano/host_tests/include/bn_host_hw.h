@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_HOST_HW_H
+#define BN_HOST_HW_H
+
+#include "bn_common.h"
+
+// Host replacement of the hardware layer used by the engine code built in the host tests.
+namespace bn::host
+{
+    // Thrown by SRAM writes when the write budget runs out, to simulate turning off the console in the middle
+    // of a write.
+    class power_off
+    {
+    };
+
+    [[nodiscard]] uint8_t* sram_data();
+
+    // Sets how many SRAM bytes can be written before throwing power_off (-1 means unlimited).
+    // The bytes of the interrupted write before the limit are written.
+    void set_sram_write_budget(int bytes);
+
+    // Returns the number of SRAM bytes written since the start.
+    [[nodiscard]] int sram_written_bytes();
+}
+
+#endif
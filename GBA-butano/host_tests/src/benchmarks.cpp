@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_list.h"
+#include "bn_deque.h"
+#include "bn_vector.h"
+#include "bn_random.h"
+#include "bn_unordered_map.h"
+#include "bn_dense_unordered_map.h"
+#include "bn_best_fit_allocator.h"
+
+// Host timings only show relative changes, ARM9TDMI timings must be measured with the profiler example.
+
+namespace
+{
+
+constexpr int containers_size = 512;
+constexpr int its = 2000;
+
+class benchmark
+{
+
+public:
+    explicit benchmark(const char* name) :
+        _name(name),
+        _start(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~benchmark()
+    {
+        auto elapsed = std::chrono::steady_clock::now() - _start;
+        auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+        std::printf("%-32s %10lld us\n", _name, (long long)(microseconds));
+    }
+
+private:
+    const char* _name;
+    std::chrono::steady_clock::time_point _start;
+};
+
+int integer = 0;
+
+void vector_benchmark()
+{
+    static bn::vector<int, containers_size> vector;
+    benchmark benchmark("vector");
+
+    for(int it = 0; it < its; ++it)
+    {
+        for(int i = 0; i < containers_size; ++i)
+        {
+            vector.push_back(i);
+        }
+
+        for(int value : vector)
+        {
+            integer += value;
+        }
+
+        vector.erase(vector.begin(), vector.begin() + (containers_size / 2));
+        vector.clear();
+    }
+}
+
+void deque_benchmark()
+{
+    static bn::deque<int, containers_size> deque;
+    benchmark benchmark("deque");
+
+    for(int it = 0; it < its; ++it)
+    {
+        for(int i = 0; i < containers_size / 2; ++i)
+        {
+            deque.push_back(i);
+            deque.push_front(i);
+        }
+
+        for(int value : deque)
+        {
+            integer += value;
+        }
+
+        while(! deque.empty())
+        {
+            integer += deque.front();
+            deque.pop_front();
+        }
+    }
+}
+
+void list_benchmark()
+{
+    static bn::list<int, containers_size> list;
+    benchmark benchmark("list");
+
+    for(int it = 0; it < its; ++it)
+    {
+        for(int i = 0; i < containers_size; ++i)
+        {
+            list.push_back(i);
+        }
+
+        for(int value : list)
+        {
+            integer += value;
+        }
+
+        list.clear();
+    }
+}
+
+template<class Map>
+void map_benchmark(Map& map, const char* name)
+{
+    unsigned keys[containers_size];
+    bn::random random;
+
+    for(unsigned& key : keys)
+    {
+        key = random.get();
+    }
+
+    benchmark benchmark(name);
+
+    for(int it = 0; it < its; ++it)
+    {
+        for(int i = 0; i < containers_size; ++i)
+        {
+            map.insert(keys[i], i);
+        }
+
+        for(int i = 0; i < containers_size; ++i)
+        {
+            integer += map.find(keys[(i * 7) % containers_size])->second;
+        }
+
+        for(int i = 0; i < containers_size / 2; ++i)
+        {
+            map.erase(keys[i]);
+        }
+
+        for(int iteration = 0; iteration < 10; ++iteration)
+        {
+            for(const auto& pair : map)
+            {
+                integer += pair.second;
+            }
+        }
+
+        map.clear();
+    }
+}
+
+void unordered_map_benchmark()
+{
+    static bn::unordered_map<unsigned, int, containers_size * 2> map;
+    map_benchmark(map, "unordered_map");
+}
+
+void dense_unordered_map_benchmark()
+{
+    static bn::dense_unordered_map<unsigned, int, containers_size> map;
+    map_benchmark(map, "dense_unordered_map");
+}
+
+[[nodiscard]] int best_fit_allocator_max_alloc_bytes(bn::best_fit_allocator& allocator)
+{
+    int min_bytes = 0;
+    int max_bytes = allocator.available_bytes();
+
+    while(min_bytes < max_bytes)
+    {
+        int bytes = (min_bytes + max_bytes + 1) / 2;
+
+        if(void* ptr = allocator.alloc(bytes))
+        {
+            allocator.free(ptr);
+            min_bytes = bytes;
+        }
+        else
+        {
+            max_bytes = bytes - 1;
+        }
+    }
+
+    return min_bytes;
+}
+
+void best_fit_allocator_benchmark()
+{
+    constexpr int buffer_size = 16 * 1024;
+
+    alignas(8) static char buffer[buffer_size];
+    static bn::vector<void*, containers_size> ptrs;
+    bn::best_fit_allocator allocator(buffer, buffer_size);
+    bn::random random;
+
+    {
+        benchmark benchmark("best_fit_allocator");
+
+        for(int i = 0; i < its * containers_size; ++i)
+        {
+            if(ptrs.full() || (! ptrs.empty() && random.get_bool()))
+            {
+                int index = random.get_int(ptrs.size());
+                allocator.free(ptrs[index]);
+                ptrs[index] = ptrs.back();
+                ptrs.pop_back();
+            }
+            else if(void* ptr = allocator.alloc(random.get_int(4, 128)))
+            {
+                ptrs.push_back(ptr);
+            }
+        }
+    }
+
+    std::printf("best_fit_allocator - allocations: %d - available bytes: %d - max alloc bytes: %d\n",
+                ptrs.size(), allocator.available_bytes(), best_fit_allocator_max_alloc_bytes(allocator));
+
+    for(void* ptr : ptrs)
+    {
+        allocator.free(ptr);
+    }
+
+    ptrs.clear();
+}
+
+}
+
+int main()
+{
+    vector_benchmark();
+    deque_benchmark();
+    list_benchmark();
+    unordered_map_benchmark();
+    dense_unordered_map_benchmark();
+    best_fit_allocator_benchmark();
+    std::printf("(%d)\n", integer);
+    return 0;
+}
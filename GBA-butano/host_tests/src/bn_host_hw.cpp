@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_host_hw.h"
+
+#include "bn_log.h"
+#include "bn_sram.h"
+#include "bn_span.h"
+#include "bn_timer.h"
+#include "bn_cstring.h"
+#include "bn_memory.h"
+#include "bn_array.h"
+#include "bn_istring_base.h"
+#include "../../hw/include/bn_hw_text.h"
+
+namespace
+{
+    class static_data
+    {
+
+    public:
+        uint8_t sram[bn::sram::size()] = {};
+        int sram_write_budget = -1;
+        int sram_written_bytes = 0;
+    };
+
+    static_data data;
+
+    [[nodiscard]] unsigned gba_ticks()
+    {
+        // GBA timers run at 2^24 Hz:
+        auto elapsed = std::chrono::steady_clock::now().time_since_epoch();
+        auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        return unsigned(bn_host_uint64(double(nanoseconds) * 0.016777216));
+    }
+
+    template<typename Type>
+    [[nodiscard]] int parse_text(const char* format, Type value, bn::array<char, 32>& output)
+    {
+        return std::snprintf(output.data(), size_t(output.size()), format, value);
+    }
+
+    [[noreturn]] void show_assert(const char* condition, const char* file_name, const char* function, int line,
+                                  const char* message, int message_size)
+    {
+        std::fprintf(stderr, "ASSERT FAILED\n");
+
+        if(condition && *condition)
+        {
+            std::fprintf(stderr, "Condition: %s\n", condition);
+        }
+
+        std::fprintf(stderr, "File: %s, line %d", file_name, line);
+
+        if(function && *function)
+        {
+            std::fprintf(stderr, ", function %s", function);
+        }
+
+        std::fprintf(stderr, "\n");
+
+        if(message_size)
+        {
+            std::fprintf(stderr, "%.*s\n", message_size, message);
+        }
+
+        std::abort();
+    }
+}
+
+namespace bn::host
+{
+
+uint8_t* sram_data()
+{
+    return data.sram;
+}
+
+void set_sram_write_budget(int bytes)
+{
+    data.sram_write_budget = bytes;
+}
+
+int sram_written_bytes()
+{
+    return data.sram_written_bytes;
+}
+
+}
+
+namespace bn
+{
+
+void log(const istring_base& message)
+{
+    std::printf("%.*s\n", message.size(), message.data());
+}
+
+void log(log_level, const istring_base& message)
+{
+    log(message);
+}
+
+void memcpy(void* destination, const void* source, int bytes)
+{
+    BN_ASSERT(bytes >= 0, "Invalid bytes: ", bytes);
+    std::memcpy(destination, source, size_t(bytes));
+}
+
+void memset(void* destination, uint8_t value, int bytes)
+{
+    BN_ASSERT(bytes >= 0, "Invalid bytes: ", bytes);
+    std::memset(destination, value, size_t(bytes));
+}
+
+void memclear(void* destination, int bytes)
+{
+    BN_ASSERT(bytes >= 0, "Invalid bytes: ", bytes);
+    std::memset(destination, 0, size_t(bytes));
+}
+
+}
+
+namespace bn::hw::text
+{
+
+int parse(int value, array<char, 32>& output)
+{
+    return parse_text("%d", value, output);
+}
+
+int parse(long value, array<char, 32>& output)
+{
+    return parse_text("%ld", value, output);
+}
+
+int parse(int64_t value, array<char, 32>& output)
+{
+    return parse_text("%lld", value, output);
+}
+
+int parse(unsigned value, array<char, 32>& output)
+{
+    return parse_text("%u", value, output);
+}
+
+int parse(unsigned long value, array<char, 32>& output)
+{
+    return parse_text("%lu", value, output);
+}
+
+int parse(uint64_t value, array<char, 32>& output)
+{
+    return parse_text("%llu", value, output);
+}
+
+int parse(const void* ptr, array<char, 32>& output)
+{
+    return parse_text("%p", ptr, output);
+}
+
+}
+
+namespace _bn::assert
+{
+
+void show(const char* file_name, int line)
+{
+    show_assert(nullptr, file_name, nullptr, line, nullptr, 0);
+}
+
+void show(const char* condition, const char* file_name, const char* function, int line)
+{
+    show_assert(condition, file_name, function, line, nullptr, 0);
+}
+
+void show(const char* condition, const char* file_name, const char* function, int line, const char* message)
+{
+    show_assert(condition, file_name, function, line, message, int(std::strlen(message)));
+}
+
+void show(const char* condition, const char* file_name, const char* function, int line,
+          const bn::istring_base& message)
+{
+    show_assert(condition, file_name, function, line, message.data(), message.size());
+}
+
+}
+
+namespace _bn::memory
+{
+
+void unsafe_copy_bytes(const void* source, int bytes, void* destination)
+{
+    std::memcpy(destination, source, size_t(bytes));
+}
+
+void unsafe_copy_bytes_vram(const void* source, int bytes, void* destination)
+{
+    std::memcpy(destination, source, size_t(bytes));
+}
+
+void unsafe_copy_half_words(const void* source, int half_words, void* destination)
+{
+    std::memcpy(destination, source, size_t(half_words) * 2);
+}
+
+void unsafe_copy_words(const void* source, int words, void* destination)
+{
+    std::memcpy(destination, source, size_t(words) * 4);
+}
+
+void unsafe_clear_bytes(int bytes, void* destination)
+{
+    std::memset(destination, 0, size_t(bytes));
+}
+
+void unsafe_clear_half_words(int half_words, void* destination)
+{
+    std::memset(destination, 0, size_t(half_words) * 2);
+}
+
+void unsafe_clear_words(int words, void* destination)
+{
+    std::memset(destination, 0, size_t(words) * 4);
+}
+
+void unsafe_set_bytes(uint8_t value, int bytes, void* destination)
+{
+    std::memset(destination, value, size_t(bytes));
+}
+
+void unsafe_set_half_words(uint16_t value, int half_words, void* destination)
+{
+    std::fill_n(static_cast<uint16_t*>(destination), half_words, value);
+}
+
+void unsafe_set_words(unsigned value, int words, void* destination)
+{
+    std::fill_n(static_cast<unsigned*>(destination), words, value);
+}
+
+}
+
+namespace _bn::sram
+{
+
+void unsafe_read(void* destination, int size, int offset)
+{
+    std::memcpy(destination, data.sram + offset, size_t(size));
+}
+
+void unsafe_write(const void* source, int size, int offset)
+{
+    int budget = data.sram_write_budget;
+
+    if(budget >= 0 && size > budget)
+    {
+        std::memcpy(data.sram + offset, source, size_t(budget));
+        data.sram_written_bytes += budget;
+        data.sram_write_budget = 0;
+        throw bn::host::power_off();
+    }
+
+    std::memcpy(data.sram + offset, source, size_t(size));
+    data.sram_written_bytes += size;
+
+    if(budget >= 0)
+    {
+        data.sram_write_budget = budget - size;
+    }
+}
+
+}
+
+namespace bn::sram
+{
+
+void read_span(span<uint8_t>& destination)
+{
+    read_span_offset(destination, 0);
+}
+
+void read_span_offset(span<uint8_t>& destination, int offset)
+{
+    int destination_size = destination.size();
+    BN_ASSERT(offset >= 0, "Invalid offset: ", offset);
+    BN_ASSERT(destination_size + offset <= size(),
+              "Destination size and offset are too high: ", destination_size, " - ", offset);
+
+    _bn::sram::unsafe_read(destination.data(), destination_size, offset);
+}
+
+void write_span(const span<const uint8_t>& source)
+{
+    write_span_offset(source, 0);
+}
+
+void write_span_offset(const span<const uint8_t>& source, int offset)
+{
+    int source_size = source.size();
+    BN_ASSERT(offset >= 0, "Invalid offset: ", offset);
+    BN_ASSERT(source_size + offset <= size(),
+              "Source size and offset are too high: ", source_size, " - ", offset);
+
+    _bn::sram::unsafe_write(source.data(), source_size, offset);
+}
+
+void clear(int bytes)
+{
+    set_bytes(0, bytes, 0);
+}
+
+void clear(int bytes, int offset)
+{
+    set_bytes(0, bytes, offset);
+}
+
+void set_bytes(uint8_t value, int bytes)
+{
+    set_bytes(value, bytes, 0);
+}
+
+void set_bytes(uint8_t value, int bytes, int offset)
+{
+    BN_ASSERT(bytes >= 0, "Invalid bytes: ", bytes);
+    BN_ASSERT(offset >= 0, "Invalid offset: ", offset);
+    BN_ASSERT(bytes + offset <= size(), "Bytes and offset are too high: ", bytes, " - ", offset);
+
+    std::memset(data.sram + offset, value, size_t(bytes));
+}
+
+}
+
+namespace bn
+{
+
+timer::timer() :
+    _last_ticks(gba_ticks())
+{
+}
+
+int timer::elapsed_ticks() const
+{
+    return int(gba_ticks() - _last_ticks);
+}
+
+void timer::restart()
+{
+    _last_ticks = gba_ticks();
+}
+
+int timer::elapsed_ticks_with_restart()
+{
+    unsigned last_ticks = _last_ticks;
+    unsigned ticks = gba_ticks();
+    _last_ticks = ticks;
+    return int(ticks - last_ticks);
+}
+
+}
@@ -0,0 +1,8 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+// Hardware independent parts of the engine translation unit:
+
+#include "../../src/bn_generic_pool.cpp.h"
@@ -0,0 +1,902 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_list.h"
+#include "bn_pool.h"
+#include "bn_deque.h"
+#include "bn_fixed.h"
+#include "bn_vector.h"
+#include "bn_profiler.h"
+#include "bn_unordered_map.h"
+#include "bn_dense_unordered_map.h"
+#include "bn_sram_journal.h"
+#include "bn_best_fit_allocator.h"
+
+#include "bn_hw_decompress.h"
+
+#include "bn_host_hw.h"
+
+#include "../../src/bn_sprite_affine_mats_manager_hot.h"
+
+namespace
+{
+
+constexpr int containers_size = 512;
+constexpr int its = 200000;
+
+void vector_test()
+{
+    static bn::vector<int, containers_size> vector;
+    std::vector<int> reference;
+    std::mt19937 random(1);
+
+    for(int i = 0; i < its; ++i)
+    {
+        if(vector.full() || (! vector.empty() && random() % 2))
+        {
+            int index = int(random() % unsigned(vector.size()));
+            vector.erase(vector.begin() + index);
+            reference.erase(reference.begin() + index);
+        }
+        else
+        {
+            int index = int(random() % unsigned(vector.size() + 1));
+            vector.insert(vector.begin() + index, i);
+            reference.insert(reference.begin() + index, i);
+        }
+
+        BN_ASSERT(vector.size() == int(reference.size()), "Invalid size: ", vector.size());
+    }
+
+    BN_ASSERT(std::equal(vector.begin(), vector.end(), reference.begin(), reference.end()), "Invalid elements");
+}
+
+void deque_test()
+{
+    static bn::deque<int, containers_size> deque;
+    std::vector<int> reference;
+    std::mt19937 random(2);
+
+    for(int i = 0; i < its; ++i)
+    {
+        switch(random() % 4)
+        {
+
+        case 0:
+            if(! deque.full())
+            {
+                deque.push_back(i);
+                reference.push_back(i);
+            }
+            break;
+
+        case 1:
+            if(! deque.full())
+            {
+                deque.push_front(i);
+                reference.insert(reference.begin(), i);
+            }
+            break;
+
+        case 2:
+            if(! deque.empty())
+            {
+                BN_ASSERT(deque.front() == reference.front(), "Invalid front");
+                deque.pop_front();
+                reference.erase(reference.begin());
+            }
+            break;
+
+        default:
+            if(! deque.empty())
+            {
+                BN_ASSERT(deque.back() == reference.back(), "Invalid back");
+                deque.pop_back();
+                reference.pop_back();
+            }
+            break;
+        }
+    }
+
+    BN_ASSERT(std::equal(deque.begin(), deque.end(), reference.begin(), reference.end()), "Invalid elements");
+}
+
+void list_test()
+{
+    static bn::list<int, containers_size> list;
+    std::vector<int> reference;
+    std::mt19937 random(3);
+
+    for(int i = 0; i < its; ++i)
+    {
+        int index = int(random() % unsigned(reference.size() + 1));
+        auto it = list.begin();
+
+        for(int step = 0; step < index; ++step)
+        {
+            ++it;
+        }
+
+        if(list.full() || (it != list.end() && random() % 2))
+        {
+            list.erase(it);
+            reference.erase(reference.begin() + index);
+        }
+        else
+        {
+            list.insert(it, i);
+            reference.insert(reference.begin() + index, i);
+        }
+    }
+
+    BN_ASSERT(std::equal(list.begin(), list.end(), reference.begin(), reference.end()), "Invalid elements");
+}
+
+class same_hash
+{
+
+public:
+    [[nodiscard]] unsigned operator()(unsigned) const
+    {
+        return 0;
+    }
+};
+
+template<class Map>
+void check_map(const Map& map, const std::map<unsigned, int>& reference)
+{
+    BN_ASSERT(map.size() == int(reference.size()), "Invalid size: ", map.size(), " - ", int(reference.size()));
+
+    int count = 0;
+
+    for(const auto& pair : map)
+    {
+        auto it = reference.find(pair.first);
+        BN_ASSERT(it != reference.end() && it->second == pair.second, "Invalid element: ", pair.first);
+        ++count;
+    }
+
+    BN_ASSERT(count == map.size(), "Invalid iteration count: ", count);
+
+    for(const auto& pair : reference)
+    {
+        auto it = map.find(pair.first);
+        BN_ASSERT(it != map.end() && it->second == pair.second, "Element not found: ", pair.first);
+    }
+}
+
+template<class Map>
+void map_test(Map& map, unsigned seed)
+{
+    std::map<unsigned, int> reference;
+    std::mt19937 random(seed);
+    int max_size = map.max_size();
+
+    for(int i = 0; i < its; ++i)
+    {
+        // Aligned pointers like keys:
+        unsigned key = (random() % unsigned(max_size * 3)) * 4;
+
+        switch(random() % 8)
+        {
+
+        case 0:
+        case 1:
+        case 2:
+            if(int(reference.size()) < max_size)
+            {
+                bool found = reference.contains(key);
+                auto it = map.insert(key, i);
+                BN_ASSERT(found == (it == map.end()), "Invalid insert result: ", key);
+
+                if(! found)
+                {
+                    reference[key] = i;
+                }
+            }
+            break;
+
+        case 3:
+            if(int(reference.size()) < max_size || reference.contains(key))
+            {
+                map.insert_or_assign(key, i);
+                reference[key] = i;
+            }
+            break;
+
+        case 4:
+        case 5:
+            BN_ASSERT(map.erase(key) == bool(reference.erase(key)), "Invalid erase result: ", key);
+            break;
+
+        case 6:
+            BN_ASSERT((map.find(key) != map.end()) == reference.contains(key), "Invalid find result: ", key);
+            break;
+
+        default:
+            if(i % 1000 == 0)
+            {
+                int erased = map.erase_if([](const auto& pair){ return pair.first % 3 == 0; });
+                int reference_erased = int(std::erase_if(reference, [](const auto& pair){ return pair.first % 3 == 0; }));
+                BN_ASSERT(erased == reference_erased, "Invalid erase_if result: ", erased, " - ", reference_erased);
+            }
+            else if(i % 20011 == 0)
+            {
+                map.clear();
+                reference.clear();
+            }
+            break;
+        }
+
+        if(i % 997 == 0)
+        {
+            check_map(map, reference);
+        }
+    }
+
+    check_map(map, reference);
+
+    map.clear();
+    reference.clear();
+
+    for(int index = 0; index < max_size; ++index)
+    {
+        unsigned key = unsigned(index) * 64;
+        map[key] = index;
+        reference[key] = index;
+    }
+
+    check_map(map, reference);
+}
+
+void unordered_map_test()
+{
+    static bn::unordered_map<unsigned, int, containers_size * 2> map;
+    map_test(map, 4);
+}
+
+void dense_unordered_map_test()
+{
+    static bn::dense_unordered_map<unsigned, int, containers_size> map;
+    map_test(map, 5);
+
+    std::map<unsigned, int> reference(map.begin(), map.end());
+    static bn::dense_unordered_map<unsigned, int, containers_size> copy(map);
+    check_map(copy, reference);
+
+    static bn::dense_unordered_map<unsigned, int, containers_size * 2> big_copy(map);
+    check_map(big_copy, reference);
+    BN_ASSERT(copy == map, "Copies are not equal");
+
+    static bn::dense_unordered_map<unsigned, int, containers_size> other;
+    other.insert(5u, 1);
+    copy.swap(other);
+    check_map(other, reference);
+    BN_ASSERT(copy.size() == 1 && copy.find(5u)->second == 1, "Invalid swap");
+
+    // All elements in the same bucket:
+    static bn::dense_unordered_map<unsigned, int, containers_size, same_hash> same_hash_map;
+    map_test(same_hash_map, 6);
+}
+
+void pool_test()
+{
+    static bn::pool<int, containers_size> pool;
+    std::vector<int*> values;
+    std::mt19937 random(6);
+
+    for(int i = 0; i < its; ++i)
+    {
+        if(pool.full() || (! pool.empty() && random() % 2))
+        {
+            int index = int(random() % unsigned(values.size()));
+            pool.destroy(*values[index]);
+            values[index] = values.back();
+            values.pop_back();
+        }
+        else
+        {
+            values.push_back(&pool.create(i));
+        }
+
+        BN_ASSERT(pool.size() == int(values.size()), "Invalid size: ", pool.size());
+    }
+
+    std::sort(values.begin(), values.end());
+    BN_ASSERT(std::adjacent_find(values.begin(), values.end()) == values.end(), "Duplicated values");
+}
+
+void best_fit_allocator_test()
+{
+    alignas(8) static char buffer[64 * 1024];
+    bn::best_fit_allocator allocator(buffer, int(sizeof(buffer)));
+    std::vector<std::pair<char*, int>> allocations;
+    std::mt19937 random(7);
+
+    for(int i = 0; i < its; ++i)
+    {
+        if(! allocations.empty() && (random() % 2 || allocations.size() > 1000))
+        {
+            int index = int(random() % unsigned(allocations.size()));
+            auto [ptr, bytes] = allocations[index];
+
+            for(int byte_index = 0; byte_index < bytes; ++byte_index)
+            {
+                BN_ASSERT(ptr[byte_index] == char(bytes), "Corrupted allocation: ", byte_index, " - ", bytes);
+            }
+
+            allocator.free(ptr);
+            allocations[index] = allocations.back();
+            allocations.pop_back();
+        }
+        else
+        {
+            int bytes = random() % 8 ? int(random() % 200) : int(random() % 4000);
+
+            if(auto ptr = static_cast<char*>(allocator.alloc(bytes)))
+            {
+                BN_ASSERT(ptr >= buffer && ptr + bytes <= buffer + sizeof(buffer), "Invalid allocation");
+                std::memset(ptr, bytes, size_t(bytes));
+                allocations.emplace_back(ptr, bytes);
+            }
+        }
+    }
+
+    for(auto [ptr, bytes] : allocations)
+    {
+        allocator.free(ptr);
+    }
+
+    BN_ASSERT(allocator.empty(), "Allocator is not empty");
+
+    void* ptr = allocator.alloc(allocator.available_bytes() - 64);
+    BN_ASSERT(ptr, "Allocator is fragmented");
+    allocator.free(ptr);
+}
+
+// Double size check before it was changed to avoid divisions:
+template<int half_width, int half_height>
+[[nodiscard]] bool divided_sprite_double_size(int pa, int pb, int pc, int pd, int divisor)
+{
+    if(pb || pd)
+    {
+        int ix1 = ((-256 * half_height * pb) - (256 * half_width * pd) + (256 * pb)) / divisor;
+
+        if(ix1 < -half_width || ix1 >= half_width)
+        {
+            return true;
+        }
+
+        int ix2 = ((-256 * half_height * pb) + (256 * half_width * pd) + (256 * pb) - (256 * pd)) / divisor;
+
+        if(ix2 < -half_width || ix2 >= half_width)
+        {
+            return true;
+        }
+    }
+
+    int iy1 = (256 * ((half_height * pa) + (half_width * pc) - pa)) / divisor;
+
+    if(iy1 < -half_height || iy1 >= half_height)
+    {
+        return true;
+    }
+
+    int iy2 = (256 * ((half_height * pa) - (half_width * pc) - pa + pc)) / divisor;
+    return iy2 < -half_height || iy2 >= half_height;
+}
+
+void sprite_double_size_test()
+{
+    namespace hot = bn::sprite_affine_mats_manager::hot;
+
+    std::mt19937 random(8);
+
+    for(int i = 0; i < 3000000; ++i)
+    {
+        int range = i % 3 == 0 ? 32767 : i % 3 == 1 ? 600 : 300;
+        std::uniform_int_distribution<int> distribution(-range, range);
+        int pa = distribution(random);
+        int pb = distribution(random);
+        int pc = distribution(random);
+        int pd = distribution(random);
+        long long divisor = (long long)(pa) * pd - (long long)(pb) * pc;
+
+        if(! divisor || divisor > bn::numeric_limits<int>::max() || divisor < -bn::numeric_limits<int>::max())
+        {
+            continue;
+        }
+
+        int int_divisor = int(divisor);
+        BN_ASSERT((divided_sprite_double_size<32, 32>(pa, pb, pc, pd, int_divisor) ==
+                   hot::sprite_double_size<32, 32>(pa, pb, pc, pd, int_divisor)), "Invalid result: ", i);
+        BN_ASSERT((divided_sprite_double_size<32, 8>(pa, pb, pc, pd, int_divisor) ==
+                   hot::sprite_double_size<32, 8>(pa, pb, pc, pd, int_divisor)), "Invalid result: ", i);
+        BN_ASSERT((divided_sprite_double_size<8, 32>(pa, pb, pc, pd, int_divisor) ==
+                   hot::sprite_double_size<8, 32>(pa, pb, pc, pd, int_divisor)), "Invalid result: ", i);
+    }
+}
+
+void fixed_safe_division_test()
+{
+    std::mt19937 random(9);
+
+    for(int i = 0; i < 3000000; ++i)
+    {
+        int dividend = int(random()) >> (random() % 31);
+        int divisor = int(random()) >> (random() % 31);
+
+        if(! divisor)
+        {
+            continue;
+        }
+
+        bn::fixed fixed_dividend = bn::fixed::from_data(dividend);
+        bn::fixed fixed_divisor = bn::fixed::from_data(divisor);
+        int expected = int((bn_host_int64(dividend) * 4096) / divisor);
+        int result = fixed_dividend.safe_division(fixed_divisor).data();
+        BN_ASSERT(result == expected, "Invalid result: ", dividend, " / ", divisor, " = ", result);
+    }
+
+    // Minimum int dividend divided by -1 must not overflow:
+    auto dividend = bn::fixed_t<1>::from_data(bn::numeric_limits<int>::min() / 2);
+    auto divisor = bn::fixed_t<1>::from_data(-1);
+    BN_ASSERT(dividend.safe_division(divisor).data() == bn::numeric_limits<int>::min(), "Invalid result");
+}
+
+void profiler_test()
+{
+    // The profiler example uses more code blocks than BN_CFG_PROFILER_MAX_ENTRIES with the engine ones:
+    constexpr int ids_count = BN_CFG_PROFILER_MAX_ENTRIES + (BN_CFG_PROFILER_MAX_ENTRIES / 2);
+    static std::string ids[ids_count];
+
+    for(int index = 0; index < ids_count; ++index)
+    {
+        ids[index] = "id_" + std::to_string(index);
+    }
+
+    for(int frame = 0; frame < 4; ++frame)
+    {
+        BN_PROFILER_START("parent");
+
+        for(const std::string& id : ids)
+        {
+            BN_PROFILER_START(id.c_str());
+            BN_PROFILER_STOP();
+        }
+
+        BN_PROFILER_STOP();
+        _bn::profiler::update();
+    }
+
+    const _bn::profiler::ticks_map& ticks_per_entry = _bn::profiler::ticks_per_entry();
+    BN_ASSERT(ticks_per_entry.size() == ids_count + 1, "Invalid entries count: ", ticks_per_entry.size());
+
+    for(const std::string& id : ids)
+    {
+        auto it = ticks_per_entry.find(id.c_str());
+        BN_ASSERT(it != ticks_per_entry.end(), "Entry not found: ", id.c_str());
+        BN_ASSERT(it->second.parent && std::strcmp(it->second.parent, "parent") == 0, "Invalid parent");
+    }
+
+    BN_PROFILER_RESET();
+}
+
+class huffman_node
+{
+
+public:
+    int value = 0;
+    int children[2] = { -1, -1 };
+};
+
+// Returns a BIOS compatible Huffman stream with the given data:
+[[nodiscard]] std::vector<uint8_t> huffman_compress(const std::vector<uint8_t>& data, int data_bits)
+{
+    std::vector<unsigned> symbols;
+
+    for(uint8_t byte : data)
+    {
+        if(data_bits == 8)
+        {
+            symbols.push_back(byte);
+        }
+        else
+        {
+            symbols.push_back(byte & 0xF);
+            symbols.push_back(byte >> 4);
+        }
+    }
+
+    // Decompressed data is written a word at a time, so the stream must fill the last word:
+    while((symbols.size() * size_t(data_bits)) % 32)
+    {
+        symbols.push_back(symbols.front());
+    }
+
+    std::map<unsigned, int> frequencies;
+
+    for(unsigned symbol : symbols)
+    {
+        ++frequencies[symbol];
+    }
+
+    if(frequencies.size() == 1)
+    {
+        frequencies[(frequencies.begin()->first + 1) % (1U << data_bits)] = 0;
+    }
+
+    std::vector<huffman_node> nodes;
+    std::multimap<int, int> queue;
+
+    for(auto [symbol, frequency] : frequencies)
+    {
+        nodes.push_back(huffman_node{ int(symbol) });
+        queue.emplace(frequency, int(nodes.size()) - 1);
+    }
+
+    while(queue.size() > 1)
+    {
+        auto first = queue.begin();
+        auto second = std::next(first);
+        huffman_node node;
+        node.children[0] = first->second;
+        node.children[1] = second->second;
+        nodes.push_back(node);
+
+        int frequency = first->first + second->first;
+        queue.erase(first, std::next(second));
+        queue.emplace(frequency, int(nodes.size()) - 1);
+    }
+
+    // Breadth first layout, the children of each node are stored in pairs:
+    std::vector<int> slots = { queue.begin()->second };
+    std::vector<int> children_slots(1, -1);
+
+    for(int slot = 0; slot < int(slots.size()); ++slot)
+    {
+        const huffman_node& node = nodes[slots[slot]];
+
+        if(node.children[0] >= 0)
+        {
+            children_slots[slot] = int(slots.size());
+            slots.push_back(node.children[0]);
+            slots.push_back(node.children[1]);
+            children_slots.resize(slots.size(), -1);
+        }
+    }
+
+    std::vector<uint8_t> tree(slots.size() + 1);
+    std::map<unsigned, std::string> codes;
+
+    for(int slot = 0; slot < int(slots.size()); ++slot)
+    {
+        const huffman_node& node = nodes[slots[slot]];
+        int address = slot + 1;
+
+        if(node.children[0] < 0)
+        {
+            tree[address] = uint8_t(node.value);
+        }
+        else
+        {
+            int children_address = children_slots[slot] + 1;
+            int offset = (children_address - (address & ~1) - 2) / 2;
+            BN_ASSERT(offset >= 0 && offset < 64, "Invalid offset: ", offset);
+
+            unsigned value = unsigned(offset);
+
+            if(nodes[node.children[0]].children[0] < 0)
+            {
+                value |= 0x80;
+            }
+
+            if(nodes[node.children[1]].children[0] < 0)
+            {
+                value |= 0x40;
+            }
+
+            tree[address] = uint8_t(value);
+        }
+    }
+
+    auto fill_codes = [&](auto& self, int node_index, const std::string& code) -> void
+    {
+        const huffman_node& node = nodes[node_index];
+
+        if(node.children[0] < 0)
+        {
+            codes[unsigned(node.value)] = code;
+        }
+        else
+        {
+            self(self, node.children[0], code + '0');
+            self(self, node.children[1], code + '1');
+        }
+    };
+
+    fill_codes(fill_codes, queue.begin()->second, std::string());
+
+    while(tree.size() % 4)
+    {
+        tree.push_back(0);
+    }
+
+    tree[0] = uint8_t((tree.size() / 2) - 1);
+
+    std::string bits;
+
+    for(unsigned symbol : symbols)
+    {
+        bits += codes[symbol];
+    }
+
+    while(bits.size() % 32)
+    {
+        bits += '0';
+    }
+
+    unsigned header = (unsigned(data.size()) << 8) | 0x20 | unsigned(data_bits);
+    std::vector<uint8_t> result(4);
+    std::memcpy(result.data(), &header, 4);
+    result.insert(result.end(), tree.begin(), tree.end());
+
+    for(size_t index = 0; index < bits.size(); index += 32)
+    {
+        unsigned word = unsigned(std::stoul(bits.substr(index, 32), nullptr, 2));
+        uint8_t word_bytes[4];
+        std::memcpy(word_bytes, &word, 4);
+        result.insert(result.end(), word_bytes, word_bytes + 4);
+    }
+
+    return result;
+}
+
+void huffman_decompress_test()
+{
+    std::mt19937 random(10);
+
+    for(int i = 0; i < 2000; ++i)
+    {
+        int data_bits = random() % 2 ? 8 : 4;
+        int data_size = 1 + int(random() % 1200);
+        unsigned alphabet_size = 1 + random() % (data_bits == 8 ? 48 : 16);
+        std::vector<uint8_t> data(size_t(data_size), 0);
+
+        for(uint8_t& byte : data)
+        {
+            if(data_bits == 8)
+            {
+                byte = uint8_t(random() % alphabet_size);
+            }
+            else
+            {
+                byte = uint8_t((random() % alphabet_size) | ((random() % alphabet_size) << 4));
+            }
+        }
+
+        std::vector<uint8_t> compressed_data = huffman_compress(data, data_bits);
+        std::vector<unsigned> source((compressed_data.size() + 3) / 4);
+        std::memcpy(source.data(), compressed_data.data(), compressed_data.size());
+
+        // Output is written a word at a time:
+        int output_words = (data_size + 3) / 4;
+        std::vector<unsigned> output(size_t(output_words) + 1, 0xDEADBEEF);
+        bn::hw::decompress::huff(source.data(), output.data());
+
+        BN_ASSERT(std::memcmp(output.data(), data.data(), size_t(data_size)) == 0,
+                  "Invalid decompressed data: ", i, " - ", data_size);
+        BN_ASSERT(output[size_t(output_words)] == 0xDEADBEEF, "Decompressed data is too long: ", i, " - ", data_size);
+    }
+}
+
+class journal_data
+{
+
+public:
+    uint8_t bytes[250];
+
+    [[nodiscard]] friend bool operator==(const journal_data& a, const journal_data& b)
+    {
+        return std::memcmp(a.bytes, b.bytes, sizeof(a.bytes)) == 0;
+    }
+};
+
+constexpr int journal_offset = 100;
+
+// Two halves big enough to store an uncompressed snapshot:
+[[nodiscard]] constexpr int journal_min_size()
+{
+    int data_size = int(sizeof(journal_data));
+    int blocks_count = (data_size + BN_CFG_SRAM_JOURNAL_BLOCK_SIZE - 1) / BN_CFG_SRAM_JOURNAL_BLOCK_SIZE;
+    return (16 + (blocks_count * 12) + data_size + 12) * 2;
+}
+
+void modify_journal_data(journal_data& data, std::mt19937& random)
+{
+    int data_size = int(sizeof(data.bytes));
+
+    switch(random() % 4)
+    {
+
+    case 0:
+        data.bytes[random() % unsigned(data_size)] ^= uint8_t(1 + (random() % 255));
+        break;
+
+    case 1:
+        for(int index = 0, count = 1 + int(random() % 8); index < count; ++index)
+        {
+            data.bytes[random() % unsigned(data_size)] = uint8_t(random());
+        }
+        break;
+
+    case 2:
+        {
+            // Compressible blocks:
+            int begin = int(random() % unsigned(data_size));
+            int end = begin + int(random() % unsigned(data_size - begin));
+            std::memset(data.bytes + begin, int(random() % 4), size_t(end - begin));
+        }
+        break;
+
+    default:
+        for(uint8_t& byte : data.bytes)
+        {
+            byte = uint8_t(random());
+        }
+        break;
+    }
+}
+
+void sram_journal_replay_test(int size, unsigned seed)
+{
+    uint8_t* sram_data = bn::host::sram_data();
+    std::memset(sram_data, 0xAB, size_t(bn::sram::size()));
+    std::memset(sram_data + journal_offset, 0, size_t(size));
+
+    std::mt19937 random(seed);
+    journal_data data = {};
+    journal_data read_data = {};
+    bn::sram_journal<journal_data> journal(journal_offset, size);
+    BN_ASSERT(! journal.read(read_data), "Empty journal read");
+
+    for(int i = 0; i < 5000; ++i)
+    {
+        modify_journal_data(data, random);
+        journal.write(data);
+
+        // Replay from SRAM as after turning on the console again:
+        bn::sram_journal<journal_data> other_journal(journal_offset, size);
+        BN_ASSERT(other_journal.read(read_data), "Journal read failed: ", i);
+        BN_ASSERT(read_data == data, "Invalid journal data: ", i);
+    }
+
+    for(int index = 0; index < bn::sram::size(); ++index)
+    {
+        if(index < journal_offset || index >= journal_offset + size)
+        {
+            BN_ASSERT(sram_data[index] == 0xAB, "SRAM written outside the journal region: ", index);
+        }
+    }
+}
+
+void sram_journal_replay_test()
+{
+    // Minimum size (a snapshot per write):
+    sram_journal_replay_test(journal_min_size(), 11);
+    sram_journal_replay_test(journal_min_size() + 256, 12);
+    sram_journal_replay_test(journal_min_size() + 4096, 13);
+}
+
+void sram_journal_torn_write_test()
+{
+    constexpr int size = journal_min_size() + 256;
+
+    uint8_t* sram_data = bn::host::sram_data() + journal_offset;
+    std::memset(sram_data, 0, size);
+
+    std::mt19937 random(14);
+    journal_data committed_data = {};
+    journal_data read_data = {};
+
+    {
+        bn::sram_journal<journal_data> journal(journal_offset, size);
+        BN_ASSERT(! journal.read(read_data), "Empty journal read");
+        journal.write(committed_data);
+    }
+
+    for(int i = 0; i < 300; ++i)
+    {
+        journal_data new_data = committed_data;
+        modify_journal_data(new_data, random);
+
+        uint8_t old_sram_data[size];
+        std::memcpy(old_sram_data, sram_data, size);
+
+        int write_bytes;
+
+        {
+            bn::sram_journal<journal_data> journal(journal_offset, size);
+            BN_ASSERT(journal.read(read_data), "Journal read failed: ", i);
+
+            int written_bytes = bn::host::sram_written_bytes();
+            journal.write(new_data);
+            write_bytes = bn::host::sram_written_bytes() - written_bytes;
+        }
+
+        // Turn off the console after every written byte:
+        for(int budget = 0; budget < write_bytes; ++budget)
+        {
+            std::memcpy(sram_data, old_sram_data, size);
+
+            bn::sram_journal<journal_data> journal(journal_offset, size);
+            BN_ASSERT(journal.read(read_data), "Journal read failed: ", i, " - ", budget);
+            BN_ASSERT(read_data == committed_data, "Invalid journal data: ", i, " - ", budget);
+
+            bool powered_off = false;
+            bn::host::set_sram_write_budget(budget);
+
+            try
+            {
+                journal.write(new_data);
+            }
+            catch(const bn::host::power_off&)
+            {
+                powered_off = true;
+            }
+
+            bn::host::set_sram_write_budget(-1);
+            BN_ASSERT(powered_off, "Write not interrupted: ", i, " - ", budget);
+
+            // Only the old or the new data can be recovered, and the journal must be still writable:
+            bn::sram_journal<journal_data> recovered_journal(journal_offset, size);
+            BN_ASSERT(recovered_journal.read(read_data), "Recovered journal read failed: ", i, " - ", budget);
+            BN_ASSERT(read_data == committed_data || read_data == new_data,
+                      "Invalid recovered journal data: ", i, " - ", budget);
+
+            recovered_journal.write(new_data);
+
+            bn::sram_journal<journal_data> rewritten_journal(journal_offset, size);
+            BN_ASSERT(rewritten_journal.read(read_data), "Rewritten journal read failed: ", i, " - ", budget);
+            BN_ASSERT(read_data == new_data, "Invalid rewritten journal data: ", i, " - ", budget);
+        }
+
+        std::memcpy(sram_data, old_sram_data, size);
+
+        bn::sram_journal<journal_data> journal(journal_offset, size);
+        BN_ASSERT(journal.read(read_data), "Journal read failed: ", i);
+        journal.write(new_data);
+        committed_data = new_data;
+    }
+}
+
+void run_test(const char* name, void(*test)())
+{
+    std::printf("%s... ", name);
+    std::fflush(stdout);
+    test();
+    std::printf("OK\n");
+}
+
+}
+
+int main()
+{
+    run_test("vector", vector_test);
+    run_test("deque", deque_test);
+    run_test("list", list_test);
+    run_test("unordered_map", unordered_map_test);
+    run_test("dense_unordered_map", dense_unordered_map_test);
+    run_test("pool", pool_test);
+    run_test("best_fit_allocator", best_fit_allocator_test);
+    run_test("sprite_double_size", sprite_double_size_test);
+    run_test("fixed_safe_division", fixed_safe_division_test);
+    run_test("profiler", profiler_test);
+    run_test("huffman_decompress", huffman_decompress_test);
+    run_test("sram_journal_replay", sram_journal_replay_test);
+    run_test("sram_journal_torn_write", sram_journal_torn_write_test);
+    std::printf("All tests passed\n");
+    return 0;
+}
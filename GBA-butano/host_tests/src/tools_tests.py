@@ -0,0 +1,203 @@
+"""
+Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+zlib License, see LICENSE file.
+"""
+
+import os
+import random
+import sys
+import tempfile
+import unittest
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..', 'tools'))
+
+import compressor
+import butano_graphics_tool
+
+
+def _test_data():
+    test_random = random.Random(1)
+    result = [bytes([7]), bytes([1, 2]), bytes([3, 3, 3]), bytes(8), bytes(range(256)), bytes(64 * 1024)]
+
+    for _ in range(200):
+        data_size = test_random.randint(1, 3000)
+        alphabet_size = test_random.choice([1, 2, 3, 16, 40, 256])
+        data = bytearray(test_random.randrange(alphabet_size) for _ in range(data_size))
+
+        if test_random.randrange(2):
+            # Tiles like data, with runs and repeated blocks:
+            for _ in range(test_random.randint(1, 16)):
+                begin = test_random.randrange(data_size)
+                end = min(data_size, begin + test_random.randint(1, 300))
+
+                if test_random.randrange(2):
+                    data[begin:end] = bytes([data[begin]]) * (end - begin)
+                else:
+                    source = test_random.randrange(data_size)
+                    block = data[source:source + (end - begin)]
+                    data[begin:begin + len(block)] = block
+
+        result.append(bytes(data))
+
+    return result
+
+
+def _lz77_greedy_size(data):
+    lengths, distances = compressor._lz77_longest_matches(data)
+    items = 0
+    bytes_count = 0
+    position = 0
+
+    while position < len(data):
+        items += 1
+
+        if lengths[position]:
+            bytes_count += 2
+            position += lengths[position]
+        else:
+            bytes_count += 1
+            position += 1
+
+    return (4 + ((items + 7) // 8) + bytes_count + 3) // 4 * 4
+
+
+class CompressorTest(unittest.TestCase):
+
+    def test_round_trip(self):
+        for data in _test_data():
+            for compression in ['run_length', 'lz77', 'huffman']:
+                compressed_data = compressor.compress(data, compression)
+
+                if compressed_data is not None:
+                    self.assertEqual(len(compressed_data) % 4, 0)
+                    self.assertEqual(compressor.decompress(compressed_data), data)
+
+    def test_huffman_round_trip(self):
+        for data in _test_data():
+            for data_bits in [4, 8]:
+                compressed_data = compressor.huffman_compress(data, data_bits)
+
+                if data_bits == 4:
+                    # 16 symbols trees always fit:
+                    self.assertIsNotNone(compressed_data)
+
+                if compressed_data is not None:
+                    self.assertEqual(compressed_data[0], 0x20 | data_bits)
+                    self.assertEqual(compressor.huffman_decompress(compressed_data), data)
+
+    def test_lz77_optimal_parse(self):
+        for data in _test_data():
+            compressed_data = compressor.lz77_compress(data)
+            self.assertLessEqual(len(compressed_data), _lz77_greedy_size(data))
+
+    def test_lz77_vram_safe(self):
+        # Runs of the same byte can't be copied from the previous byte:
+        for data in [bytes(100), bytes([1, 2]) * 100]:
+            compressed_data = compressor.lz77_compress(data)
+            self.assertLess(len(compressed_data), len(data))
+            self.assertEqual(compressor.lz77_decompress(compressed_data), data)
+
+        with self.assertRaises(ValueError):
+            compressor.lz77_decompress(bytes([0x10, 8, 0, 0, 0x40, 1, 0x50, 0]))
+
+    def test_run_length_limits(self):
+        for data_size in [1, 2, 3, 127, 128, 129, 130, 131, 260, 261, 1000]:
+            for data in [bytes(data_size), bytes(index % 251 for index in range(data_size))]:
+                self.assertEqual(compressor.run_length_decompress(compressor.run_length_compress(data)), data)
+
+    def test_invalid_data(self):
+        with self.assertRaises(ValueError):
+            compressor.compress(b'', 'lz77')
+
+        with self.assertRaises(ValueError):
+            compressor.compress(b'a', 'zip')
+
+        with self.assertRaises(ValueError):
+            compressor.decompress(bytes([0x40, 1, 0, 0]))
+
+
+class GritArraysTest(unittest.TestCase):
+
+    def test_replace_arrays(self):
+        tiles = bytes(index % 3 for index in range(256))
+        palette = bytes(range(32))
+        map_data = bytes(index % 2 for index in range(64))
+
+        grit_assembly = \
+            '@\tTotal size: 32 + 256 + 64 = 352\n\n' + \
+            '\t.section .rodata\n' + \
+            '\t.align\t2\n' + \
+            '\t.global test_bn_gfxTiles\t\t@ 256 unsigned chars\n' + \
+            'test_bn_gfxTiles:\n' + \
+            ''.join('\t.word ' + ','.join('0x%08X' % int.from_bytes(tiles[word:word + 4], 'little')
+                                          for word in range(line, line + 32, 4)) + '\n'
+                    for line in range(0, len(tiles), 32)) + '\n' + \
+            '\t.global test_bn_gfxMap\t\t@ 64 unsigned chars\n' + \
+            'test_bn_gfxMap:\n' + \
+            '\t.hword ' + ','.join('0x%04X' % int.from_bytes(map_data[half_word:half_word + 2], 'little')
+                                   for half_word in range(0, len(map_data), 2)) + '\n\n' + \
+            '\t.global test_bn_gfxPal\t\t@ 32 unsigned chars\n' + \
+            'test_bn_gfxPal:\n' + \
+            '\t.hword ' + ','.join('0x%04X' % int.from_bytes(palette[half_word:half_word + 2], 'little')
+                                   for half_word in range(0, len(palette), 2)) + '\n\n'
+
+        grit_header = \
+            '//\tTotal size: 32 + 256 + 64 = 352\n\n' + \
+            '#define test_bn_gfxTilesLen 256\n' + \
+            'extern const unsigned int test_bn_gfxTiles[64];\n\n' + \
+            '#define test_bn_gfxMapLen 64\n' + \
+            'extern const unsigned short test_bn_gfxMap[32];\n\n' + \
+            '#define test_bn_gfxPalLen 32\n' + \
+            'extern const unsigned short test_bn_gfxPal[16];\n'
+
+        with tempfile.TemporaryDirectory() as folder_path:
+            grit_file_path = folder_path + '/test_bn_gfx'
+
+            with open(grit_file_path + '.s', 'w') as grit_file:
+                grit_file.write(grit_assembly)
+
+            with open(grit_file_path + '.h', 'w') as grit_file:
+                grit_file.write(grit_header)
+
+            self.assertEqual(butano_graphics_tool.read_grit_array(grit_file_path, 'test_bn_gfxTiles'),
+                             ('.word', tiles))
+            self.assertEqual(butano_graphics_tool.read_grit_array(grit_file_path, 'test_bn_gfxMap'),
+                             ('.hword', map_data))
+            self.assertIsNone(butano_graphics_tool.read_grit_array(grit_file_path, 'test_bn_gfxBitmap'))
+
+            compressed_tiles = compressor.lz77_compress(tiles)
+            compressed_map = compressor.run_length_compress(map_data)
+            butano_graphics_tool.write_grit_arrays(grit_file_path, {
+                'test_bn_gfxTiles': ('.word', tiles, compressed_tiles),
+                'test_bn_gfxMap': ('.hword', map_data, compressed_map),
+            })
+
+            self.assertEqual(butano_graphics_tool.read_grit_array(grit_file_path, 'test_bn_gfxTiles'),
+                             ('.word', compressed_tiles))
+            self.assertEqual(butano_graphics_tool.read_grit_array(grit_file_path, 'test_bn_gfxMap'),
+                             ('.hword', compressed_map))
+            self.assertEqual(butano_graphics_tool.read_grit_array(grit_file_path, 'test_bn_gfxPal'),
+                             ('.hword', palette))
+
+            total_size = 32 + len(compressed_tiles) + len(compressed_map)
+            total_size_line = 'Total size: 32 + ' + str(len(compressed_tiles)) + ' + ' + str(len(compressed_map)) + \
+                ' = ' + str(total_size)
+
+            with open(grit_file_path + '.s', 'r') as grit_file:
+                grit_assembly = grit_file.read()
+
+            self.assertIn(total_size_line, grit_assembly)
+            self.assertIn('test_bn_gfxTiles\t\t@ ' + str(len(compressed_tiles)) + ' unsigned chars', grit_assembly)
+
+            with open(grit_file_path + '.h', 'r') as grit_file:
+                grit_header = grit_file.read()
+
+            self.assertIn(total_size_line, grit_header)
+            self.assertIn('#define test_bn_gfxTilesLen ' + str(len(compressed_tiles)) + '\n', grit_header)
+            self.assertIn('test_bn_gfxTiles[' + str(len(compressed_tiles) // 4) + '];', grit_header)
+            self.assertIn('test_bn_gfxMap[' + str(len(compressed_map) // 2) + '];', grit_header)
+            self.assertIn('test_bn_gfxPal[16];', grit_header)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_HW_COROUTINE_H
+#define BN_HW_COROUTINE_H
+
+#include "bn_common.h"
+#include "../3rd_party/agbabi/include/agbabi.h"
+
+namespace bn::hw::coroutine
+{
+    static_assert(sizeof(__agbabi_coro_t) == sizeof(unsigned));
+
+    using entry_type = int(*)(__agbabi_coro_t*);
+
+    inline void make(unsigned& handle, void* stack_top, entry_type entry)
+    {
+        __agbabi_coro_make(reinterpret_cast<__agbabi_coro_t*>(&handle), stack_top, entry);
+    }
+
+    inline int resume(unsigned& handle)
+    {
+        return __agbabi_coro_resume(reinterpret_cast<__agbabi_coro_t*>(&handle));
+    }
+
+    inline void yield(unsigned& handle, int value)
+    {
+        __agbabi_coro_yield(reinterpret_cast<__agbabi_coro_t*>(&handle), value);
+    }
+
+    [[nodiscard]] inline bool joined(const unsigned& handle)
+    {
+        return reinterpret_cast<const __agbabi_coro_t*>(&handle)->joined;
+    }
+}
+
+#endif
@@ -11,6 +11,8 @@
 
 namespace bn::hw::decompress
 {
+    BN_CODE_IWRAM void _huff(const void* src, void* dst);
+
     inline void lz77(const void* src, void* dst)
     {
         swi_LZ77UnCompWrite16bit(src, dst);
@@ -28,7 +30,7 @@ namespace bn::hw::decompress
 
     inline void huff(const void* src, void* dst)
     {
-        HuffUnComp(src, dst);
+        _huff(src, dst);
     }
 }
 
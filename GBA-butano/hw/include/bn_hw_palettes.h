@@ -159,6 +159,9 @@ namespace bn::hw::palettes
         return reinterpret_cast<uint16_t*>(MEM_PAL_BG);
     }
 
+    BN_CODE_IWRAM void ramp_effect(
+            const color* source_colors_ptr, const color* ramp_colors_ptr, int count, color* destination_colors_ptr);
+
     BN_CODE_IWRAM void _lut_effect(
             const color* source_colors_ptr, const uint8_t* lut, int count, color* destination_colors_ptr);
 }
@@ -32,6 +32,11 @@ namespace bn::hw::sprites
         to.attr2 = from.attr2;
     }
 
+    [[nodiscard]] inline bool equal_handles(const handle_type& a, const handle_type& b)
+    {
+        return a.attr0 == b.attr0 && a.attr1 == b.attr1 && a.attr2 == b.attr2;
+    }
+
     namespace
     {
         [[nodiscard]] inline handle_type* vram()
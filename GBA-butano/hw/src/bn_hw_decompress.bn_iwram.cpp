@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "../include/bn_hw_decompress.h"
+
+namespace bn::hw::decompress
+{
+
+void _huff(const void* src, void* dst)
+{
+    // Same format and output as the BIOS HuffUnComp routine:
+    // a header word, the tree (its size byte first) and a bit stream of words read from the most significant bit.
+    // Decompressed data is written a word at a time, so it can be decompressed to VRAM too.
+
+    auto header = *static_cast<const unsigned*>(src);
+    unsigned data_bits = header & 0xF;
+    unsigned data_mask = (1U << data_bits) - 1;
+    int remaining_words = int((header >> 8) + 3) / 4;
+
+    if(! remaining_words)
+    {
+        return;
+    }
+
+    auto tree = static_cast<const uint8_t*>(src) + 4;
+    const uint8_t* root = tree + 1;
+    auto stream = reinterpret_cast<const unsigned*>(tree + ((tree[0] + 1) * 2));
+    auto output = static_cast<unsigned*>(dst);
+    const uint8_t* node = root;
+    unsigned output_word = 0;
+    unsigned output_bits = 0;
+
+    while(true)
+    {
+        unsigned stream_word = *stream++;
+
+        for(int index = 0; index < 32; ++index)
+        {
+            // Children are stored in pairs: offset counts pairs from the pair that contains the node.
+            unsigned node_value = *node;
+            unsigned bit = stream_word >> 31;
+            stream_word <<= 1;
+
+            const uint8_t* child = reinterpret_cast<const uint8_t*>(
+                        (uintptr_t(node) & ~uintptr_t(1)) + ((node_value & 0x3F) * 2) + 2 + bit);
+
+            if(node_value & (0x80 >> bit))
+            {
+                output_word |= (*child & data_mask) << output_bits;
+                output_bits += data_bits;
+                node = root;
+
+                if(output_bits == 32)
+                {
+                    *output++ = output_word;
+                    output_word = 0;
+                    output_bits = 0;
+
+                    if(! --remaining_words)
+                    {
+                        return;
+                    }
+                }
+            }
+            else
+            {
+                node = child;
+            }
+        }
+    }
+}
+
+}
@@ -24,6 +24,23 @@ void brightness(const color* source_colors_ptr, int value, int count, color* des
     }
 }
 
+void ramp_effect(const color* source_colors_ptr, const color* ramp_colors_ptr, int count,
+                 color* destination_colors_ptr)
+{
+    auto tonc_src_ptr = reinterpret_cast<const COLOR*>(source_colors_ptr);
+    auto tonc_ramp_ptr = reinterpret_cast<const COLOR*>(ramp_colors_ptr);
+    auto tonc_dst_ptr = reinterpret_cast<COLOR*>(destination_colors_ptr);
+
+    for(int index = 0; index < count; ++index)
+    {
+        unsigned source = tonc_src_ptr[index];
+        unsigned red = tonc_ramp_ptr[source & 31] & 0x001F;
+        unsigned green = tonc_ramp_ptr[(source >> 5) & 31] & 0x03E0;
+        unsigned blue = tonc_ramp_ptr[(source >> 10) & 31] & 0x7C00;
+        tonc_dst_ptr[index] = COLOR(red | green | blue);
+    }
+}
+
 void _lut_effect(const color* source_colors_ptr, const uint8_t* lut, int count, color* destination_colors_ptr)
 {
     auto tonc_dst_ptr = reinterpret_cast<COLOR*>(destination_colors_ptr);
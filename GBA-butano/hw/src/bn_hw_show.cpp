@@ -23,7 +23,7 @@
     #include "bn_vector.h"
     #include "bn_keypad.h"
     #include "bn_profiler.h"
-    #include "bn_unordered_map.h"
+    #include "bn_dense_unordered_map.h"
 #endif
 
 namespace bn::hw::show
@@ -165,20 +165,53 @@ namespace
                 string_view id;
                 int64_t total_ticks;
                 int max_ticks;
+                int p95_frame_ticks;
+
+                [[nodiscard]] int64_t ticks(int mode) const
+                {
+                    switch(mode)
+                    {
+
+                    case 0:
+                        return total_ticks;
+
+                    case 1:
+                        return max_ticks;
+
+                    default:
+                        return p95_frame_ticks;
+                    }
+                }
             };
 
             vector<entry, BN_CFG_PROFILER_MAX_ENTRIES * 2> entries;
             int64_t total_ticks = 0;
             int64_t max_ticks = 0;
-            bool show_total = true;
+            int64_t max_p95_frame_ticks = 0;
+            constexpr int modes_count = BN_CFG_PROFILER_FRAME_SAMPLES > 0 ? 3 : 2;
+            int mode = 0;
             bool rebuild = true;
 
             for(const auto& ticks_per_entry_pair : ticks_per_entry)
             {
                 auto& ticks_entry = ticks_per_entry_pair.second;
-                entries.push_back({ ticks_per_entry_pair.first, ticks_entry.total, ticks_entry.max });
-                total_ticks += ticks_entry.total;
+
+                #if BN_CFG_PROFILER_FRAME_SAMPLES > 0
+                    int p95_frame_ticks = _bn::profiler::frame_ticks_percentile(ticks_entry, 95);
+                #else
+                    int p95_frame_ticks = 0;
+                #endif
+
+                entries.push_back({ ticks_per_entry_pair.first, ticks_entry.total, ticks_entry.max, p95_frame_ticks });
+
+                // Nested entries are already included in the ticks of their parents:
+                if(! ticks_entry.parent)
+                {
+                    total_ticks += ticks_entry.total;
+                }
+
                 max_ticks = bn::max(max_ticks, int64_t(ticks_entry.max));
+                max_p95_frame_ticks = bn::max(max_p95_frame_ticks, int64_t(p95_frame_ticks));
             }
 
             // Retrieve max width for indexes, labels and ticks:
@@ -207,18 +240,9 @@ namespace
                     current_index = 0;
 
                     // Sort entries by ticks (higher to lower):
-                    if(show_total)
-                    {
-                        sort(entries.begin(), entries.end(), [](const entry& a, const entry& b) {
-                            return a.total_ticks > b.total_ticks;
-                        });
-                    }
-                    else
-                    {
-                        sort(entries.begin(), entries.end(), [](const entry& a, const entry& b) {
-                            return a.max_ticks > b.max_ticks;
-                        });
-                    }
+                    sort(entries.begin(), entries.end(), [mode](const entry& a, const entry& b) {
+                        return a.ticks(mode) > b.ticks(mode);
+                    });
 
                     // Calculate columns width:
                     for(int index = 0; index < num_entries; ++index)
@@ -233,7 +257,7 @@ namespace
                         max_id_width = max(max_id_width, int(tte_get_text_size(buffer_stream.str().c_str()).x));
 
                         buffer.clear();
-                        buffer_stream << (show_total ? entry.total_ticks : entry.max_ticks);
+                        buffer_stream << entry.ticks(mode);
                         max_ticks_width = max(max_ticks_width, int(tte_get_text_size(buffer_stream.str().c_str()).x));
                     }
 
@@ -246,15 +270,23 @@ namespace
                 tte_set_ink(colors::green.data());
                 buffer.clear();
 
-                if(show_total)
+                switch(mode)
                 {
+
+                case 0:
                     buffer_stream << "PROFILER - Total ticks: " << total_ticks;
                     global_var = total_ticks;
-                }
-                else
-                {
+                    break;
+
+                case 1:
                     buffer_stream << "PROFILER - Max ticks: " << max_ticks;
                     global_var = max_ticks;
+                    break;
+
+                default:
+                    buffer_stream << "PROFILER - P95 frame ticks: " << max_p95_frame_ticks;
+                    global_var = max_p95_frame_ticks;
+                    break;
                 }
 
                 tte_write(buffer.c_str());
@@ -295,7 +327,7 @@ namespace
                     tte_set_pos(x + max_id_width + margin, y);
                     tte_get_pos(&x, &y);
 
-                    int64_t entry_var = show_total ? entry.total_ticks : entry.max_ticks;
+                    int64_t entry_var = entry.ticks(mode);
                     buffer.clear();
                     buffer_stream << entry_var;
                     tte_set_ink(colors::yellow.data());
@@ -321,7 +353,7 @@ namespace
 
                     if(keypad::a_pressed())
                     {
-                        show_total = ! show_total;
+                        mode = (mode + 1) % modes_count;
                         rebuild = true;
                         tte_erase_screen();
                         break;
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_ASYNC_LOADER_H
+#define BN_ASYNC_LOADER_H
+
+/**
+ * @file
+ * bn::async_loader header file.
+ *
+ * @ingroup core
+ */
+
+#include <new>
+#include "bn_fixed.h"
+#include "bn_assert.h"
+#include "bn_config_async_loader.h"
+
+namespace bn
+{
+
+/**
+ * @brief Runs a task (like creating backgrounds, sprite tiles and palettes) in a coroutine,
+ * so it can be spread over multiple frames.
+ *
+ * The task must call bn::async_loader::yield between its steps to give control back to the game.
+ *
+ * Results can be stored in bn::optional objects owned by the game, which can check if they have a value
+ * to know when a resource is ready:
+ *
+ * @code{.cpp}
+ * bn::optional<bn::regular_bg_ptr> bg;
+ * bn::async_loader loader;
+ *
+ * loader.start([&bg]()
+ * {
+ *     bn::regular_bg_ptr new_bg = bn::regular_bg_items::level.create_bg(0, 0);
+ *     bn::async_loader::yield();
+ *     bg = bn::move(new_bg);
+ * });
+ *
+ * while(! bg)
+ * {
+ *     // Game logic...
+ *     loader.update(bn::fixed(0.8));
+ *     bn::core::update();
+ * }
+ * @endcode
+ *
+ * bn::core::update must not be called from the task.
+ *
+ * A running task can be stopped with bn::async_loader::cancel.
+ * The remaining yield calls of a cancelled task return immediately, so it runs until it finishes in the same frame.
+ * The task can check bn::async_loader::cancelled to skip its remaining steps.
+ *
+ * Since the task stack is stored in this object, it's not recommended to place it in the main stack (IWRAM).
+ *
+ * @ingroup core
+ */
+class async_loader
+{
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    async_loader() = default;
+
+    async_loader(const async_loader& other) = delete;
+
+    async_loader& operator=(const async_loader& other) = delete;
+
+    /**
+     * @brief Destructor.
+     *
+     * If the task is running, it is cancelled to destroy the objects in its stack (see cancel).
+     */
+    ~async_loader()
+    {
+        if(running())
+        {
+            cancel();
+        }
+    }
+
+    /**
+     * @brief Indicates if a task has been started and it has not finished yet.
+     */
+    [[nodiscard]] bool running() const
+    {
+        return _task_function;
+    }
+
+    /**
+     * @brief Starts the given task.
+     *
+     * The task is not run until update is called.
+     *
+     * @param task Function object without parameters to run. It is copied to the top of the task stack.
+     */
+    template<typename Task>
+    void start(const Task& task)
+    {
+        constexpr int task_size = (int(sizeof(Task)) + 7) & ~7;
+        static_assert(task_size <= BN_CFG_ASYNC_LOADER_STACK_SIZE / 4, "Task is too big");
+        static_assert(alignof(Task) <= 8);
+
+        BN_BASIC_ASSERT(! running(), "Task is running");
+
+        void* task_ptr = _stack + BN_CFG_ASYNC_LOADER_STACK_SIZE - task_size;
+        ::new(task_ptr) Task(task);
+
+        _start(task_ptr, [](void* task_data)
+        {
+            Task& task_ref = *static_cast<Task*>(task_data);
+            task_ref();
+            task_ref.~Task();
+        });
+    }
+
+    /**
+     * @brief Resumes the running task until it finishes or until the CPU usage of the current frame
+     * reaches the given limit.
+     *
+     * The task is resumed at least once, and it is only interrupted when it calls bn::async_loader::yield.
+     *
+     * It should be called after the game logic and before bn::core::update.
+     *
+     * @param max_cpu_usage CPU usage of the current frame (1 means 100%) from which the task is not resumed again.
+     */
+    void update(fixed max_cpu_usage);
+
+    /**
+     * @brief Cancels the running task.
+     *
+     * The task is resumed until it finishes, with all its yield calls returning immediately.
+     *
+     * It can't be called from a task.
+     */
+    void cancel();
+
+    /**
+     * @brief Suspends the running task until it is resumed by the next update call.
+     *
+     * It must be called from a task run by an async_loader.
+     */
+    static void yield();
+
+    /**
+     * @brief Indicates if the running task has been cancelled or not.
+     *
+     * It must be called from a task run by an async_loader.
+     */
+    [[nodiscard]] static bool cancelled();
+
+private:
+    using task_function_type = void(*)(void*);
+
+    alignas(8) uint8_t _stack[BN_CFG_ASYNC_LOADER_STACK_SIZE];
+    void* _task_ptr = nullptr;
+    task_function_type _task_function = nullptr;
+    unsigned _handle = 0;
+    bool _cancelled = false;
+
+    static_assert(BN_CFG_ASYNC_LOADER_STACK_SIZE >= 256);
+    static_assert(BN_CFG_ASYNC_LOADER_STACK_SIZE % 8 == 0);
+
+    void _start(void* task_ptr, task_function_type task_function);
+
+    void _resume();
+
+    static void _run_task();
+};
+
+}
+
+#endif
@@ -44,6 +44,22 @@ namespace bn::audio
      */
     void set_mixing_rate(audio_mixing_rate mixing_rate);
 
+    /**
+     * @brief Returns the number of audio commands discarded because the commands list was full
+     * (only possible when asserts are disabled).
+     *
+     * See @ref BN_CFG_AUDIO_MAX_COMMANDS.
+     */
+    [[nodiscard]] int dropped_commands_count();
+
+    /**
+     * @brief Returns the number of audio commands merged with a pending one instead of being added
+     * to the commands list.
+     *
+     * See @ref BN_CFG_AUDIO_MAX_COMMANDS and @ref BN_CFG_AUDIO_MERGE_SOUNDS.
+     */
+    [[nodiscard]] int coalesced_commands_count();
+
     /**
      * @brief Indicates if audio is updated on the V-Blank interrupt or not.
      *
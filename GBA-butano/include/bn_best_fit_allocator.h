@@ -23,6 +23,9 @@ namespace bn
 /**
  * @brief Manages a chunk of memory with a best fit allocation strategy.
  *
+ * Free items are kept in segregated lists indexed by size class (TLSF style),
+ * so allocation and deallocation take constant time.
+ *
  * @ingroup allocator
  */
 class best_fit_allocator
@@ -188,7 +191,7 @@ public:
     void reset(void* start, size_type bytes);
 
     /**
-     * @brief Logs the current status of the allocator.
+     * @brief Logs the current status of the allocator, including fragmentation statistics.
      */
     void log_status() const;
 
@@ -236,8 +239,16 @@ private:
     static constexpr size_type _sizeof_free_item = sizeof(item_type);
     static constexpr size_type _sizeof_used_item = sizeof(item_type) - sizeof(free_items_pair);
 
+    static constexpr int _alignment_shift = 3;
+    static constexpr int _sl_shift = 3;
+    static constexpr int _sl_count = 1 << _sl_shift;
+    static constexpr int _fl_count = 15;
+    static constexpr size_type _small_bytes = 1 << (_sl_shift + _alignment_shift);
+
     uint8_t* _start_ptr = nullptr;
-    item_type* _first_free_item = nullptr;
+    item_type* _free_items[_fl_count][_sl_count] = {};
+    unsigned _fl_bitmap = 0;
+    uint8_t _sl_bitmaps[_fl_count] = {};
     size_type _total_bytes_count = 0;
     size_type _free_bytes_count = 0;
     bool _skip_empty_check_on_destructor = false;
@@ -262,6 +273,14 @@ private:
         return reinterpret_cast<item_type*>(_start_ptr + _total_bytes_count);
     }
 
+    static void _free_items_indexes(size_type bytes, int& fl, int& sl);
+
+    void _insert_free_item(item_type* item);
+
+    void _erase_free_item(item_type* item);
+
+    [[nodiscard]] static item_type* _fitting_free_item(item_type* free_item, size_type bytes);
+
     [[nodiscard]] item_type* _best_free_item(size_type bytes);
 
     #if BN_CFG_BEST_FIT_ALLOCATOR_SANITY_CHECK_ENABLED
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_CONFIG_ASYNC_LOADER_H
+#define BN_CONFIG_ASYNC_LOADER_H
+
+/**
+ * @file
+ * bn::async_loader configuration header file.
+ *
+ * @ingroup core
+ */
+
+#include "bn_common.h"
+
+/**
+ * @def BN_CFG_ASYNC_LOADER_STACK_SIZE
+ *
+ * Specifies the size in bytes of the stack used by the tasks run by a bn::async_loader.
+ *
+ * The task itself is stored at the top of the stack, so it reduces the available stack size.
+ *
+ * @ingroup core
+ */
+#ifndef BN_CFG_ASYNC_LOADER_STACK_SIZE
+    #define BN_CFG_ASYNC_LOADER_STACK_SIZE 2048
+#endif
+
+#endif
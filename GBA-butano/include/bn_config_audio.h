@@ -85,12 +85,28 @@
  *
  * This list is processed and cleared when bn::core::update() is called.
  *
+ * Commands which only set a value (like music volume or sound panning) replace the pending ones of the same kind.
+ *
  * @ingroup audio
  */
 #ifndef BN_CFG_AUDIO_MAX_COMMANDS
     #define BN_CFG_AUDIO_MAX_COMMANDS (((BN_CFG_AUDIO_MAX_SOUND_CHANNELS) * 2) + 1)
 #endif
 
+/**
+ * @def BN_CFG_AUDIO_MERGE_SOUNDS
+ *
+ * Indicates if a sound effect played with default settings more than once before bn::core::update() is called
+ * should be played only once.
+ *
+ * If it's enabled, the sound handles returned by these calls are the same.
+ *
+ * @ingroup sound
+ */
+#ifndef BN_CFG_AUDIO_MERGE_SOUNDS
+    #define BN_CFG_AUDIO_MERGE_SOUNDS false
+#endif
+
 /**
  * @def BN_CFG_AUDIO_MAX_EVENTS
  *
@@ -26,6 +26,25 @@
     #define BN_CFG_BG_BLOCKS_MAX_ITEMS 16
 #endif
 
+/**
+ * @def BN_CFG_BG_BLOCKS_MAX_COMPRESSED_COMMIT_BYTES
+ *
+ * Specifies the maximum number of decompressed bytes of compressed background tile sets and maps that can be committed to VRAM
+ * in a single frame, or 0 for no limit.
+ *
+ * Compressed items that don't fit in the budget are committed in the next frames,
+ * so they are displayed with their previous VRAM content until then.
+ *
+ * At least one compressed item is always committed per frame, even if it doesn't fit in the budget.
+ *
+ * Uncompressed items are not limited by this budget.
+ *
+ * @ingroup bg
+ */
+#ifndef BN_CFG_BG_BLOCKS_MAX_COMPRESSED_COMMIT_BYTES
+    #define BN_CFG_BG_BLOCKS_MAX_COMPRESSED_COMMIT_BYTES 0
+#endif
+
 /**
  * @def BN_CFG_BG_BLOCKS_LOG_ENABLED
  *
@@ -42,6 +42,8 @@
  *
  * Specifies if each Butano subsystem must be profiled separately or not.
  *
+ * Each subsystem code block is nested in the general Butano update and commit code blocks.
+ *
  * @ref BN_CFG_PROFILER_LOG_ENGINE must be `true` to enable Butano subsystems profiling.
  *
  * @ingroup profiler
@@ -61,4 +63,45 @@
     #define BN_CFG_PROFILER_MAX_ENTRIES 64
 #endif
 
+/**
+ * @def BN_CFG_PROFILER_MAX_DEPTH
+ *
+ * Specifies the maximum number of code blocks that can be profiled at the same time (nested code blocks).
+ *
+ * @ingroup profiler
+ */
+#ifndef BN_CFG_PROFILER_MAX_DEPTH
+    #define BN_CFG_PROFILER_MAX_DEPTH 8
+#endif
+
+/**
+ * @def BN_CFG_PROFILER_FRAME_SAMPLES
+ *
+ * Specifies the number of frames stored for each code block to calculate its ticks per frame percentiles.
+ *
+ * Each entry of the profiler requires `BN_CFG_PROFILER_FRAME_SAMPLES * 4` bytes of EWRAM
+ * (`BN_CFG_PROFILER_MAX_ENTRIES * 2` entries are allocated), so ticks per frame percentiles are disabled by default.
+ *
+ * @ingroup profiler
+ */
+#ifndef BN_CFG_PROFILER_FRAME_SAMPLES
+    #define BN_CFG_PROFILER_FRAME_SAMPLES 0
+#endif
+
+/**
+ * @def BN_CFG_PROFILER_LOG_CPU_TICKS
+ *
+ * Specifies if the CPU ticks of each bn::core::update call must be logged or not.
+ *
+ * Combined with keypad commands recorded with the keypad logger (see @ref BN_CFG_KEYPAD_LOG_ENABLED),
+ * it provides a repeatable CPU usage trace which can be compared between builds.
+ *
+ * Unlike the rest of the profiler, it doesn't require @ref BN_CFG_PROFILER_ENABLED to be `true`.
+ *
+ * @ingroup profiler
+ */
+#ifndef BN_CFG_PROFILER_LOG_CPU_TICKS
+    #define BN_CFG_PROFILER_LOG_CPU_TICKS false
+#endif
+
 #endif
@@ -27,6 +27,25 @@
     #define BN_CFG_SPRITE_TILES_MAX_ITEMS 128
 #endif
 
+/**
+ * @def BN_CFG_SPRITE_TILES_MAX_COMPRESSED_COMMIT_BYTES
+ *
+ * Specifies the maximum number of decompressed bytes of compressed sprite tile sets that can be committed to VRAM
+ * in a single frame, or 0 for no limit.
+ *
+ * Compressed items that don't fit in the budget are committed in the next frames,
+ * so they are displayed with their previous VRAM content until then.
+ *
+ * At least one compressed item is always committed per frame, even if it doesn't fit in the budget.
+ *
+ * Uncompressed items are not limited by this budget.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITE_TILES_MAX_COMPRESSED_COMMIT_BYTES
+    #define BN_CFG_SPRITE_TILES_MAX_COMPRESSED_COMMIT_BYTES 0
+#endif
+
 /**
  * @def BN_CFG_SPRITE_TILES_LOG_ENABLED
  *
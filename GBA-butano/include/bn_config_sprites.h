@@ -54,4 +54,32 @@
     #define BN_CFG_SPRITES_USE_IWRAM true
 #endif
 
+/**
+ * @def BN_CFG_SPRITE_TEXT_CACHE_MAX_ENTRIES
+ *
+ * Specifies the maximum number of texts generated by bn::sprite_text_generator
+ * whose sprite tiles are kept in VRAM to be reused when the same text is generated again.
+ *
+ * Cached sprite tiles are released when there's not enough VRAM to generate a new text,
+ * but they can make other sprite tiles allocations fail, so the cache is disabled by default.
+ *
+ * @ingroup sprite
+ * @ingroup text
+ */
+#ifndef BN_CFG_SPRITE_TEXT_CACHE_MAX_ENTRIES
+    #define BN_CFG_SPRITE_TEXT_CACHE_MAX_ENTRIES 0
+#endif
+
+/**
+ * @def BN_CFG_SPRITE_TEXT_CACHE_MAX_TEXT_SIZE
+ *
+ * Specifies the maximum size in bytes of a text cached by bn::sprite_text_generator.
+ *
+ * @ingroup sprite
+ * @ingroup text
+ */
+#ifndef BN_CFG_SPRITE_TEXT_CACHE_MAX_TEXT_SIZE
+    #define BN_CFG_SPRITE_TEXT_CACHE_MAX_TEXT_SIZE 32
+#endif
+
 #endif
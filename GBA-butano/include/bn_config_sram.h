@@ -28,4 +28,30 @@
     #define BN_CFG_SRAM_WAIT_STATE BN_SRAM_WAIT_STATE_8
 #endif
 
+/**
+ * @def BN_CFG_SRAM_JOURNAL_BLOCK_SIZE
+ *
+ * Specifies the size in bytes of the blocks in which bn::sram_journal splits the stored data.
+ *
+ * Only modified blocks are written into SRAM.
+ *
+ * @ingroup sram
+ */
+#ifndef BN_CFG_SRAM_JOURNAL_BLOCK_SIZE
+    #define BN_CFG_SRAM_JOURNAL_BLOCK_SIZE 32
+#endif
+
+/**
+ * @def BN_CFG_SRAM_JOURNAL_COMPRESSION
+ *
+ * Specifies if the blocks written by bn::sram_journal must be run-length compressed or not.
+ *
+ * Blocks are stored uncompressed if compression doesn't reduce their size.
+ *
+ * @ingroup sram
+ */
+#ifndef BN_CFG_SRAM_JOURNAL_COMPRESSION
+    #define BN_CFG_SRAM_JOURNAL_COMPRESSION true
+#endif
+
 #endif
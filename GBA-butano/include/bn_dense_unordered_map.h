@@ -0,0 +1,1387 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_DENSE_UNORDERED_MAP_H
+#define BN_DENSE_UNORDERED_MAP_H
+
+/**
+ * @file
+ * bn::idense_unordered_map and bn::dense_unordered_map implementation header file.
+ *
+ * @ingroup unordered_map
+ */
+
+#include <new>
+#include "bn_memory.h"
+#include "bn_iterator.h"
+#include "bn_algorithm.h"
+#include "bn_power_of_two.h"
+#include "bn_dense_unordered_map_fwd.h"
+
+namespace bn
+{
+
+template<typename Key, typename Value, typename KeyHash, typename KeyEqual>
+class idense_unordered_map
+{
+
+public:
+    using key_type = Key; //!< Key type alias.
+    using mapped_type = Value; //!< Value type alias.
+    using value_type = pair<const key_type, mapped_type>; //!< (Key, Value) pair type alias.
+    using size_type = int; //!< Size type alias.
+    using difference_type = int; //!< Difference type alias.
+    using hash_type = unsigned; //!< Hash type alias.
+    using hasher = KeyHash; //!< Hash functor alias.
+    using key_equal = KeyEqual; //!< Equality functor alias.
+    using reference = value_type&; //!< (Key, Value) pair reference alias.
+    using const_reference = const value_type&; //!< (Key, Value) pair const reference alias.
+    using pointer = value_type*; //!< (Key, Value) pair pointer alias.
+    using const_pointer = const value_type*; //!< (Key, Value) pair const pointer alias.
+    using iterator = value_type*; //!< Iterator alias.
+    using const_iterator = const value_type*; //!< Const iterator alias.
+    using reverse_iterator = bn::reverse_iterator<iterator>; //!< Reverse iterator alias.
+    using const_reverse_iterator = bn::reverse_iterator<const_iterator>; //!< Const reverse iterator alias.
+
+    /**
+     * @brief Maximum number of buckets probed by a search.
+     *
+     * bn::dense_unordered_map max size can't be greater than it,
+     * so elements with the same hash can't exceed it.
+     */
+    static constexpr int max_probe_length = 8191;
+
+    idense_unordered_map(const idense_unordered_map& other) = delete;
+
+    /**
+     * @brief Destructor.
+     */
+    ~idense_unordered_map() noexcept = default;
+
+    /**
+     * @brief Destructor.
+     */
+    ~idense_unordered_map() noexcept
+    requires(! is_trivially_destructible_v<value_type>)
+    {
+        pointer storage = _storage;
+
+        for(size_type index = 0, size = _size; index < size; ++index)
+        {
+            storage[index].~value_type();
+        }
+    }
+
+    /**
+     * @brief Copy assignment operator.
+     * @param other idense_unordered_map to copy.
+     * @return Reference to this.
+     */
+    idense_unordered_map& operator=(const idense_unordered_map& other)
+    {
+        if(this != &other)
+        {
+            BN_ASSERT(other._size <= max_size(), "Not enough space: ", max_size(), " - ", other._size);
+
+            clear();
+            _assign(other);
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     *
+     * Unlike `std::unordered_map`, it doesn't offer pointer stability.
+     *
+     * @param other idense_unordered_map to move.
+     * @return Reference to this.
+     */
+    idense_unordered_map& operator=(idense_unordered_map&& other) noexcept
+    {
+        if(this != &other)
+        {
+            BN_ASSERT(other._size <= max_size(), "Not enough space: ", max_size(), " - ", other._size);
+
+            clear();
+            _assign(move(other));
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Returns the current size.
+     */
+    [[nodiscard]] size_type size() const
+    {
+        return _size;
+    }
+
+    /**
+     * @brief Returns the maximum possible size.
+     */
+    [[nodiscard]] size_type max_size() const
+    {
+        return _max_size;
+    }
+
+    /**
+     * @brief Returns the remaining capacity.
+     */
+    [[nodiscard]] size_type available() const
+    {
+        return _max_size - _size;
+    }
+
+    /**
+     * @brief Indicates if it doesn't contain any element.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _size == 0;
+    }
+
+    /**
+     * @brief Indicates if it can't contain any more elements.
+     */
+    [[nodiscard]] bool full() const
+    {
+        return _size == _max_size;
+    }
+
+    /**
+     * @brief Returns a const pointer to the beginning of the stored (Key, Value) pairs.
+     */
+    [[nodiscard]] const_pointer data() const
+    {
+        return _storage;
+    }
+
+    /**
+     * @brief Returns a pointer to the beginning of the stored (Key, Value) pairs.
+     */
+    [[nodiscard]] pointer data()
+    {
+        return _storage;
+    }
+
+    /**
+     * @brief Returns a const iterator to the beginning of the idense_unordered_map.
+     */
+    [[nodiscard]] const_iterator begin() const
+    {
+        return _storage;
+    }
+
+    /**
+     * @brief Returns an iterator to the beginning of the idense_unordered_map.
+     */
+    [[nodiscard]] iterator begin()
+    {
+        return _storage;
+    }
+
+    /**
+     * @brief Returns a const iterator to the end of the idense_unordered_map.
+     */
+    [[nodiscard]] const_iterator end() const
+    {
+        return _storage + _size;
+    }
+
+    /**
+     * @brief Returns an iterator to the end of the idense_unordered_map.
+     */
+    [[nodiscard]] iterator end()
+    {
+        return _storage + _size;
+    }
+
+    /**
+     * @brief Returns a const iterator to the beginning of the idense_unordered_map.
+     */
+    [[nodiscard]] const_iterator cbegin() const
+    {
+        return _storage;
+    }
+
+    /**
+     * @brief Returns a const iterator to the end of the idense_unordered_map.
+     */
+    [[nodiscard]] const_iterator cend() const
+    {
+        return _storage + _size;
+    }
+
+    /**
+     * @brief Returns a const reverse iterator to the end of the idense_unordered_map.
+     */
+    [[nodiscard]] const_reverse_iterator rbegin() const
+    {
+        return const_reverse_iterator(end());
+    }
+
+    /**
+     * @brief Returns a reverse iterator to the end of the idense_unordered_map.
+     */
+    [[nodiscard]] reverse_iterator rbegin()
+    {
+        return reverse_iterator(end());
+    }
+
+    /**
+     * @brief Returns a const reverse iterator to the beginning of the idense_unordered_map.
+     */
+    [[nodiscard]] const_reverse_iterator rend() const
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    /**
+     * @brief Returns a reverse iterator to the beginning of the idense_unordered_map.
+     */
+    [[nodiscard]] reverse_iterator rend()
+    {
+        return reverse_iterator(begin());
+    }
+
+    /**
+     * @brief Returns a const reverse iterator to the end of the idense_unordered_map.
+     */
+    [[nodiscard]] const_reverse_iterator crbegin() const
+    {
+        return const_reverse_iterator(cend());
+    }
+
+    /**
+     * @brief Returns a const reverse iterator to the beginning of the idense_unordered_map.
+     */
+    [[nodiscard]] const_reverse_iterator crend() const
+    {
+        return const_reverse_iterator(cbegin());
+    }
+
+    /**
+     * @brief Indicates if the specified key is contained in this idense_unordered_map.
+     * @param key Key to search for.
+     * @return `true` if the specified key is contained in this idense_unordered_map, otherwise `false`.
+     */
+    [[nodiscard]] bool contains(const key_type& key) const
+    {
+        if(empty())
+        {
+            return false;
+        }
+
+        return contains_hash(hasher()(key), key);
+    }
+
+    /**
+     * @brief Indicates if the specified key is contained in this idense_unordered_map.
+     * @param key_hash Hash of the given key to search for.
+     * @param key Key to search for.
+     * @return `true` if the specified key is contained in this idense_unordered_map, otherwise `false`.
+     */
+    [[nodiscard]] bool contains_hash(hash_type key_hash, const key_type& key) const
+    {
+        return find_hash(key_hash, key) != end();
+    }
+
+    /**
+     * @brief Counts the number of keys stored in this idense_unordered_map are equal to the given one.
+     * @param key Key to search for.
+     * @return 1 if the specified key is contained in this idense_unordered_map, otherwise 0.
+     */
+    [[nodiscard]] size_type count(const key_type& key) const
+    {
+        return count_hash(hasher()(key), key);
+    }
+
+    /**
+     * @brief Counts the number of keys stored in this idense_unordered_map are equal to the given one.
+     * @param key_hash Hash of the given key to search for.
+     * @param key Key to search for.
+     * @return 1 if the specified key is contained in this idense_unordered_map, otherwise 0.
+     */
+    [[nodiscard]] size_type count_hash(hash_type key_hash, const key_type& key) const
+    {
+        return contains_hash(key_hash, key) ? 1 : 0;
+    }
+
+    /**
+     * @brief Searches for a given key.
+     * @param key Key to search for.
+     * @return Const iterator to the (Key, Value) pair if it exists, otherwise end().
+     */
+    [[nodiscard]] const_iterator find(const key_type& key) const
+    {
+        return const_cast<idense_unordered_map&>(*this).find(key);
+    }
+
+    /**
+     * @brief Searches for a given key.
+     * @param key Key to search for.
+     * @return Iterator to the (Key, Value) pair if it exists, otherwise end().
+     */
+    [[nodiscard]] iterator find(const key_type& key)
+    {
+        if(empty())
+        {
+            return end();
+        }
+
+        return find_hash(hasher()(key), key);
+    }
+
+    /**
+     * @brief Searches for a given key.
+     * @param key_hash Hash of the given key to search for.
+     * @param key Key to search for.
+     * @return Const iterator to the (Key, Value) pair if it exists, otherwise end().
+     */
+    [[nodiscard]] const_iterator find_hash(hash_type key_hash, const key_type& key) const
+    {
+        return const_cast<idense_unordered_map&>(*this).find_hash(key_hash, key);
+    }
+
+    /**
+     * @brief Searches for a given key.
+     * @param key_hash Hash of the given key to search for.
+     * @param key Key to search for.
+     * @return Iterator to the (Key, Value) pair if it exists, otherwise end().
+     */
+    [[nodiscard]] iterator find_hash(hash_type key_hash, const key_type& key)
+    {
+        pointer storage = _storage;
+        const uint16_t* buckets_metadata = _buckets_metadata;
+        const uint16_t* buckets_elements = _buckets_elements;
+        size_type buckets_mask = _buckets_mask;
+        key_equal key_equal_functor;
+        size_type bucket;
+        unsigned key_metadata;
+        _home(key_hash, bucket, key_metadata);
+
+        // Robin Hood invariant: the search can stop as soon as it finds a bucket closer to its home:
+        while(true)
+        {
+            unsigned bucket_metadata = buckets_metadata[bucket];
+
+            if(bucket_metadata < (key_metadata & ~_fragment_mask))
+            {
+                return storage + _size;
+            }
+
+            if(bucket_metadata == key_metadata)
+            {
+                pointer element = storage + buckets_elements[bucket];
+
+                if(key_equal_functor(key, element->first))
+                {
+                    return element;
+                }
+            }
+
+            bucket = (bucket + 1) & buckets_mask;
+            key_metadata += _distance_increment;
+        }
+    }
+
+    /**
+     * @brief Searches for a given key.
+     * @param key Key to search for.
+     * @return Const reference to the value stored with the specified key.
+     */
+    [[nodiscard]] const mapped_type& at(const key_type& key) const
+    {
+        return const_cast<idense_unordered_map&>(*this).at(key);
+    }
+
+    /**
+     * @brief Searches for a given key.
+     * @param key Key to search for.
+     * @return Reference to the value stored with the specified key.
+     */
+    [[nodiscard]] mapped_type& at(const key_type& key)
+    {
+        return at_hash(hasher()(key), key);
+    }
+
+    /**
+     * @brief Searches for a given key.
+     * @param key_hash Hash of the given key to search for.
+     * @param key Key to search for.
+     * @return Const reference to the value stored with the specified key.
+     */
+    [[nodiscard]] const mapped_type& at_hash(hash_type key_hash, const key_type& key) const
+    {
+        return const_cast<idense_unordered_map&>(*this).at_hash(key_hash, key);
+    }
+
+    /**
+     * @brief Searches for a given key.
+     * @param key_hash Hash of the given key to search for.
+     * @param key Key to search for.
+     * @return Reference to the value stored with the specified key.
+     */
+    [[nodiscard]] mapped_type& at_hash(hash_type key_hash, const key_type& key)
+    {
+        iterator it = find_hash(key_hash, key);
+        BN_BASIC_ASSERT(it != end(), "Key not found");
+
+        return it->second;
+    }
+
+    /**
+     * @brief Inserts a copy of the given (Key, Value) pair.
+     * @param value (Key, Value) pair to insert.
+     * @return Iterator pointing to the inserted (Key, Value) pair if the key does not exist, otherwise end().
+     */
+    iterator insert(const value_type& value)
+    {
+        return insert_hash(hasher()(value.first), value);
+    }
+
+    /**
+     * @brief Inserts a moved (Key, Value) pair.
+     * @param value (Key, Value) pair to insert.
+     * @return Iterator pointing to the inserted (Key, Value) pair if the key does not exist, otherwise end().
+     */
+    iterator insert(value_type&& value)
+    {
+        return insert_hash(hasher()(value.first), move(value));
+    }
+
+    /**
+     * @brief Inserts a copy of the given (Key, Value) pair.
+     * @param key Key to insert.
+     * @param mapped_value Value to insert.
+     * @return Iterator pointing to the inserted (Key, Value) pair if the key does not exist, otherwise end().
+     */
+    iterator insert(const key_type& key, const mapped_type& mapped_value)
+    {
+        return insert_hash(hasher()(key), value_type(key, mapped_value));
+    }
+
+    /**
+     * @brief Inserts a moved (Key, Value) pair.
+     * @param key Key to insert.
+     * @param mapped_value Value to insert.
+     * @return Iterator pointing to the inserted (Key, Value) pair if the key does not exist, otherwise end().
+     */
+    iterator insert(const key_type& key, mapped_type&& mapped_value)
+    {
+        return insert_hash(hasher()(key), value_type(key, move(mapped_value)));
+    }
+
+    /**
+     * @brief Inserts a copy of the given (Key, Value) pair.
+     * @param key_hash Hash of the key to insert.
+     * @param value (Key, Value) pair to insert.
+     * @return Iterator pointing to the inserted (Key, Value) pair if the key does not exist, otherwise end().
+     */
+    iterator insert_hash(hash_type key_hash, const value_type& value)
+    {
+        return insert_hash(key_hash, value_type(value));
+    }
+
+    /**
+     * @brief Inserts a moved (Key, Value) pair.
+     * @param key_hash Hash of the key to insert.
+     * @param value (Key, Value) pair to insert.
+     * @return Iterator pointing to the inserted (Key, Value) pair if the key does not exist, otherwise end().
+     */
+    iterator insert_hash(hash_type key_hash, value_type&& value)
+    {
+        pointer storage = _storage;
+        const uint16_t* buckets_metadata = _buckets_metadata;
+        const uint16_t* buckets_elements = _buckets_elements;
+        size_type buckets_mask = _buckets_mask;
+        size_type size = _size;
+        key_equal key_equal_functor;
+        size_type bucket;
+        unsigned key_metadata;
+        _home(key_hash, bucket, key_metadata);
+
+        while(true)
+        {
+            unsigned bucket_metadata = buckets_metadata[bucket];
+
+            if(bucket_metadata < (key_metadata & ~_fragment_mask))
+            {
+                break;
+            }
+
+            if(bucket_metadata == key_metadata && key_equal_functor(value.first, storage[buckets_elements[bucket]].first))
+            {
+                return storage + size;
+            }
+
+            bucket = (bucket + 1) & buckets_mask;
+            key_metadata += _distance_increment;
+        }
+
+        BN_BASIC_ASSERT(size < _max_size, "All indices are allocated");
+
+        ::new(static_cast<void*>(storage + size)) value_type(move(value));
+        _size = size + 1;
+        _place(bucket, key_metadata, size);
+        return storage + size;
+    }
+
+    /**
+     * @brief Inserts a copy of the given (Key, Value) pair.
+     * @param key_hash Hash of the key to insert.
+     * @param key Key to insert.
+     * @param mapped_value Value to insert.
+     * @return Iterator pointing to the inserted (Key, Value) pair if the key does not exist, otherwise end().
+     */
+    iterator insert_hash(hash_type key_hash, const key_type& key, const mapped_type& mapped_value)
+    {
+        return insert_hash(key_hash, value_type(key, mapped_value));
+    }
+
+    /**
+     * @brief Inserts a moved (Key, Value) pair.
+     * @param key_hash Hash of the key to insert.
+     * @param key Key to insert.
+     * @param mapped_value Value to insert.
+     * @return Iterator pointing to the inserted (Key, Value) pair if the key does not exist, otherwise end().
+     */
+    iterator insert_hash(hash_type key_hash, const key_type& key, mapped_type&& mapped_value)
+    {
+        return insert_hash(key_hash, value_type(key, move(mapped_value)));
+    }
+
+    /**
+     * @brief Inserts a copy of the given (Key, Value) pair
+     * or replaces the value with the given one if the key is found.
+     * @param value (Key, Value) pair to insert or assign.
+     * @return Iterator pointing to the inserted or assigned (Key, Value) pair.
+     */
+    iterator insert_or_assign(const value_type& value)
+    {
+        return insert_or_assign_hash(hasher()(value.first), value);
+    }
+
+    /**
+     * @brief Inserts a moved (Key, Value) pair
+     * or replaces the value with the given one if the key is found.
+     * @param value (Key, Value) pair to insert or assign.
+     * @return Iterator pointing to the inserted or assigned (Key, Value) pair.
+     */
+    iterator insert_or_assign(value_type&& value)
+    {
+        return insert_or_assign_hash(hasher()(value.first), move(value));
+    }
+
+    /**
+     * @brief Inserts a copy of the given (Key, Value) pair
+     * or replaces the value with the given one if the key is found.
+     * @param key Key to insert or assign.
+     * @param mapped_value Value to insert or assign.
+     * @return Iterator pointing to the inserted or assigned (Key, Value) pair.
+     */
+    iterator insert_or_assign(const key_type& key, const mapped_type& mapped_value)
+    {
+        return insert_or_assign_hash(hasher()(key), value_type(key, mapped_value));
+    }
+
+    /**
+     * @brief Inserts a moved (Key, Value) pair
+     * or replaces the value with the given one if the key is found.
+     * @param key Key to insert or assign.
+     * @param mapped_value Value to insert or assign.
+     * @return Iterator pointing to the inserted or assigned (Key, Value) pair.
+     */
+    iterator insert_or_assign(const key_type& key, mapped_type&& mapped_value)
+    {
+        return insert_or_assign_hash(hasher()(key), value_type(key, move(mapped_value)));
+    }
+
+    /**
+     * @brief Inserts a copy of the given (Key, Value) pair
+     * or replaces the value with the given one if the key is found.
+     * @param key_hash Hash of the key to insert or assign.
+     * @param value (Key, Value) pair to insert or assign.
+     * @return Iterator pointing to the inserted or assigned (Key, Value) pair.
+     */
+    iterator insert_or_assign_hash(hash_type key_hash, const value_type& value)
+    {
+        return insert_or_assign_hash(key_hash, value_type(value));
+    }
+
+    /**
+     * @brief Inserts a moved (Key, Value) pair
+     * or replaces the value with the given one if the key is found.
+     * @param key_hash Hash of the key to insert or assign.
+     * @param value (Key, Value) pair to insert or assign.
+     * @return Iterator pointing to the inserted or assigned (Key, Value) pair.
+     */
+    iterator insert_or_assign_hash(hash_type key_hash, value_type&& value)
+    {
+        iterator it = find_hash(key_hash, value.first);
+
+        if(it == end())
+        {
+            it = insert_hash(key_hash, move(value));
+            BN_BASIC_ASSERT(it != end(), "Insertion failed");
+        }
+        else
+        {
+            it->~value_type();
+            ::new(static_cast<void*>(it)) value_type(move(value));
+        }
+
+        return it;
+    }
+
+    /**
+     * @brief Inserts a copy of the given (Key, Value) pair
+     * or replaces the value with the given one if the key is found.
+     * @param key_hash Hash of the key to insert or assign.
+     * @param key Key to insert or assign.
+     * @param mapped_value Value to insert or assign.
+     * @return Iterator pointing to the inserted or assigned (Key, Value) pair.
+     */
+    iterator insert_or_assign_hash(hash_type key_hash, const key_type& key, const mapped_type& mapped_value)
+    {
+        return insert_or_assign_hash(key_hash, value_type(key, mapped_value));
+    }
+
+    /**
+     * @brief Inserts a moved (Key, Value) pair
+     * or replaces the value with the given one if the key is found.
+     * @param key_hash Hash of the key to insert or assign.
+     * @param key Key to insert or assign.
+     * @param mapped_value Value to insert or assign.
+     * @return Iterator pointing to the inserted or assigned (Key, Value) pair.
+     */
+    iterator insert_or_assign_hash(hash_type key_hash, const key_type& key, mapped_type&& mapped_value)
+    {
+        return insert_or_assign_hash(key_hash, value_type(key, move(mapped_value)));
+    }
+
+    /**
+     * @brief Inserts in-place a (Key, Value) pair if the given key does not exist.
+     * @param key Key to insert.
+     * @param args Parameters of the value to insert.
+     * @return Iterator pointing to the inserted (Key, Value) pair if the key does not exist,
+     * otherwise iterator pointing to the existing (Key, Value) pair.
+     */
+    template<typename... Args>
+    iterator try_emplace(const key_type& key, Args&&... args)
+    {
+        return try_emplace_hash(hasher()(key), key, forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Inserts in-place a (Key, Value) pair if the given key does not exist.
+     * @param key_hash Hash of the key to insert.
+     * @param key Key to insert.
+     * @param args Parameters of the value to insert.
+     * @return Iterator pointing to the inserted (Key, Value) pair if the key does not exist,
+     * otherwise iterator pointing to the existing (Key, Value) pair.
+     */
+    template<typename... Args>
+    iterator try_emplace_hash(hash_type key_hash, const key_type& key, Args&&... args)
+    {
+        iterator it = find_hash(key_hash, key);
+
+        if(it == end())
+        {
+            it = insert_hash(key_hash, key, mapped_type(forward<Args>(args)...));
+            BN_BASIC_ASSERT(it != end(), "Insertion failed");
+        }
+
+        return it;
+    }
+
+    /**
+     * @brief Erases an element.
+     *
+     * The last element is moved to the position of the erased one,
+     * so unlike `std::unordered_map`, it doesn't offer pointer stability.
+     *
+     * @param position Iterator to the element to erase.
+     * @return Iterator following the erased element.
+     */
+    iterator erase(const_iterator position)
+    {
+        pointer storage = _storage;
+        size_type element = position - storage;
+        size_type last_element = _size - 1;
+        BN_BASIC_ASSERT(element >= 0 && element <= last_element, "Invalid position: ", element);
+
+        uint16_t* buckets_metadata = _buckets_metadata;
+        uint16_t* buckets_elements = _buckets_elements;
+        uint16_t* element_buckets = _element_buckets;
+        size_type buckets_mask = _buckets_mask;
+        size_type bucket = element_buckets[element];
+        size_type next_bucket = (bucket + 1) & buckets_mask;
+        unsigned next_metadata = buckets_metadata[next_bucket];
+
+        // Backward shift deletion (no tombstones):
+        while(next_metadata >= _distance_increment * 2)
+        {
+            size_type next_element = buckets_elements[next_bucket];
+            buckets_metadata[bucket] = uint16_t(next_metadata - _distance_increment);
+            buckets_elements[bucket] = uint16_t(next_element);
+            element_buckets[next_element] = uint16_t(bucket);
+            bucket = next_bucket;
+            next_bucket = (next_bucket + 1) & buckets_mask;
+            next_metadata = buckets_metadata[next_bucket];
+        }
+
+        buckets_metadata[bucket] = 0;
+        storage[element].~value_type();
+
+        if(element != last_element)
+        {
+            ::new(static_cast<void*>(storage + element)) value_type(move(storage[last_element]));
+            storage[last_element].~value_type();
+
+            size_type last_bucket = element_buckets[last_element];
+            element_buckets[element] = uint16_t(last_bucket);
+            buckets_elements[last_bucket] = uint16_t(element);
+        }
+
+        _size = last_element;
+        return storage + element;
+    }
+
+    /**
+     * @brief Erases an element.
+     *
+     * Unlike `std::unordered_map`, it doesn't offer pointer stability.
+     *
+     * @param key Key to erase.
+     * @return `true` if the elements was erased, otherwise `false`.
+     */
+    bool erase(const key_type& key)
+    {
+        return erase_hash(hasher()(key), key);
+    }
+
+    /**
+     * @brief Erases an element.
+     *
+     * Unlike `std::unordered_map`, it doesn't offer pointer stability.
+     *
+     * @param key_hash Hash of the key to erase.
+     * @param key Key to erase.
+     * @return `true` if the elements was erased, otherwise `false`.
+     */
+    bool erase_hash(hash_type key_hash, const key_type& key)
+    {
+        iterator it = find_hash(key_hash, key);
+
+        if(it != end())
+        {
+            erase(it);
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Erases all elements that satisfy the specified predicate.
+     *
+     * Unlike `std::unordered_map`, it doesn't offer pointer stability.
+     *
+     * @param pred Unary predicate which returns ​true if the element should be erased.
+     * @return Number of erased elements.
+     */
+    template<class Pred>
+    size_type erase_if(const Pred& pred)
+    {
+        pointer storage = _storage;
+        size_type erased_count = 0;
+        size_type index = 0;
+
+        while(index < _size)
+        {
+            if(pred(storage[index]))
+            {
+                erase(storage + index);
+                ++erased_count;
+            }
+            else
+            {
+                ++index;
+            }
+        }
+
+        return erased_count;
+    }
+
+    /**
+     * @brief Moves all elements of the given idense_unordered_map into this one, leaving the first one empty.
+     *
+     * Unlike `std::unordered_map`, it doesn't offer pointer stability.
+     */
+    void merge(idense_unordered_map&& other) noexcept
+    {
+        if(this != &other)
+        {
+            pointer other_storage = other._storage;
+
+            for(size_type index = 0, other_size = other._size; index < other_size; ++index)
+            {
+                insert_or_assign(move(other_storage[index]));
+            }
+
+            other.clear();
+        }
+    }
+
+    /**
+     * @brief Removes all elements.
+     */
+    void clear()
+    {
+        if(_size)
+        {
+            memory::clear(_buckets_mask + 1, *_buckets_metadata);
+            _size = 0;
+        }
+    }
+
+    /**
+     * @brief Removes all elements.
+     */
+    void clear()
+    requires(! is_trivially_destructible_v<value_type>)
+    {
+        if(size_type size = _size)
+        {
+            pointer storage = _storage;
+
+            for(size_type index = 0; index < size; ++index)
+            {
+                storage[index].~value_type();
+            }
+
+            memory::clear(_buckets_mask + 1, *_buckets_metadata);
+            _size = 0;
+        }
+    }
+
+    /**
+     * @brief Returns a reference to the value that is mapped to the given key,
+     * performing an insertion if such key does not already exist.
+     * @param key Key to search for.
+     * @return Reference to the value that is mapped to the given key.
+     */
+    [[nodiscard]] mapped_type& operator[](const key_type& key)
+    {
+        return operator()(hasher()(key), key);
+    }
+
+    /**
+     * @brief Returns a reference to the value that is mapped to the given key,
+     * performing an insertion if such key does not already exist.
+     * @param key Key to search for.
+     * @return Reference to the value that is mapped to the given key.
+     */
+    [[nodiscard]] mapped_type& operator()(const key_type& key)
+    {
+        return operator()(hasher()(key), key);
+    }
+
+    /**
+     * @brief Returns a reference to the value that is mapped to the given key,
+     * performing an insertion if such key does not already exist.
+     * @param key_hash Hash of the key to search for.
+     * @param key Key to search for.
+     * @return Reference to the value that is mapped to the given key.
+     */
+    [[nodiscard]] mapped_type& operator()(hash_type key_hash, const key_type& key)
+    {
+        iterator it = find_hash(key_hash, key);
+
+        if(it == end())
+        {
+            it = insert_hash(key_hash, key, mapped_type());
+            BN_BASIC_ASSERT(it != end(), "Insertion failed");
+        }
+
+        return it->second;
+    }
+
+    /**
+     * @brief Exchanges the contents of this idense_unordered_map with those of the other one.
+     *
+     * Unlike `std::unordered_map`, it doesn't offer pointer stability.
+     *
+     * @param other idense_unordered_map to exchange the contents with.
+     */
+    void swap(idense_unordered_map& other)
+    {
+        if(this != &other)
+        {
+            BN_ASSERT(_max_size == other._max_size, "Invalid max size: ", _max_size, " - ", other._max_size);
+
+            pointer storage = _storage;
+            pointer other_storage = other._storage;
+            size_type size = _size;
+            size_type other_size = other._size;
+            size_type min_size = min(size, other_size);
+
+            for(size_type index = 0; index < min_size; ++index)
+            {
+                value_type temp_value(move(storage[index]));
+                storage[index].~value_type();
+                ::new(static_cast<void*>(storage + index)) value_type(move(other_storage[index]));
+                other_storage[index].~value_type();
+                ::new(static_cast<void*>(other_storage + index)) value_type(move(temp_value));
+            }
+
+            for(size_type index = min_size; index < size; ++index)
+            {
+                ::new(static_cast<void*>(other_storage + index)) value_type(move(storage[index]));
+                storage[index].~value_type();
+            }
+
+            for(size_type index = min_size; index < other_size; ++index)
+            {
+                ::new(static_cast<void*>(storage + index)) value_type(move(other_storage[index]));
+                other_storage[index].~value_type();
+            }
+
+            for(size_type index = 0, max_size = bn::max(size, other_size); index < max_size; ++index)
+            {
+                bn::swap(_element_buckets[index], other._element_buckets[index]);
+            }
+
+            for(size_type bucket = 0, buckets = _buckets_mask + 1; bucket < buckets; ++bucket)
+            {
+                bn::swap(_buckets_metadata[bucket], other._buckets_metadata[bucket]);
+                bn::swap(_buckets_elements[bucket], other._buckets_elements[bucket]);
+            }
+
+            bn::swap(_size, other._size);
+        }
+    }
+
+    /**
+     * @brief Exchanges the contents of a idense_unordered_map with those of another one.
+     *
+     * Unlike `std::unordered_map`, it doesn't offer pointer stability.
+     *
+     * @param a First idense_unordered_map to exchange the contents with.
+     * @param b Second idense_unordered_map to exchange the contents with.
+     */
+    friend void swap(idense_unordered_map& a, idense_unordered_map& b)
+    {
+        a.swap(b);
+    }
+
+    /**
+     * @brief Equal operator.
+     * @param a First idense_unordered_map to compare.
+     * @param b Second idense_unordered_map to compare.
+     * @return `true` if both idense_unordered_map contain the same (Key, Value) pairs, otherwise `false`.
+     */
+    [[nodiscard]] friend bool operator==(const idense_unordered_map& a, const idense_unordered_map& b)
+    {
+        if(a._size != b._size)
+        {
+            return false;
+        }
+
+        for(const_reference value : a)
+        {
+            const_iterator it = b.find(value.first);
+
+            if(it == b.end() || *it != value)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Less than operator.
+     * @param a First idense_unordered_map to compare.
+     * @param b Second idense_unordered_map to compare.
+     * @return `true` if the first idense_unordered_map is lexicographically less than the second one,
+     * otherwise `false`.
+     */
+    [[nodiscard]] friend bool operator<(const idense_unordered_map& a, const idense_unordered_map& b)
+    {
+        return lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+    }
+
+    /**
+     * @brief Greater than operator.
+     * @param a First idense_unordered_map to compare.
+     * @param b Second idense_unordered_map to compare.
+     * @return `true` if the first idense_unordered_map is lexicographically greater than the second one,
+     * otherwise `false`.
+     */
+    [[nodiscard]] friend bool operator>(const idense_unordered_map& a, const idense_unordered_map& b)
+    {
+        return b < a;
+    }
+
+    /**
+     * @brief Less than or equal operator.
+     * @param a First idense_unordered_map to compare.
+     * @param b Second idense_unordered_map to compare.
+     * @return `true` if the first idense_unordered_map is lexicographically less than or equal to the second one,
+     * otherwise `false`.
+     */
+    [[nodiscard]] friend bool operator<=(const idense_unordered_map& a, const idense_unordered_map& b)
+    {
+        return ! (a > b);
+    }
+
+    /**
+     * @brief Greater than or equal operator.
+     * @param a First idense_unordered_map to compare.
+     * @param b Second idense_unordered_map to compare.
+     * @return `true` if the first idense_unordered_map is lexicographically greater than or equal to the second one,
+     * otherwise `false`.
+     */
+    [[nodiscard]] friend bool operator>=(const idense_unordered_map& a, const idense_unordered_map& b)
+    {
+        return ! (a < b);
+    }
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    idense_unordered_map(reference storage, uint16_t& element_buckets, uint16_t& buckets_metadata,
+                         uint16_t& buckets_elements, size_type max_size, size_type buckets) :
+        _storage(&storage),
+        _element_buckets(&element_buckets),
+        _buckets_metadata(&buckets_metadata),
+        _buckets_elements(&buckets_elements),
+        _max_size(max_size),
+        _buckets_mask(buckets - 1),
+        _buckets_shift(32 - __builtin_ctz(unsigned(buckets)))
+    {
+    }
+
+    void _assign(const idense_unordered_map& other)
+    {
+        const_pointer other_storage = other._storage;
+        pointer storage = _storage;
+        size_type other_size = other._size;
+
+        if(_buckets_mask == other._buckets_mask)
+        {
+            for(size_type index = 0; index < other_size; ++index)
+            {
+                ::new(static_cast<void*>(storage + index)) value_type(other_storage[index]);
+            }
+
+            _assign_buckets(other);
+        }
+        else
+        {
+            for(size_type index = 0; index < other_size; ++index)
+            {
+                insert(other_storage[index]);
+            }
+        }
+    }
+
+    void _assign(idense_unordered_map&& other)
+    {
+        pointer other_storage = other._storage;
+        pointer storage = _storage;
+        size_type other_size = other._size;
+
+        if(_buckets_mask == other._buckets_mask)
+        {
+            for(size_type index = 0; index < other_size; ++index)
+            {
+                ::new(static_cast<void*>(storage + index)) value_type(move(other_storage[index]));
+            }
+
+            _assign_buckets(other);
+        }
+        else
+        {
+            for(size_type index = 0; index < other_size; ++index)
+            {
+                insert(move(other_storage[index]));
+            }
+        }
+
+        other.clear();
+    }
+
+    /// @endcond
+
+private:
+    static constexpr int _fragment_bits = 3;
+    static constexpr unsigned _fragment_mask = (1 << _fragment_bits) - 1;
+    static constexpr unsigned _distance_increment = 1 << _fragment_bits;
+    static constexpr unsigned _max_metadata = 0xFFFF;
+
+    static_assert(max_probe_length == int(_max_metadata >> _fragment_bits));
+
+    pointer _storage;
+    uint16_t* _element_buckets;
+    uint16_t* _buckets_metadata;
+    uint16_t* _buckets_elements;
+    size_type _max_size;
+    size_type _buckets_mask;
+    size_type _buckets_shift;
+    size_type _size = 0;
+
+    /*
+     * Each bucket has a metadata half-word: the upper bits store the distance from the home bucket plus one
+     * (0 means empty bucket), and the lower bits store a fragment of the hash.
+     *
+     * The hash is mixed with Fibonacci hashing, so weak hashes (aligned pointers for example)
+     * don't put all elements in the same buckets.
+     */
+    void _home(hash_type key_hash, size_type& bucket, unsigned& metadata) const
+    {
+        unsigned mixed_hash = key_hash * 2654435769u;
+        size_type buckets_shift = _buckets_shift;
+        bucket = size_type(mixed_hash >> buckets_shift);
+        metadata = _distance_increment | ((mixed_hash >> (buckets_shift - _fragment_bits)) & _fragment_mask);
+    }
+
+    void _place(size_type bucket, unsigned metadata, size_type element)
+    {
+        uint16_t* buckets_metadata = _buckets_metadata;
+        uint16_t* buckets_elements = _buckets_elements;
+        uint16_t* element_buckets = _element_buckets;
+        size_type buckets_mask = _buckets_mask;
+
+        // Robin Hood insertion: take the place of the first element closer to its home and keep moving it:
+        while(true)
+        {
+            unsigned bucket_metadata = buckets_metadata[bucket];
+
+            if(bucket_metadata < (metadata & ~_fragment_mask))
+            {
+                BN_BASIC_ASSERT(metadata <= _max_metadata, "Max probe length exceeded: ", max_probe_length);
+
+                size_type bucket_element = buckets_elements[bucket];
+                buckets_metadata[bucket] = uint16_t(metadata);
+                buckets_elements[bucket] = uint16_t(element);
+                element_buckets[element] = uint16_t(bucket);
+
+                if(! bucket_metadata)
+                {
+                    return;
+                }
+
+                metadata = bucket_metadata;
+                element = bucket_element;
+            }
+
+            bucket = (bucket + 1) & buckets_mask;
+            metadata += _distance_increment;
+        }
+    }
+
+    void _assign_buckets(const idense_unordered_map& other)
+    {
+        size_type buckets = _buckets_mask + 1;
+        memory::copy(*other._element_buckets, other._size, *_element_buckets);
+        memory::copy(*other._buckets_metadata, buckets, *_buckets_metadata);
+        memory::copy(*other._buckets_elements, buckets, *_buckets_elements);
+        _size = other._size;
+    }
+};
+
+
+template<typename Key, typename Value, int MaxSize, typename KeyHash, typename KeyEqual>
+class dense_unordered_map : public idense_unordered_map<Key, Value, KeyHash, KeyEqual>
+{
+    static_assert(power_of_two(MaxSize));
+    static_assert(MaxSize <= idense_unordered_map<Key, Value, KeyHash, KeyEqual>::max_probe_length);
+
+public:
+    using key_type = Key; //!< Key type alias.
+    using mapped_type = Value; //!< Value type alias.
+    using value_type = pair<const key_type, mapped_type>; //!< (Key, Value) pair type alias.
+    using size_type = int; //!< Size type alias.
+    using difference_type = int; //!< Difference type alias.
+    using hash_type = unsigned; //!< Hash type alias.
+    using hasher = KeyHash; //!< Hash functor alias.
+    using key_equal = KeyEqual; //!< Equality functor alias.
+    using reference = value_type&; //!< (Key, Value) pair reference alias.
+    using const_reference = const value_type&; //!< (Key, Value) pair const reference alias.
+    using pointer = value_type*; //!< (Key, Value) pair pointer alias.
+    using const_pointer = const value_type*; //!< (Key, Value) pair const pointer alias.
+
+    /**
+     * @brief Default constructor.
+     */
+    dense_unordered_map() :
+        idense_unordered_map<Key, Value, KeyHash, KeyEqual>(
+            *reinterpret_cast<pointer>(_storage_buffer), *_element_buckets_buffer, *_buckets_metadata_buffer,
+            *_buckets_elements_buffer, MaxSize, _buckets)
+    {
+    }
+
+    /**
+     * @brief Copy constructor.
+     * @param other dense_unordered_map to copy.
+     */
+    dense_unordered_map(const dense_unordered_map& other) :
+        dense_unordered_map()
+    {
+        this->_assign(other);
+    }
+
+    /**
+     * @brief Move constructor.
+     *
+     * Unlike `std::unordered_map`, it doesn't offer pointer stability.
+     *
+     * @param other dense_unordered_map to move.
+     */
+    dense_unordered_map(dense_unordered_map&& other) noexcept :
+        dense_unordered_map()
+    {
+        this->_assign(move(other));
+    }
+
+    /**
+     * @brief Copy constructor.
+     * @param other idense_unordered_map to copy.
+     */
+    dense_unordered_map(const idense_unordered_map<Key, Value, KeyHash, KeyEqual>& other) :
+        dense_unordered_map()
+    {
+        BN_ASSERT(other.size() <= MaxSize, "Not enough space: ", MaxSize, " - ", other.size());
+
+        this->_assign(other);
+    }
+
+    /**
+     * @brief Move constructor.
+     *
+     * Unlike `std::unordered_map`, it doesn't offer pointer stability.
+     *
+     * @param other idense_unordered_map to move.
+     */
+    dense_unordered_map(idense_unordered_map<Key, Value, KeyHash, KeyEqual>&& other) noexcept :
+        dense_unordered_map()
+    {
+        BN_ASSERT(other.size() <= MaxSize, "Not enough space: ", MaxSize, " - ", other.size());
+
+        this->_assign(move(other));
+    }
+
+    /**
+     * @brief Copy assignment operator.
+     * @param other dense_unordered_map to copy.
+     * @return Reference to this.
+     */
+    dense_unordered_map& operator=(const dense_unordered_map& other)
+    {
+        if(this != &other)
+        {
+            this->clear();
+            this->_assign(other);
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     *
+     * Unlike `std::unordered_map`, it doesn't offer pointer stability.
+     *
+     * @param other dense_unordered_map to move.
+     * @return Reference to this.
+     */
+    dense_unordered_map& operator=(dense_unordered_map&& other) noexcept
+    {
+        if(this != &other)
+        {
+            this->clear();
+            this->_assign(move(other));
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Copy assignment operator.
+     * @param other idense_unordered_map to copy.
+     * @return Reference to this.
+     */
+    dense_unordered_map& operator=(const idense_unordered_map<Key, Value, KeyHash, KeyEqual>& other)
+    {
+        if(this != &other)
+        {
+            BN_ASSERT(other.size() <= MaxSize, "Not enough space: ", MaxSize, " - ", other.size());
+
+            this->clear();
+            this->_assign(other);
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     *
+     * Unlike `std::unordered_map`, it doesn't offer pointer stability.
+     *
+     * @param other idense_unordered_map to move.
+     * @return Reference to this.
+     */
+    dense_unordered_map& operator=(idense_unordered_map<Key, Value, KeyHash, KeyEqual>&& other) noexcept
+    {
+        if(this != &other)
+        {
+            BN_ASSERT(other.size() <= MaxSize, "Not enough space: ", MaxSize, " - ", other.size());
+
+            this->clear();
+            this->_assign(move(other));
+        }
+
+        return *this;
+    }
+
+private:
+    // Index table load factor is kept at 50% or less:
+    static constexpr int _buckets = MaxSize * 2;
+    static constexpr unsigned _alignment = alignof(value_type) > alignof(int) ? alignof(value_type) : alignof(int);
+
+    alignas(_alignment) char _storage_buffer[sizeof(value_type) * MaxSize];
+    uint16_t _element_buckets_buffer[MaxSize];
+    uint16_t _buckets_elements_buffer[_buckets];
+    uint16_t _buckets_metadata_buffer[_buckets] = {};
+};
+
+
+/**
+ * @brief Erases all elements from a idense_unordered_map that satisfy the specified predicate.
+ *
+ * Unlike `std::unordered_map`, it doesn't offer pointer stability.
+ *
+ * @param map idense_unordered_map from which to erase.
+ * @param pred Unary predicate which returns ​true if the element should be erased.
+ * @return Number of erased elements.
+ */
+template<typename Type, typename Value, typename KeyHash, typename KeyEqual, class Pred>
+typename idense_unordered_map<Type, Value, KeyHash, KeyEqual>::size_type erase_if(
+        idense_unordered_map<Type, Value, KeyHash, KeyEqual>& map, const Pred& pred)
+{
+    return map.erase_if(pred);
+}
+
+}
+
+#endif
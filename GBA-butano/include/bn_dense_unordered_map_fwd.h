@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_DENSE_UNORDERED_MAP_FWD_H
+#define BN_DENSE_UNORDERED_MAP_FWD_H
+
+/**
+ * @file
+ * bn::idense_unordered_map and bn::dense_unordered_map declaration header file.
+ *
+ * @ingroup unordered_map
+ */
+
+#include "bn_functional.h"
+
+namespace bn
+{
+    /**
+     * @brief Base class of bn::dense_unordered_map.
+     *
+     * Can be used as a reference type for all bn::dense_unordered_map containers containing a specific type.
+     *
+     * Unlike `std::unordered_map`, it doesn't offer pointer stability when erasing elements.
+     *
+     * @tparam Key Key type.
+     * @tparam Value Value type.
+     * @tparam KeyHash Functor used to calculate the hash of a given key.
+     * @tparam KeyEqual Functor used for all key comparisons.
+     *
+     * @ingroup unordered_map
+     */
+    template<typename Key, typename Value, typename KeyHash = hash<Key>, typename KeyEqual = equal_to<Key>>
+    class idense_unordered_map;
+
+    /**
+     * @brief `std::unordered_map` like container with a fixed size buffer,
+     * Robin Hood hashing and contiguous storage of its elements.
+     *
+     * It is an alternative to bn::unordered_map with bounded probe lengths and faster iteration,
+     * at the cost of two extra bytes per element plus four bytes per index table bucket
+     * (the index table has two buckets per element).
+     *
+     * It doesn't throw exceptions. Instead, asserts are used to ensure valid usage.
+     *
+     * Unlike `std::unordered_map`, it doesn't offer pointer stability when erasing elements.
+     *
+     * @tparam Key Key type.
+     * @tparam Value Value type.
+     * @tparam MaxSize Maximum number of elements that can be stored.
+     * @tparam KeyHash Functor used to calculate the hash of a given key.
+     * @tparam KeyEqual Functor used for all key comparisons.
+     *
+     * @ingroup unordered_map
+     */
+    template<typename Key, typename Value, int MaxSize, typename KeyHash = hash<Key>,
+             typename KeyEqual = equal_to<Key>>
+    class dense_unordered_map;
+}
+
+#endif
@@ -17,6 +17,7 @@
 #include "bn_fixed_fwd.h"
 #include "bn_algorithm.h"
 #include "bn_functional.h"
+#include "bn_limits.h"
 
 namespace bn
 {
@@ -413,10 +414,21 @@ public:
     /**
      * @brief Returns the division of this value by the given fixed point value,
      * casting them to int64_t to try to avoid overflow.
+     *
+     * If the scaled dividend fits in 32 bits, a 32-bit division (much faster than a 64-bit one) is used instead.
+     * The minimum int value is excluded, since dividing it by -1 overflows in 32 bits.
      */
     [[nodiscard]] constexpr fixed_t safe_division(fixed_t other) const
     {
-        return from_data(int((int64_t(_data) * scale()) / other._data));
+        int64_t data = int64_t(_data) * scale();
+        int other_data = other._data;
+
+        if(int(data) == data && data != numeric_limits<int>::min()) [[likely]]
+        {
+            return from_data(int(data) / other_data);
+        }
+
+        return from_data(int(data / other_data));
     }
 
     /**
@@ -21,6 +21,9 @@
  *
  * Defines the start of a code block in which elapsed time is going to be measured.
  *
+ * Code blocks can be nested up to @ref BN_CFG_PROFILER_MAX_DEPTH levels.
+ * The elapsed time of a nested code block is also added to the ones containing it.
+ *
  * @param id Small text string which identifies the code block.
  *
  * @ingroup profiler
@@ -29,7 +32,7 @@
 /**
  * @def BN_PROFILER_STOP
  *
- * Defines the end of a code block in which elapsed time is going to be measured.
+ * Defines the end of the last started code block in which elapsed time is going to be measured.
  *
  * @ingroup profiler
  */
@@ -43,7 +46,7 @@
  */
 
 #if BN_CFG_PROFILER_ENABLED || BN_DOXYGEN
-    #include "bn_unordered_map_fwd.h"
+    #include "bn_dense_unordered_map_fwd.h"
 
     /**
      * @brief Profiler related functions.
@@ -56,6 +59,19 @@
          * @brief Stops the execution and shows the profiling results on the screen.
          */
         [[noreturn]] void show();
+
+        /**
+         * @brief Logs the profiling results without stopping the execution.
+         *
+         * For each code block it logs the code block that contained it the first time it was measured
+         * and its total and max ticks.
+         *
+         * If @ref BN_CFG_PROFILER_FRAME_SAMPLES is greater than zero, it also logs the median (p50),
+         * 95th percentile (p95) and max of its ticks per frame in the last @ref BN_CFG_PROFILER_FRAME_SAMPLES frames.
+         *
+         * It does nothing if BN_LOG is disabled.
+         */
+        void log();
     }
 
     /// @cond DO_NOT_DOCUMENT
@@ -66,16 +82,28 @@
         {
             int64_t total = 0;
             int max = 0;
+            const char* parent = nullptr;
+
+            #if BN_CFG_PROFILER_FRAME_SAMPLES > 0
+                int frame = 0;
+                int frame_samples[BN_CFG_PROFILER_FRAME_SAMPLES] = {};
+            #endif
         };
 
-        using ticks_map = bn::unordered_map<const char*, ticks, BN_CFG_PROFILER_MAX_ENTRIES * 2>;
+        using ticks_map = bn::dense_unordered_map<const char*, ticks, BN_CFG_PROFILER_MAX_ENTRIES * 2>;
 
         void start(const char* id, unsigned id_hash);
 
         void stop();
 
+        void update();
+
         [[nodiscard]] const ticks_map& ticks_per_entry();
 
+        #if BN_CFG_PROFILER_FRAME_SAMPLES > 0
+            [[nodiscard]] int frame_ticks_percentile(const ticks& ticks, int percentile);
+        #endif
+
         void reset();
     }
 
@@ -481,6 +481,43 @@ public:
      */
     void set_tiles_and_palette(const regular_bg_tiles_item& tiles_item, const bg_palette_item& palette_item);
 
+    /**
+     * @brief Streams the tiles of this big map on demand from the given source tiles.
+     *
+     * The referenced tiles must have been created with regular_bg_tiles_ptr::allocate or
+     * regular_bg_tiles_ptr::allocate_optional, and they are used as a VRAM tile cache:
+     * the map cells index source tiles, which are uploaded to the cache as they scroll into view.
+     * When a tile is not found in the cache, the least recently used tile not visible anymore is replaced.
+     *
+     * The tile cache must be big enough to hold the different tiles of any 256x256 pixels region of the map.
+     *
+     * 4BPP map cells can index up to 1024 source tiles.
+     * 8BPP map cells use their palette bits as the high bits of the source tile index,
+     * so they can index up to 16384 source tiles.
+     *
+     * @param source_tiles_item regular_bg_tiles_item which references the uncompressed source tiles.
+     * They are not copied but referenced, so they should outlive the regular_bg_map_ptr
+     * to avoid dangling references.
+     */
+    void set_tiles_cache(const regular_bg_tiles_item& source_tiles_item);
+
+    /**
+     * @brief Stops streaming the tiles of this big map, so the map cells are uploaded to VRAM again as they are.
+     */
+    void remove_tiles_cache();
+
+    /**
+     * @brief Returns how many times a source tile was found in the tile cache
+     * since the last call to set_tiles_cache.
+     */
+    [[nodiscard]] int tiles_cache_hits() const;
+
+    /**
+     * @brief Returns how many times a source tile was not found in the tile cache and had to be uploaded to VRAM
+     * since the last call to set_tiles_cache.
+     */
+    [[nodiscard]] int tiles_cache_misses() const;
+
     /**
      * @brief Returns the allocated memory in VRAM
      * if this regular_bg_map_cell was created with allocate or allocate_optional; bn::nullopt otherwise.
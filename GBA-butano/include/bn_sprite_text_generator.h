@@ -490,6 +490,30 @@ public:
     [[nodiscard]] bool generate_top_left_optional(const fixed_point& top_left_position, const string_view& text,
                                                   ivector<sprite_ptr>& output_sprites) const;
 
+    /**
+     * @brief Repaints only the characters that differ between two texts in the given text sprites.
+     *
+     * It is useful to update text that changes a few characters at a time, like a score counter.
+     *
+     * Only fixed width fonts printed with multiple characters per sprite are supported,
+     * and both texts must have the same number of characters and no tabs.
+     *
+     * @param old_text Single line of text printed in the given text sprites.
+     * @param new_text Single line of text to print.
+     * @param text_sprites Text sprites generated by this sprite_text_generator for old_text.
+     * @return `true` if the given text sprites have been updated, otherwise `false`
+     * (in this case the given text sprites are not modified and new_text must be generated again).
+     */
+    [[nodiscard]] bool update(const string_view& old_text, const string_view& new_text,
+                              ivector<sprite_ptr>& text_sprites) const;
+
+    /**
+     * @brief Releases the sprite tiles kept by the generated text cache.
+     *
+     * See @ref BN_CFG_SPRITE_TEXT_CACHE_MAX_ENTRIES.
+     */
+    static void clear_cache();
+
 private:
     sprite_font _font;
     sprite_palette_item _palette_item;
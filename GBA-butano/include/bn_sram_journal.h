@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SRAM_JOURNAL_H
+#define BN_SRAM_JOURNAL_H
+
+/**
+ * @file
+ * bn::isram_journal and bn::sram_journal header file.
+ *
+ * @ingroup sram
+ */
+
+#include "bn_type_traits.h"
+#include "bn_sram.h"
+#include "bn_config_sram.h"
+
+namespace bn
+{
+
+/**
+ * @brief Base class of bn::sram_journal.
+ *
+ * @ingroup sram
+ */
+class isram_journal
+{
+
+public:
+    isram_journal(const isram_journal& other) = delete;
+
+    isram_journal& operator=(const isram_journal& other) = delete;
+
+    /**
+     * @brief Returns the SRAM offset in bytes of the region used by this journal.
+     */
+    [[nodiscard]] int offset() const
+    {
+        return _offset;
+    }
+
+    /**
+     * @brief Returns the size in bytes of the SRAM region used by this journal.
+     */
+    [[nodiscard]] int size() const
+    {
+        return _size;
+    }
+
+    /**
+     * @brief Returns the size in bytes of the stored data.
+     */
+    [[nodiscard]] int image_size() const
+    {
+        return _image_size;
+    }
+
+    /**
+     * @brief Indicates if the journal has been read from SRAM or not.
+     */
+    [[nodiscard]] bool loaded() const
+    {
+        return _loaded;
+    }
+
+    /**
+     * @brief Returns the number of bytes written into SRAM by the last write call.
+     */
+    [[nodiscard]] int last_write_bytes() const
+    {
+        return _last_write_bytes;
+    }
+
+    /**
+     * @brief Returns the number of CPU ticks (cycles) spent by the last write call.
+     *
+     * It can be used to schedule autosaves in frames with enough spare CPU time.
+     */
+    [[nodiscard]] int last_write_ticks() const
+    {
+        return _last_write_ticks;
+    }
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    isram_journal(uint8_t* image, int image_size, int offset, int size);
+
+    [[nodiscard]] bool _read(void* destination);
+
+    [[nodiscard]] int _changed_blocks_count(const void* source) const;
+
+    void _write(const void* source);
+
+    /// @endcond
+
+private:
+    uint8_t* _image;
+    int _image_size;
+    int _offset;
+    int _size;
+    int _half_index = 0;
+    int _position = -1;
+    unsigned _generation = 0;
+    unsigned _next_generation = 1;
+    int _last_write_bytes = 0;
+    int _last_write_ticks = 0;
+    bool _loaded = false;
+
+    [[nodiscard]] int _blocks_count() const
+    {
+        return (_image_size + BN_CFG_SRAM_JOURNAL_BLOCK_SIZE - 1) / BN_CFG_SRAM_JOURNAL_BLOCK_SIZE;
+    }
+
+    [[nodiscard]] int _block_size(int block_index) const;
+
+    [[nodiscard]] int _half_offset(int half_index) const
+    {
+        return _offset + (half_index * (_size / 2));
+    }
+
+    [[nodiscard]] int _replay(int half_index, unsigned generation, int apply_end_position, int& end_position);
+
+    [[nodiscard]] int _write_block(int block_index, int position);
+
+    void _write_commit(int position);
+
+    void _write_snapshot();
+};
+
+
+/**
+ * @brief Stores a trivially copyable value in a SRAM region with an append-only journal.
+ *
+ * The SRAM region is split in two halves. Each write call appends only the blocks that changed since the last one
+ * to the active half, followed by a commit record.
+ * When the active half is full, a full snapshot is written into the other half.
+ *
+ * Every record has a checksum, and records without a following commit record are discarded when reading,
+ * so a write interrupted by a crash or by turning off the console doesn't corrupt previously committed data.
+ *
+ * The last written value is kept in RAM to know which blocks have changed.
+ *
+ * @tparam Type Type of the stored value. It must be trivially copyable.
+ *
+ * @ingroup sram
+ */
+template<typename Type>
+class sram_journal : public isram_journal
+{
+    static_assert(is_trivially_copyable<Type>(), "Type is not trivially copyable");
+
+public:
+    /**
+     * @brief Constructor.
+     * @param offset SRAM offset in bytes of the region used by this journal.
+     * @param size Size in bytes of the SRAM region used by this journal.
+     *
+     * Each half of the region must be big enough to store an uncompressed snapshot, even if compression is enabled.
+     */
+    sram_journal(int offset, int size) :
+        isram_journal(_image_buffer, int(sizeof(Type)), offset, size)
+    {
+    }
+
+    /**
+     * @brief Reads the last committed value from SRAM.
+     *
+     * It must be called before the first write.
+     *
+     * @param destination Last committed value is copied into this value.
+     * @return `true` if a committed value was found, otherwise `false` and destination is not modified.
+     */
+    [[nodiscard]] bool read(Type& destination)
+    {
+        return _read(&destination);
+    }
+
+    /**
+     * @brief Returns the number of blocks that would be written by a write call with the given value,
+     * without taking a possible snapshot into account.
+     */
+    [[nodiscard]] int changed_blocks_count(const Type& source) const
+    {
+        return _changed_blocks_count(&source);
+    }
+
+    /**
+     * @brief Writes the changed blocks of the given value into SRAM and commits them.
+     * @param source Value to write.
+     */
+    void write(const Type& source)
+    {
+        _write(&source);
+    }
+
+private:
+    alignas(Type) uint8_t _image_buffer[sizeof(Type)];
+};
+
+}
+
+#endif
@@ -1141,30 +1141,23 @@ public:
         size_type erased_count = 0;
         pointer storage = _storage;
         bool* allocated = _allocated;
-        size_type first_valid_index = max_size();
-        size_type last_valid_index = 0;
+        size_type index = _first_valid_index;
 
-        for(size_type index = _first_valid_index, last = _last_valid_index; index <= last; ++index)
+        // Erasing an element reinserts the next ones of its probe sequence,
+        // so the same index is checked again after erasing:
+        while(index <= _last_valid_index)
         {
-            if(allocated[index])
+            if(allocated[index] && pred(storage[index]))
             {
-                if(allocated[index] && pred(storage[index]))
-                {
-                    storage[index].~value_type();
-                    allocated[index] = false;
-                    ++erased_count;
-                }
-                else
-                {
-                    first_valid_index = min(index, first_valid_index);
-                    last_valid_index = max(index, last_valid_index);
-                }
+                erase(iterator(index, *this));
+                ++erased_count;
+            }
+            else
+            {
+                ++index;
             }
         }
 
-        _size -= erased_count;
-        _first_valid_index = first_valid_index;
-        _last_valid_index = last_valid_index;
         return erased_count;
     }
 
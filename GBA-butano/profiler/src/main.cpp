@@ -4,13 +4,30 @@
  */
 
 #include <coroutine>
+#include "bn_log.h"
 #include "bn_core.h"
+#include "bn_list.h"
+#include "bn_pool.h"
+#include "bn_deque.h"
 #include "bn_limits.h"
+#include "bn_memory.h"
 #include "bn_random.h"
+#include "bn_vector.h"
 #include "bn_profiler.h"
+#include "bn_async_loader.h"
 #include "bn_unique_ptr.h"
+#include "bn_sprite_ptr.h"
 #include "bn_seed_random.h"
+#include "bn_sram_journal.h"
+#include "bn_unordered_map.h"
+#include "bn_dense_unordered_map.h"
 #include "bn_best_fit_allocator.h"
+#include "bn_sprite_tiles_ptr.h"
+#include "bn_sprite_affine_mat_ptr.h"
+#include "bn_sprite_shape_size.h"
+#include "bn_sprite_palette_ptr.h"
+#include "bn_sprite_palette_item.h"
+#include "bn_sprite_text_generator.h"
 
 #include "bn_hw_dma.h"
 #include "bn_hw_memory.h"
@@ -20,6 +37,8 @@
 #include "bn_regular_bg_items_butano_huge_huff.h"
 #include "bn_regular_bg_items_butano_huge_lz77.h"
 
+#include "common_fixed_8x16_sprite_font.h"
+
 namespace
 {
 
@@ -60,6 +79,47 @@ void div_test(int& integer)
     }
 }
 
+void fixed_div_test(int& integer)
+{
+    bn::fixed div_result = 0;
+    BN_PROFILER_START("fixed_div_regular");
+
+    for(int i = 0; i < its; ++i)
+    {
+        div_result += bn::fixed(i % 256).division(bn::fixed::from_data(i + 1));
+    }
+
+    BN_PROFILER_STOP();
+
+    integer += div_result.data();
+
+    bn::fixed safe_div_result = 0;
+    BN_PROFILER_START("fixed_div_safe");
+
+    for(int i = 0; i < its; ++i)
+    {
+        safe_div_result += bn::fixed(i % 256).safe_division(bn::fixed::from_data(i + 1));
+    }
+
+    BN_PROFILER_STOP();
+
+    integer += safe_div_result.data();
+
+    bn::fixed safe_div_64_result = 0;
+    BN_PROFILER_START("fixed_div_safe_64");
+
+    for(int i = 0; i < its; ++i)
+    {
+        int64_t dividend = int64_t(bn::fixed(i % 256).data()) * bn::fixed::scale();
+        safe_div_64_result += bn::fixed::from_data(int(dividend / (i + 1)));
+    }
+
+    BN_PROFILER_STOP();
+
+    BN_ASSERT(safe_div_result == safe_div_64_result, "Invalid fixed division");
+    integer += safe_div_64_result.data();
+}
+
 void sqrt_test(int& integer)
 {
     int sqrt_result = 0;
@@ -452,10 +512,689 @@ void coroutine_test(int& integer)
     integer += agbabi_iwram_result;
 }
 
+void async_loader_test(int& integer)
+{
+    constexpr int steps = 64;
+
+    class guard_type
+    {
+
+    public:
+        explicit guard_type(bool& destroyed) :
+            _destroyed(destroyed)
+        {
+        }
+
+        ~guard_type()
+        {
+            _destroyed = true;
+        }
+
+    private:
+        bool& _destroyed;
+    };
+
+    bn::unique_ptr<bn::async_loader> loader_ptr(new bn::async_loader());
+    bn::async_loader& loader = *loader_ptr;
+    int done_steps = 0;
+    int updates = 0;
+    bool finished = false;
+
+    BN_PROFILER_START("async_loader_update");
+
+    loader.start([&done_steps, &finished]()
+    {
+        for(int i = 0; i < steps; ++i)
+        {
+            ++done_steps;
+            bn::async_loader::yield();
+        }
+
+        finished = true;
+    });
+
+    while(loader.running())
+    {
+        // A max CPU usage of 0 resumes the task only once per update:
+        loader.update(0);
+        ++updates;
+    }
+
+    BN_PROFILER_STOP();
+
+    BN_ASSERT(finished, "Async loader task not finished");
+    BN_ASSERT(done_steps == steps, "Invalid async loader steps: ", done_steps);
+    BN_ASSERT(updates == steps + 1, "Invalid async loader updates: ", updates);
+
+    int cancelled_steps = 0;
+    bool cancelled = false;
+    bool destroyed = false;
+
+    loader.start([&cancelled_steps, &cancelled, &destroyed]()
+    {
+        guard_type guard(destroyed);
+
+        for(int i = 0; i < steps; ++i)
+        {
+            if(bn::async_loader::cancelled())
+            {
+                cancelled = true;
+                break;
+            }
+
+            ++cancelled_steps;
+            bn::async_loader::yield();
+        }
+    });
+
+    loader.update(0);
+    loader.update(0);
+
+    BN_ASSERT(loader.running(), "Async loader task not running");
+    BN_ASSERT(cancelled_steps == 2, "Invalid async loader cancelled steps: ", cancelled_steps);
+
+    BN_PROFILER_START("async_loader_cancel");
+
+    loader.cancel();
+
+    BN_PROFILER_STOP();
+
+    BN_ASSERT(! loader.running(), "Async loader task not cancelled");
+    BN_ASSERT(cancelled, "Async loader task did not see the cancellation");
+    BN_ASSERT(destroyed, "Async loader task stack not destroyed");
+    BN_ASSERT(cancelled_steps == 2, "Invalid async loader cancelled steps: ", cancelled_steps);
+
+    integer += done_steps;
+    integer += cancelled_steps;
+}
+
+constexpr int containers_size = 512;
+
+void vector_test(int& integer)
+{
+    using vector_type = bn::vector<int, containers_size>;
+    bn::unique_ptr<vector_type> vector_ptr(new vector_type());
+    vector_type& vector = *vector_ptr;
+    bn::random random;
+
+    BN_PROFILER_START("vector_push_back");
+
+    for(int i = 0; i < its; ++i)
+    {
+        if(vector.full())
+        {
+            vector.clear();
+        }
+
+        vector.push_back(i);
+    }
+
+    BN_PROFILER_STOP();
+
+    vector.clear();
+
+    BN_PROFILER_START("vector_insert_erase");
+
+    for(int i = 0; i < its; ++i)
+    {
+        if(vector.full() || (! vector.empty() && random.get_bool()))
+        {
+            vector.erase(vector.begin() + random.get_int(vector.size()));
+        }
+        else
+        {
+            vector.insert(vector.begin() + random.get_int(vector.size() + 1), i);
+        }
+    }
+
+    BN_PROFILER_STOP();
+
+    BN_PROFILER_START("vector_iterate");
+
+    for(int i = 0; i < its_sqrt; ++i)
+    {
+        for(int value : vector)
+        {
+            integer += value;
+        }
+    }
+
+    BN_PROFILER_STOP();
+}
+
+void deque_test(int& integer)
+{
+    using deque_type = bn::deque<int, containers_size>;
+    bn::unique_ptr<deque_type> deque_ptr(new deque_type());
+    deque_type& deque = *deque_ptr;
+    bn::random random;
+
+    BN_PROFILER_START("deque_push_pop");
+
+    for(int i = 0; i < its; ++i)
+    {
+        if(deque.full() || (! deque.empty() && random.get_bool()))
+        {
+            integer += deque.front();
+            deque.pop_front();
+        }
+        else
+        {
+            deque.push_back(i);
+        }
+    }
+
+    BN_PROFILER_STOP();
+
+    BN_PROFILER_START("deque_iterate");
+
+    for(int i = 0; i < its_sqrt; ++i)
+    {
+        for(int value : deque)
+        {
+            integer += value;
+        }
+    }
+
+    BN_PROFILER_STOP();
+}
+
+void list_test(int& integer)
+{
+    using list_type = bn::list<int, containers_size>;
+    bn::unique_ptr<list_type> list_ptr(new list_type());
+    list_type& list = *list_ptr;
+    bn::random random;
+
+    BN_PROFILER_START("list_insert_erase");
+
+    for(int i = 0; i < its; ++i)
+    {
+        auto it = list.begin();
+
+        for(int steps = random.get_int(8); steps > 0 && it != list.end(); --steps)
+        {
+            ++it;
+        }
+
+        if(list.full() || (! list.empty() && it != list.end() && random.get_bool()))
+        {
+            list.erase(it);
+        }
+        else
+        {
+            list.insert(it, i);
+        }
+    }
+
+    BN_PROFILER_STOP();
+
+    BN_PROFILER_START("list_iterate");
+
+    for(int i = 0; i < its_sqrt; ++i)
+    {
+        for(int value : list)
+        {
+            integer += value;
+        }
+    }
+
+    BN_PROFILER_STOP();
+}
+
+void unordered_map_test(int& integer)
+{
+    using unordered_map_type = bn::unordered_map<int, int, containers_size * 2>;
+    bn::unique_ptr<unordered_map_type> unordered_map_ptr(new unordered_map_type());
+    unordered_map_type& unordered_map = *unordered_map_ptr;
+    bn::random random;
+    constexpr int keys_count = containers_size * 4;
+
+    BN_PROFILER_START("unordered_map_insert_erase");
+
+    for(int i = 0; i < its; ++i)
+    {
+        int key = random.get_int(keys_count);
+
+        if(unordered_map.size() >= containers_size)
+        {
+            unordered_map.erase(key);
+        }
+        else
+        {
+            unordered_map.insert_or_assign(key, i);
+        }
+    }
+
+    BN_PROFILER_STOP();
+
+    BN_PROFILER_START("unordered_map_find");
+
+    for(int i = 0; i < its; ++i)
+    {
+        auto it = unordered_map.find(random.get_int(keys_count));
+
+        if(it != unordered_map.end())
+        {
+            integer += it->second;
+        }
+    }
+
+    BN_PROFILER_STOP();
+
+    BN_PROFILER_START("unordered_map_iterate");
+
+    for(int i = 0; i < its_sqrt; ++i)
+    {
+        for(const auto& pair : unordered_map)
+        {
+            integer += pair.second;
+        }
+    }
+
+    BN_PROFILER_STOP();
+}
+
+void dense_unordered_map_test(int& integer)
+{
+    using dense_unordered_map_type = bn::dense_unordered_map<int, int, containers_size>;
+    bn::unique_ptr<dense_unordered_map_type> dense_unordered_map_ptr(new dense_unordered_map_type());
+    dense_unordered_map_type& dense_unordered_map = *dense_unordered_map_ptr;
+    bn::random random;
+    constexpr int keys_count = containers_size * 4;
+
+    BN_PROFILER_START("dense_unordered_map_insert_erase");
+
+    for(int i = 0; i < its; ++i)
+    {
+        int key = random.get_int(keys_count);
+
+        if(dense_unordered_map.size() >= containers_size)
+        {
+            dense_unordered_map.erase(key);
+        }
+        else
+        {
+            dense_unordered_map.insert_or_assign(key, i);
+        }
+    }
+
+    BN_PROFILER_STOP();
+
+    BN_PROFILER_START("dense_unordered_map_find");
+
+    for(int i = 0; i < its; ++i)
+    {
+        auto it = dense_unordered_map.find(random.get_int(keys_count));
+
+        if(it != dense_unordered_map.end())
+        {
+            integer += it->second;
+        }
+    }
+
+    BN_PROFILER_STOP();
+
+    BN_PROFILER_START("dense_unordered_map_iterate");
+
+    for(int i = 0; i < its_sqrt; ++i)
+    {
+        for(const auto& pair : dense_unordered_map)
+        {
+            integer += pair.second;
+        }
+    }
+
+    BN_PROFILER_STOP();
+}
+
+void pool_test(int& integer)
+{
+    using pool_type = bn::pool<int, containers_size>;
+    bn::unique_ptr<pool_type> pool_ptr(new pool_type());
+    bn::unique_ptr<bn::vector<int*, containers_size>> values_ptr(new bn::vector<int*, containers_size>());
+    pool_type& pool = *pool_ptr;
+    bn::vector<int*, containers_size>& values = *values_ptr;
+    bn::random random;
+
+    BN_PROFILER_START("pool_create_destroy");
+
+    for(int i = 0; i < its; ++i)
+    {
+        if(pool.full() || (! pool.empty() && random.get_bool()))
+        {
+            int index = random.get_int(values.size());
+            int* value = values[index];
+            integer += *value;
+            pool.destroy(*value);
+            values[index] = values.back();
+            values.pop_back();
+        }
+        else
+        {
+            values.push_back(&pool.create(i));
+        }
+    }
+
+    BN_PROFILER_STOP();
+
+    for(int* value : values)
+    {
+        pool.destroy(*value);
+    }
+}
+
+[[nodiscard]] int best_fit_allocator_max_alloc_bytes(bn::best_fit_allocator& allocator)
+{
+    int min_bytes = 0;
+    int max_bytes = allocator.available_bytes();
+
+    while(min_bytes < max_bytes)
+    {
+        int bytes = (min_bytes + max_bytes + 1) / 2;
+
+        if(void* ptr = allocator.alloc(bytes))
+        {
+            allocator.free(ptr);
+            min_bytes = bytes;
+        }
+        else
+        {
+            max_bytes = bytes - 1;
+        }
+    }
+
+    return min_bytes;
+}
+
+void best_fit_allocator_test(int& integer)
+{
+    constexpr int buffer_size = 16 * 1024;
+
+    bn::unique_ptr<bn::array<int, buffer_size / 4>> buffer_ptr(new bn::array<int, buffer_size / 4>());
+    bn::unique_ptr<bn::vector<void*, containers_size>> ptrs_ptr(new bn::vector<void*, containers_size>());
+    bn::best_fit_allocator allocator(buffer_ptr->data(), buffer_size);
+    bn::vector<void*, containers_size>& ptrs = *ptrs_ptr;
+    bn::random random;
+
+    BN_PROFILER_START("best_fit_alloc_free");
+
+    for(int i = 0; i < its; ++i)
+    {
+        if(ptrs.full() || (! ptrs.empty() && random.get_bool()))
+        {
+            int index = random.get_int(ptrs.size());
+            allocator.free(ptrs[index]);
+            ptrs[index] = ptrs.back();
+            ptrs.pop_back();
+        }
+        else if(void* ptr = allocator.alloc(random.get_int(4, 128)))
+        {
+            ptrs.push_back(ptr);
+        }
+    }
+
+    BN_PROFILER_STOP();
+
+    int available_bytes = allocator.available_bytes();
+    int max_alloc_bytes = best_fit_allocator_max_alloc_bytes(allocator);
+    BN_LOG("best_fit_allocator - allocations: ", ptrs.size(), " - available bytes: ", available_bytes,
+           " - max alloc bytes: ", max_alloc_bytes);
+    integer += max_alloc_bytes;
+
+    for(void* ptr : ptrs)
+    {
+        allocator.free(ptr);
+    }
+}
+
+
+void sprites_test(int& integer)
+{
+    constexpr int sprites_count = 128;
+    constexpr int spawned_sprites_count = 8;
+    constexpr int frames_count = 300;
+    constexpr bn::color palette_colors[16] = {};
+
+    bn::sprite_palette_ptr palette = bn::sprite_palette_ptr::create(
+                bn::sprite_palette_item(palette_colors, bn::bpp_mode::BPP_4));
+    bn::sprite_tiles_ptr tiles = bn::sprite_tiles_ptr::allocate(4, bn::bpp_mode::BPP_4);
+    bn::sprite_shape_size shape_size(bn::sprite_shape::SQUARE, bn::sprite_size::NORMAL);
+    bn::vector<bn::sprite_ptr, sprites_count> sprites;
+    bn::random random;
+
+    auto create_sprite = [&]()
+    {
+        bn::fixed x = random.get_int(-120, 120);
+        bn::fixed y = random.get_int(-80, 80);
+        bn::sprite_ptr sprite = bn::sprite_ptr::create(x, y, shape_size, tiles, palette);
+        sprite.set_z_order(random.get_int(4));
+        return sprite;
+    };
+
+    for(int index = 0; index < sprites_count; ++index)
+    {
+        sprites.push_back(create_sprite());
+    }
+
+    bn::core::update();
+
+    // Moves a few sprites by one pixel each frame, so sprite handles are rarely rebuilt
+    // and only the moved ones are committed:
+    int move_cpu_ticks = 0;
+
+    for(int frame = 0; frame < frames_count; ++frame)
+    {
+        BN_PROFILER_START("sprites_move");
+
+        for(int index = 0; index < spawned_sprites_count; ++index)
+        {
+            bn::sprite_ptr& sprite = sprites[(frame * spawned_sprites_count) % sprites_count + index];
+            sprite.set_x(sprite.x() + ((frame / 16) % 2 ? 1 : -1));
+        }
+
+        BN_PROFILER_STOP();
+
+        bn::core::update();
+        move_cpu_ticks += bn::core::last_cpu_ticks();
+    }
+
+    BN_LOG("sprites_move - CPU ticks: ", move_cpu_ticks);
+    integer += move_cpu_ticks;
+
+    // Moves all sprites, replaces some of them and changes the z order of another one each frame.
+    // Engine update and commit times are logged in eng_sprites_update and eng_sprites_commit entries:
+    int churn_cpu_ticks = 0;
+
+    for(int frame = 0; frame < frames_count; ++frame)
+    {
+        BN_PROFILER_START("sprites_churn");
+
+        for(bn::sprite_ptr& sprite : sprites)
+        {
+            bn::fixed y = sprite.y() - 1;
+            sprite.set_y(y < -80 ? y + 160 : y);
+        }
+
+        for(int index = 0; index < spawned_sprites_count; ++index)
+        {
+            sprites[random.get_int(sprites_count)] = create_sprite();
+        }
+
+        sprites[random.get_int(sprites_count)].set_z_order(random.get_int(4));
+
+        BN_PROFILER_STOP();
+
+        bn::core::update();
+        churn_cpu_ticks += bn::core::last_cpu_ticks();
+    }
+
+    BN_LOG("sprites_churn - CPU ticks: ", churn_cpu_ticks);
+    integer += churn_cpu_ticks;
+}
+
 
 constexpr int copy_words = bn::regular_bg_items::butano_huge_huff.tiles_item().tiles_ref().size_bytes() / 4;
 constexpr int copy_words_data[copy_words] = {};
 
+void sprite_affine_mats_test(int& integer)
+{
+    constexpr int affine_mats_count = 32;
+    constexpr int groups_count = 4;
+    constexpr int frames_count = 300;
+    constexpr bn::color palette_colors[16] = {};
+
+    bn::sprite_palette_ptr palette = bn::sprite_palette_ptr::create(
+                bn::sprite_palette_item(palette_colors, bn::bpp_mode::BPP_4));
+    bn::sprite_tiles_ptr tiles = bn::sprite_tiles_ptr::allocate(4, bn::bpp_mode::BPP_4);
+    bn::sprite_shape_size shape_size(bn::sprite_shape::SQUARE, bn::sprite_size::NORMAL);
+    bn::vector<bn::sprite_affine_mat_ptr, affine_mats_count> affine_mats;
+    bn::vector<bn::sprite_ptr, affine_mats_count> sprites;
+    bn::random random;
+
+    for(int index = 0; index < affine_mats_count; ++index)
+    {
+        bn::sprite_affine_mat_ptr affine_mat = bn::sprite_affine_mat_ptr::create();
+        bn::sprite_ptr sprite = bn::sprite_ptr::create(random.get_int(-100, 100), random.get_int(-60, 60), shape_size,
+                                                       tiles, palette);
+        sprite.set_affine_mat(affine_mat);
+        affine_mats.push_back(bn::move(affine_mat));
+        sprites.push_back(bn::move(sprite));
+    }
+
+    // Rotates and scales all affine mats in a few groups with the same attributes each frame.
+    // Engine update time is logged in the eng_sprites_update entry:
+    for(int frame = 0; frame < frames_count; ++frame)
+    {
+        BN_PROFILER_START("affine_mats_rotate");
+
+        for(int index = 0; index < affine_mats_count; ++index)
+        {
+            int group = index / (affine_mats_count / groups_count);
+            bn::sprite_affine_mat_ptr& affine_mat = affine_mats[index];
+            affine_mat.set_rotation_angle((frame * (group + 1)) % 360);
+            affine_mat.set_scale(bn::fixed(1) + (bn::fixed((frame + group) % 32) / 32));
+        }
+
+        BN_PROFILER_STOP();
+
+        bn::core::update();
+        integer += bn::core::last_cpu_ticks();
+    }
+}
+
+void sprite_text_test(int& integer)
+{
+    constexpr int frames_count = 300;
+    constexpr int cached_texts_count = 4;
+
+    bn::sprite_text_generator text_generator(common::fixed_8x16_sprite_font);
+    bn::vector<bn::sprite_ptr, 8> text_sprites;
+    bn::string<16> text;
+
+    // Generates a score counter text from scratch each frame:
+    for(int frame = 0; frame < frames_count; ++frame)
+    {
+        text = bn::to_string<16>(100000 + (frame * 7));
+
+        BN_PROFILER_START("text_generate");
+
+        text_sprites.clear();
+        text_generator.generate(0, 0, text, text_sprites);
+
+        BN_PROFILER_STOP();
+
+        bn::core::update();
+        integer += text_sprites.size();
+    }
+
+    // Repaints only the characters of the score counter that have changed each frame:
+    for(int frame = 0; frame < frames_count; ++frame)
+    {
+        bn::string<16> old_text = text;
+        text = bn::to_string<16>(100000 + (frame * 7));
+
+        BN_PROFILER_START("text_update");
+
+        if(! text_generator.update(old_text, text, text_sprites))
+        {
+            text_sprites.clear();
+            text_generator.generate(0, 0, text, text_sprites);
+        }
+
+        BN_PROFILER_STOP();
+
+        bn::core::update();
+        integer += text_sprites.size();
+    }
+
+    // Generates a few texts repeatedly, so they can be reused from the generated text cache:
+    for(int frame = 0; frame < frames_count; ++frame)
+    {
+        text = bn::to_string<16>(100000 + (frame % cached_texts_count));
+
+        BN_PROFILER_START("text_cached");
+
+        text_sprites.clear();
+        text_generator.generate(0, 0, text, text_sprites);
+
+        BN_PROFILER_STOP();
+
+        bn::core::update();
+        integer += text_sprites.size();
+    }
+
+    text_sprites.clear();
+    bn::sprite_text_generator::clear_cache();
+}
+
+void sram_test(int& integer)
+{
+    class save_data
+    {
+
+    public:
+        int values[256];
+    };
+
+    constexpr int saves = 16;
+
+    bn::unique_ptr<save_data> data_ptr(new save_data());
+    save_data& data = *data_ptr;
+    bn::memory::clear(1, data);
+
+    BN_PROFILER_START("sram_write");
+
+    for(int i = 0; i < saves; ++i)
+    {
+        data.values[(i * 37) % 256] += i;
+        bn::sram::write(data);
+    }
+
+    BN_PROFILER_STOP();
+
+    bn::unique_ptr<bn::sram_journal<save_data>> journal_ptr(new bn::sram_journal<save_data>(0, bn::sram::size()));
+    bn::sram_journal<save_data>& journal = *journal_ptr;
+
+    if(! journal.read(data))
+    {
+        bn::memory::clear(1, data);
+    }
+
+    journal.write(data);
+    BN_PROFILER_START("sram_journal_write");
+
+    for(int i = 0; i < saves; ++i)
+    {
+        data.values[(i * 37) % 256] += i;
+        journal.write(data);
+    }
+
+    BN_PROFILER_STOP();
+
+    integer += journal.last_write_bytes();
+}
+
 void copy_words_test()
 {
     bn::unique_ptr<bn::array<int, copy_words>> buffer_ptr(new bn::array<int, copy_words>());
@@ -551,11 +1290,20 @@ void huff_decomp_test()
     bn::unique_ptr<bn::array<uint8_t, 64 * 1024>> buffer_ptr(new bn::array<uint8_t, 64 * 1024>());
     uint8_t* buffer = buffer_ptr->data();
 
-    BN_PROFILER_START("huff");
+    BN_PROFILER_START("huff_regular");
 
     bn::hw::decompress::huff(tiles, buffer);
 
     BN_PROFILER_STOP();
+
+    if(check_bios)
+    {
+        BN_PROFILER_START("huff_bios");
+
+        HuffUnComp(tiles, buffer);
+
+        BN_PROFILER_STOP();
+    }
 }
 
 }
@@ -566,11 +1314,24 @@ int main()
 
     int integer = 123456789;
     div_test(integer);
+    fixed_div_test(integer);
     sqrt_test(integer);
     random_test(integer);
     lut_sin_test(integer);
     atan2_test(integer);
     coroutine_test(integer);
+    async_loader_test(integer);
+    vector_test(integer);
+    deque_test(integer);
+    list_test(integer);
+    unordered_map_test(integer);
+    dense_unordered_map_test(integer);
+    pool_test(integer);
+    best_fit_allocator_test(integer);
+    sprites_test(integer);
+    sprite_affine_mats_test(integer);
+    sprite_text_test(integer);
+    sram_test(integer);
     copy_words_test();
     rl_decomp_test();
     lz77_decomp_test();
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_async_loader.h"
+
+#include "bn_core.h"
+#include "../hw/include/bn_hw_coroutine.h"
+
+namespace bn
+{
+
+namespace
+{
+    class static_data
+    {
+
+    public:
+        async_loader* running_loader = nullptr;
+    };
+
+    BN_DATA_EWRAM static_data data;
+}
+
+void async_loader::update(fixed max_cpu_usage)
+{
+    BN_BASIC_ASSERT(! data.running_loader, "Async loaders can't be updated from a task");
+
+    while(_task_function)
+    {
+        _resume();
+
+        if(_task_function && core::current_cpu_usage() >= max_cpu_usage)
+        {
+            break;
+        }
+    }
+}
+
+void async_loader::cancel()
+{
+    BN_BASIC_ASSERT(! data.running_loader, "Async loaders can't be cancelled from a task");
+
+    _cancelled = true;
+
+    while(_task_function)
+    {
+        _resume();
+    }
+
+    _cancelled = false;
+}
+
+void async_loader::yield()
+{
+    async_loader* running_loader = data.running_loader;
+    BN_BASIC_ASSERT(running_loader, "There's no running task");
+
+    if(! running_loader->_cancelled)
+    {
+        hw::coroutine::yield(running_loader->_handle, 0);
+    }
+}
+
+bool async_loader::cancelled()
+{
+    async_loader* running_loader = data.running_loader;
+    BN_BASIC_ASSERT(running_loader, "There's no running task");
+
+    return running_loader->_cancelled;
+}
+
+void async_loader::_start(void* task_ptr, task_function_type task_function)
+{
+    _task_ptr = task_ptr;
+    _task_function = task_function;
+
+    hw::coroutine::make(_handle, task_ptr, [](__agbabi_coro_t*)
+    {
+        _run_task();
+        return 0;
+    });
+}
+
+void async_loader::_resume()
+{
+    data.running_loader = this;
+    [[maybe_unused]] int result = hw::coroutine::resume(_handle);
+    data.running_loader = nullptr;
+
+    if(hw::coroutine::joined(_handle))
+    {
+        _task_ptr = nullptr;
+        _task_function = nullptr;
+    }
+}
+
+void async_loader::_run_task()
+{
+    async_loader* running_loader = data.running_loader;
+    running_loader->_task_function(running_loader->_task_ptr);
+}
+
+}
@@ -25,6 +25,16 @@ void set_mixing_rate(audio_mixing_rate mixing_rate)
     audio_manager::set_mixing_rate(mixing_rate);
 }
 
+int dropped_commands_count()
+{
+    return audio_manager::dropped_commands_count();
+}
+
+int coalesced_commands_count()
+{
+    return audio_manager::coalesced_commands_count();
+}
+
 bool update_on_vblank()
 {
     return audio_manager::update_on_vblank();
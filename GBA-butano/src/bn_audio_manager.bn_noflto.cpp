@@ -310,6 +310,26 @@ namespace
         {
         }
 
+        [[nodiscard]] int id() const
+        {
+            return _id;
+        }
+
+        [[nodiscard]] int priority() const
+        {
+            return _priority;
+        }
+
+        void set_priority(int priority)
+        {
+            _priority = int16_t(priority);
+        }
+
+        [[nodiscard]] uint16_t handle() const
+        {
+            return _handle;
+        }
+
         void execute() const
         {
             if(sound_data_type* data = sound_data(_handle))
@@ -418,6 +438,16 @@ namespace
         {
         }
 
+        [[nodiscard]] fixed current_speed() const
+        {
+            return _current_speed;
+        }
+
+        [[nodiscard]] uint16_t handle() const
+        {
+            return _handle;
+        }
+
         void execute() const
         {
             if(sound_data_type* data = sound_data(_handle))
@@ -446,6 +476,11 @@ namespace
         {
         }
 
+        [[nodiscard]] uint16_t handle() const
+        {
+            return _handle;
+        }
+
         void execute() const
         {
             if(sound_data_type* data = sound_data(_handle))
@@ -541,6 +576,8 @@ namespace
         fixed dmg_music_right_volume;
         fixed sound_master_volume = 1;
         int commands_count = 0;
+        int dropped_commands_count = 0;
+        int coalesced_commands_count = 0;
         int music_item_id = 0;
         int music_position = 0;
         int jingle_item_id = 0;
@@ -566,6 +603,140 @@ namespace
     {
         return *reinterpret_cast<static_data*>(data_buffer);
     }
+
+    int _add_command(command_code code)
+    {
+        static_data& data = data_ref();
+        int commands = data.commands_count;
+        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
+
+        if(commands == max_commands) [[unlikely]]
+        {
+            ++data.dropped_commands_count;
+            return -1;
+        }
+
+        data.command_codes[commands] = code;
+        data.commands_count = commands + 1;
+        return commands;
+    }
+
+    template<class Command, typename... Args>
+    bool _add_command(command_code code, Args... args)
+    {
+        int index = _add_command(code);
+
+        if(index < 0) [[unlikely]]
+        {
+            return false;
+        }
+
+        ::new(static_cast<void*>(data_ref().command_datas + index)) Command(args...);
+        return true;
+    }
+
+    // Returns the index of the last pending command with the given code which has not been queued before
+    // one of the given barrier commands, or -1 if it doesn't exist:
+    [[nodiscard]] int _pending_command_index(command_code code, command_code first_barrier_code,
+                                             command_code second_barrier_code)
+    {
+        static_data& data = data_ref();
+
+        for(int index = data.commands_count - 1; index >= 0; --index)
+        {
+            command_code pending_code = data.command_codes[index];
+
+            if(pending_code == code)
+            {
+                return index;
+            }
+
+            if(pending_code == first_barrier_code || pending_code == second_barrier_code)
+            {
+                break;
+            }
+        }
+
+        return -1;
+    }
+
+    template<class Command>
+    [[nodiscard]] int _pending_sound_command_index(command_code code, uint16_t handle)
+    {
+        static_data& data = data_ref();
+
+        for(int index = data.commands_count - 1; index >= 0; --index)
+        {
+            command_code pending_code = data.command_codes[index];
+
+            if(pending_code == code)
+            {
+                if(reinterpret_cast<const Command&>(data.command_datas[index].data).handle() == handle)
+                {
+                    return index;
+                }
+            }
+            else if(pending_code == SOUND_STOP_ALL)
+            {
+                break;
+            }
+        }
+
+        return -1;
+    }
+
+    #if BN_CFG_AUDIO_MERGE_SOUNDS
+        [[nodiscard]] int _pending_sound_play_index(int item_id)
+        {
+            static_data& data = data_ref();
+
+            for(int index = data.commands_count - 1; index >= 0; --index)
+            {
+                switch(data.command_codes[index])
+                {
+
+                case SOUND_PLAY:
+                    if(reinterpret_cast<const play_sound_command&>(data.command_datas[index].data).id() == item_id)
+                    {
+                        return index;
+                    }
+                    break;
+
+                case SOUND_STOP:
+                case SOUND_RELEASE:
+                case SOUND_SET_SPEED:
+                case SOUND_SET_PANNING:
+                case SOUND_STOP_ALL:
+                    return -1;
+
+                default:
+                    break;
+                }
+            }
+
+            return -1;
+        }
+    #endif
+
+    // Replaces the last pending command with the given code if it has not been queued before
+    // one of the given barrier commands, or queues a new one otherwise:
+    template<class Command, typename... Args>
+    void _set_command(command_code code, command_code first_barrier_code, command_code second_barrier_code,
+                      Args... args)
+    {
+        int index = _pending_command_index(code, first_barrier_code, second_barrier_code);
+
+        if(index >= 0)
+        {
+            static_data& data = data_ref();
+            ::new(static_cast<void*>(data.command_datas + index)) Command(args...);
+            ++data.coalesced_commands_count;
+        }
+        else
+        {
+            _add_command<Command>(code, args...);
+        }
+    }
 }
 
 void init()
@@ -609,12 +780,7 @@ optional<music_item> playing_music_item()
 void play_music(music_item item, fixed volume, bool loop)
 {
     static_data& data = data_ref();
-    int commands = data.commands_count;
-    BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-    data.command_codes[commands] = MUSIC_PLAY;
-    ::new(static_cast<void*>(data.command_datas + commands)) play_music_command(item.id(), loop, volume);
-    data.commands_count = commands + 1;
+    _add_command<play_music_command>(MUSIC_PLAY, item.id(), loop, volume);
 
     data.music_item_id = item.id();
     data.music_position = 0;
@@ -634,11 +800,7 @@ void stop_music()
         data.music_playing = false;
         data.music_paused = false;
 
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = MUSIC_STOP;
-        data.commands_count = commands + 1;
+        _add_command(MUSIC_STOP);
     }
 }
 
@@ -653,11 +815,7 @@ void pause_music()
     BN_BASIC_ASSERT(data.music_playing, "There's no music playing");
     BN_BASIC_ASSERT(! data.music_paused, "Music is already paused");
 
-    int commands = data.commands_count;
-    BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-    data.command_codes[commands] = MUSIC_PAUSE;
-    data.commands_count = commands + 1;
+    _add_command(MUSIC_PAUSE);
 
     data.music_paused = true;
 }
@@ -667,11 +825,7 @@ void resume_music()
     static_data& data = data_ref();
     BN_BASIC_ASSERT(data.music_paused, "Music is not paused");
 
-    int commands = data.commands_count;
-    BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-    data.command_codes[commands] = MUSIC_RESUME;
-    data.commands_count = commands + 1;
+    _add_command(MUSIC_RESUME);
 
     data.music_paused = false;
 }
@@ -693,12 +847,7 @@ void set_music_position(int position)
     {
         data.music_position = position;
 
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = MUSIC_SET_POSITION;
-        ::new(static_cast<void*>(data.command_datas + commands)) set_music_position_command(position);
-        data.commands_count = commands + 1;
+        _set_command<set_music_position_command>(MUSIC_SET_POSITION, MUSIC_PLAY, MUSIC_STOP, position);
     }
 }
 
@@ -719,12 +868,7 @@ void set_music_volume(fixed volume)
     {
         data.music_volume = volume;
 
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = MUSIC_SET_VOLUME;
-        ::new(static_cast<void*>(data.command_datas + commands)) set_music_volume_command(volume);
-        data.commands_count = commands + 1;
+        _set_command<set_music_volume_command>(MUSIC_SET_VOLUME, MUSIC_PLAY, MUSIC_STOP, volume);
     }
 }
 
@@ -745,12 +889,7 @@ void set_music_tempo(fixed tempo)
     {
         data.music_tempo = tempo;
 
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = MUSIC_SET_TEMPO;
-        ::new(static_cast<void*>(data.command_datas + commands)) set_music_tempo_command(tempo);
-        data.commands_count = commands + 1;
+        _set_command<set_music_tempo_command>(MUSIC_SET_TEMPO, MUSIC_PLAY, MUSIC_STOP, tempo);
     }
 }
 
@@ -771,12 +910,7 @@ void set_music_pitch(fixed pitch)
     {
         data.music_pitch = pitch;
 
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = MUSIC_SET_PITCH;
-        ::new(static_cast<void*>(data.command_datas + commands)) set_music_pitch_command(pitch);
-        data.commands_count = commands + 1;
+        _set_command<set_music_pitch_command>(MUSIC_SET_PITCH, MUSIC_PLAY, MUSIC_STOP, pitch);
     }
 }
 
@@ -801,12 +935,7 @@ optional<music_item> playing_jingle_item()
 void play_jingle(music_item item, fixed volume)
 {
     static_data& data = data_ref();
-    int commands = data.commands_count;
-    BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-    data.command_codes[commands] = JINGLE_PLAY;
-    ::new(static_cast<void*>(data.command_datas + commands)) play_jingle_command(item.id(), volume);
-    data.commands_count = commands + 1;
+    _add_command<play_jingle_command>(JINGLE_PLAY, item.id(), volume);
 
     data.jingle_item_id = item.id();
     data.jingle_volume = volume;
@@ -823,11 +952,7 @@ void stop_jingle()
         data.jingle_playing = false;
         data.jingle_paused = false;
 
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = JINGLE_STOP;
-        data.commands_count = commands + 1;
+        _add_command(JINGLE_STOP);
     }
 }
 
@@ -842,11 +967,7 @@ void pause_jingle()
     BN_BASIC_ASSERT(data.jingle_playing, "There's no jingle playing");
     BN_BASIC_ASSERT(! data.jingle_paused, "Jingle is already paused");
 
-    int commands = data.commands_count;
-    BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-    data.command_codes[commands] = JINGLE_PAUSE;
-    data.commands_count = commands + 1;
+    _add_command(JINGLE_PAUSE);
 
     data.jingle_paused = true;
 }
@@ -856,11 +977,7 @@ void resume_jingle()
     static_data& data = data_ref();
     BN_BASIC_ASSERT(data.jingle_paused, "Jingle is not paused");
 
-    int commands = data.commands_count;
-    BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-    data.command_codes[commands] = JINGLE_RESUME;
-    data.commands_count = commands + 1;
+    _add_command(JINGLE_RESUME);
 
     data.jingle_paused = false;
 }
@@ -882,12 +999,7 @@ void set_jingle_volume(fixed volume)
     {
         data.jingle_volume = volume;
 
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = JINGLE_SET_VOLUME;
-        ::new(static_cast<void*>(data.command_datas + commands)) set_jingle_volume_command(volume);
-        data.commands_count = commands + 1;
+        _set_command<set_jingle_volume_command>(JINGLE_SET_VOLUME, JINGLE_PLAY, JINGLE_STOP, volume);
     }
 }
 
@@ -912,13 +1024,7 @@ optional<dmg_music_item> playing_dmg_music_item()
 void play_dmg_music(const dmg_music_item& item, int speed, bool loop)
 {
     static_data& data = data_ref();
-    int commands = data.commands_count;
-    BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-    data.command_codes[commands] = DMG_MUSIC_PLAY;
-    ::new(static_cast<void*>(data.command_datas + commands)) play_dmg_music_command(
-            item.data_ptr(), item.type(), loop, speed);
-    data.commands_count = commands + 1;
+    _add_command<play_dmg_music_command>(DMG_MUSIC_PLAY, item.data_ptr(), item.type(), loop, speed);
 
     data.dmg_music_position = bn::dmg_music_position();
     data.dmg_music_left_volume = 1;
@@ -937,11 +1043,7 @@ void stop_dmg_music()
         data.dmg_music_data = nullptr;
         data.dmg_music_paused = false;
 
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = DMG_MUSIC_STOP;
-        data.commands_count = commands + 1;
+        _add_command(DMG_MUSIC_STOP);
     }
 }
 
@@ -956,11 +1058,7 @@ void pause_dmg_music()
     BN_BASIC_ASSERT(data.dmg_music_data, "There's no DMG music playing");
     BN_BASIC_ASSERT(! data.dmg_music_paused, "DMG music is already paused");
 
-    int commands = data.commands_count;
-    BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-    data.command_codes[commands] = DMG_MUSIC_PAUSE;
-    data.commands_count = commands + 1;
+    _add_command(DMG_MUSIC_PAUSE);
 
     data.dmg_music_paused = true;
 }
@@ -970,11 +1068,7 @@ void resume_dmg_music()
     static_data& data = data_ref();
     BN_BASIC_ASSERT(data.dmg_music_paused, "DMG music is not paused");
 
-    int commands = data.commands_count;
-    BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-    data.command_codes[commands] = DMG_MUSIC_RESUME;
-    data.commands_count = commands + 1;
+    _add_command(DMG_MUSIC_RESUME);
 
     data.dmg_music_paused = false;
 }
@@ -996,13 +1090,8 @@ void set_dmg_music_position(const bn::dmg_music_position& position)
     {
         data.dmg_music_position = position;
 
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = DMG_MUSIC_SET_POSITION;
-        ::new(static_cast<void*>(data.command_datas + commands)) set_dmg_music_position_command(
-                position.pattern(), position.row());
-        data.commands_count = commands + 1;
+        _set_command<set_dmg_music_position_command>(DMG_MUSIC_SET_POSITION, DMG_MUSIC_PLAY, DMG_MUSIC_STOP,
+                                                     position.pattern(), position.row());
     }
 }
 
@@ -1042,12 +1131,8 @@ void set_dmg_music_volume(fixed left_volume, fixed right_volume)
         data.dmg_music_left_volume = left_volume;
         data.dmg_music_right_volume = right_volume;
 
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = DMG_MUSIC_SET_VOLUME;
-        ::new(static_cast<void*>(data.command_datas + commands)) set_dmg_music_volume_command(left_volume, right_volume);
-        data.commands_count = commands + 1;
+        _set_command<set_dmg_music_volume_command>(DMG_MUSIC_SET_VOLUME, DMG_MUSIC_PLAY, DMG_MUSIC_STOP,
+                                                   left_volume, right_volume);
     }
 }
 
@@ -1064,12 +1149,8 @@ void set_dmg_music_master_volume(bn::dmg_music_master_volume volume)
     {
         data.dmg_music_master_volume = volume;
 
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = DMG_MUSIC_SET_MASTER_VOLUME;
-        ::new(static_cast<void*>(data.command_datas + commands)) set_dmg_music_master_volume_command(volume);
-        data.commands_count = commands + 1;
+        _set_command<set_dmg_music_master_volume_command>(DMG_MUSIC_SET_MASTER_VOLUME, DMG_MUSIC_PLAY,
+                                                          DMG_MUSIC_STOP, volume);
     }
 }
 
@@ -1089,17 +1170,29 @@ sound_data_type* sound_data(uint16_t handle)
 uint16_t play_sound(int priority, bn::sound_item item)
 {
     static_data& data = data_ref();
-    int commands = data.commands_count;
-    BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
+
+    #if BN_CFG_AUDIO_MERGE_SOUNDS
+        int pending_index = _pending_sound_play_index(item.id());
+
+        if(pending_index >= 0)
+        {
+            auto& pending_command = reinterpret_cast<play_sound_command&>(data.command_datas[pending_index].data);
+            pending_command.set_priority(max(pending_command.priority(), priority));
+            ++data.coalesced_commands_count;
+            return pending_command.handle();
+        }
+    #endif
+
     BN_BASIC_ASSERT(! data.sound_map.full(), "No more sound handles available");
 
     uint16_t handle = data.new_sound_handle;
     data.sound_map[handle].init(item, 1, 0);
     data.new_sound_handle = handle + 1;
 
-    data.command_codes[commands] = SOUND_PLAY;
-    ::new(static_cast<void*>(data.command_datas + commands)) play_sound_command(priority, item.id(), handle);
-    data.commands_count = commands + 1;
+    if(! _add_command<play_sound_command>(SOUND_PLAY, priority, item.id(), handle)) [[unlikely]]
+    {
+        data.sound_map.erase(handle);
+    }
 
     return handle;
 }
@@ -1107,18 +1200,19 @@ uint16_t play_sound(int priority, bn::sound_item item)
 uint16_t play_sound(int priority, bn::sound_item item, fixed volume, fixed speed, fixed panning)
 {
     static_data& data = data_ref();
-    int commands = data.commands_count;
-    BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
     BN_BASIC_ASSERT(! data.sound_map.full(), "No more sound handles available");
 
     uint16_t handle = data.new_sound_handle;
     data.sound_map[handle].init(item, speed, panning);
     data.new_sound_handle = handle + 1;
 
-    data.command_codes[commands] = SOUND_PLAY_EX;
-    ::new(static_cast<void*>(data.command_datas + commands)) play_sound_ex_command(
-            priority, item.id(), handle, volume, speed, panning);
-    data.commands_count = commands + 1;
+    bool added = _add_command<play_sound_ex_command>(SOUND_PLAY_EX, priority, item.id(), handle, volume, speed,
+                                                     panning);
+
+    if(! added) [[unlikely]]
+    {
+        data.sound_map.erase(handle);
+    }
 
     return handle;
 }
@@ -1127,13 +1221,7 @@ void stop_sound(uint16_t handle)
 {
     if(sound_data(handle))
     {
-        static_data& data = data_ref();
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = SOUND_STOP;
-        ::new(static_cast<void*>(data.command_datas + commands)) stop_sound_command(handle);
-        data.commands_count = commands + 1;
+        _add_command<stop_sound_command>(SOUND_STOP, handle);
     }
 }
 
@@ -1141,13 +1229,7 @@ void release_sound(uint16_t handle)
 {
     if(sound_data(handle))
     {
-        static_data& data = data_ref();
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = SOUND_RELEASE;
-        ::new(static_cast<void*>(data.command_datas + commands)) release_sound_command(handle);
-        data.commands_count = commands + 1;
+        _add_command<release_sound_command>(SOUND_RELEASE, handle);
     }
 }
 
@@ -1179,12 +1261,19 @@ void set_sound_speed(uint16_t handle, fixed speed)
         handle_sound_data->speed = speed;
 
         static_data& data = data_ref();
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
+        int pending_index = _pending_sound_command_index<set_sound_speed_command>(SOUND_SET_SPEED, handle);
 
-        data.command_codes[commands] = SOUND_SET_SPEED;
-        ::new(static_cast<void*>(data.command_datas + commands)) set_sound_speed_command(handle, handle_speed, speed);
-        data.commands_count = commands + 1;
+        if(pending_index >= 0)
+        {
+            auto& pending_command = reinterpret_cast<set_sound_speed_command&>(data.command_datas[pending_index].data);
+            ::new(static_cast<void*>(&pending_command)) set_sound_speed_command(
+                    handle, pending_command.current_speed(), speed);
+            ++data.coalesced_commands_count;
+        }
+        else
+        {
+            _add_command<set_sound_speed_command>(SOUND_SET_SPEED, handle, handle_speed, speed);
+        }
     }
 }
 
@@ -1206,23 +1295,24 @@ void set_sound_panning(uint16_t handle, fixed panning)
         handle_sound_data->panning = panning;
 
         static_data& data = data_ref();
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
+        int pending_index = _pending_sound_command_index<set_sound_panning_command>(SOUND_SET_PANNING, handle);
 
-        data.command_codes[commands] = SOUND_SET_PANNING;
-        ::new(static_cast<void*>(data.command_datas + commands)) set_sound_panning_command(handle, panning);
-        data.commands_count = commands + 1;
+        if(pending_index >= 0)
+        {
+            ::new(static_cast<void*>(data.command_datas + pending_index)) set_sound_panning_command(handle, panning);
+            ++data.coalesced_commands_count;
+        }
+        else
+        {
+            _add_command<set_sound_panning_command>(SOUND_SET_PANNING, handle, panning);
+        }
     }
 }
 
 void stop_all_sounds()
 {
     static_data& data = data_ref();
-    int commands = data.commands_count;
-    BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-    data.command_codes[commands] = SOUND_STOP_ALL;
-    data.commands_count = commands + 1;
+    _add_command(SOUND_STOP_ALL);
 
     data.sound_map.clear();
 }
@@ -1240,12 +1330,7 @@ void set_sound_master_volume(fixed volume)
     {
         data.sound_master_volume = volume;
 
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = SOUND_SET_MASTER_VOLUME;
-        ::new(static_cast<void*>(data.command_datas + commands)) set_sound_master_volume_command(volume);
-        data.commands_count = commands + 1;
+        _set_command<set_sound_master_volume_command>(SOUND_SET_MASTER_VOLUME, SOUND_PLAY, SOUND_PLAY_EX, volume);
     }
 }
 
@@ -1271,15 +1356,20 @@ void set_mixing_rate(audio_mixing_rate mixing_rate)
         BN_BASIC_ASSERT(! data.jingle_playing, "There's a jingle playing");
         BN_BASIC_ASSERT(data.sound_map.empty(), "There are sounds playing");
 
-        int commands = data.commands_count;
-        BN_BASIC_ASSERT(commands < max_commands, "No more audio commands available");
-
-        data.command_codes[commands] = AUDIO_SET_MIXING_RATE;
-        ::new(static_cast<void*>(data.command_datas + commands)) set_audio_mixing_rate(mixing_rate);
-        data.commands_count = commands + 1;
+        _add_command<set_audio_mixing_rate>(AUDIO_SET_MIXING_RATE, mixing_rate);
     }
 }
 
+int dropped_commands_count()
+{
+    return data_ref().dropped_commands_count;
+}
+
+int coalesced_commands_count()
+{
+    return data_ref().coalesced_commands_count;
+}
+
 bool update_on_vblank()
 {
     return data_ref().update_on_vblank;
@@ -157,6 +157,10 @@ namespace bn::audio_manager
 
     void set_mixing_rate(audio_mixing_rate mixing_rate);
 
+    [[nodiscard]] int dropped_commands_count();
+
+    [[nodiscard]] int coalesced_commands_count();
+
     [[nodiscard]] bool update_on_vblank();
 
     void set_update_on_vblank(bool update_on_vblank);
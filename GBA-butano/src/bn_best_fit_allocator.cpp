@@ -34,6 +34,11 @@ namespace
 
         return bytes;
     }
+
+    [[nodiscard]] int _log2(best_fit_allocator::size_type bytes)
+    {
+        return 31 - __builtin_clz(unsigned(bytes));
+    }
 }
 
 best_fit_allocator::~best_fit_allocator() noexcept
@@ -64,6 +69,8 @@ void* best_fit_allocator::alloc(size_type bytes)
         return nullptr;
     }
 
+    _erase_free_item(item);
+
     size_type new_item_size = item->size - bytes;
 
     if(new_item_size > _sizeof_free_item)
@@ -74,7 +81,6 @@ void* best_fit_allocator::alloc(size_type bytes)
         new_item->previous = item;
         new_item->size = new_item_size;
         new_item->used = false;
-        new_item->free_items = item->free_items;
 
         item_type* new_next_item = new_item->next();
 
@@ -83,37 +89,7 @@ void* best_fit_allocator::alloc(size_type bytes)
             new_next_item->previous = new_item;
         }
 
-        if(item_type* previous_free_item = item->free_items.previous)
-        {
-            previous_free_item->free_items.next = new_item;
-        }
-        else
-        {
-            _first_free_item = new_item;
-        }
-
-        if(item_type* next_free_item = item->free_items.next)
-        {
-            next_free_item->free_items.previous = new_item;
-        }
-    }
-    else
-    {
-        item_type* next_free_item = item->free_items.next;
-
-        if(item_type* previous_free_item = item->free_items.previous)
-        {
-            previous_free_item->free_items.next = item->free_items.next;
-        }
-        else
-        {
-            _first_free_item = next_free_item;
-        }
-
-        if(next_free_item)
-        {
-            next_free_item->free_items.previous = item->free_items.previous;
-        }
+        _insert_free_item(new_item);
     }
 
     item->used = true;
@@ -191,19 +167,16 @@ void best_fit_allocator::free(void* ptr)
         _free_check(item);
     #endif
 
-    bool item_linked = false;
     item->used = false;
-    item->free_items.previous = nullptr;
-    item->free_items.next = nullptr;
     _free_bytes_count += item->size;
 
     if(item_type* previous_item = item->previous)
     {
         if(! previous_item->used)
         {
+            _erase_free_item(previous_item);
             previous_item->size += item->size;
             item = previous_item;
-            item_linked = true;
         }
     }
 
@@ -214,32 +187,7 @@ void best_fit_allocator::free(void* ptr)
     {
         if(! next_item->used)
         {
-            item_linked = true;
-
-            if(item_type* previous_free_item = next_item->free_items.previous)
-            {
-                if(previous_free_item == item)
-                {
-                    item->free_items.next = next_item->free_items.next;
-                }
-                else
-                {
-                    previous_free_item->free_items.next = item;
-                    item->free_items.previous = previous_free_item;
-                }
-            }
-
-            if(item_type* next_free_item = next_item->free_items.next)
-            {
-                next_free_item->free_items.previous = item;
-                item->free_items.next = next_free_item;
-            }
-
-            if(next_item == _first_free_item)
-            {
-                _first_free_item = nullptr;
-            }
-
+            _erase_free_item(next_item);
             item->size += next_item->size;
             next_item = item->next();
         }
@@ -250,45 +198,7 @@ void best_fit_allocator::free(void* ptr)
         }
     }
 
-    if(item_type* first_free_item = _first_free_item)
-    {
-        if(! item_linked)
-        {
-            item_type* free_item = first_free_item;
-            item_type* previous_free_item = nullptr;
-
-            while(free_item)
-            {
-                if(free_item < item)
-                {
-                    previous_free_item = free_item;
-                }
-                else
-                {
-                    free_item->free_items.previous = item;
-                    item->free_items.next = free_item;
-                    break;
-                }
-
-                free_item = free_item->free_items.next;
-            }
-
-            if(previous_free_item)
-            {
-                previous_free_item->free_items.next = item;
-                item->free_items.previous = previous_free_item;
-            }
-        }
-
-        if(first_free_item > item)
-        {
-            _first_free_item = item;
-        }
-    }
-    else
-    {
-        _first_free_item = item;
-    }
+    _insert_free_item(item);
 
     #if BN_CFG_BEST_FIT_ALLOCATOR_SANITY_CHECK_ENABLED
         _sanity_check();
@@ -300,6 +210,18 @@ void best_fit_allocator::reset(void* start, size_type bytes)
     BN_ASSERT(bytes >= 0 && bytes % size_type(sizeof(int)) == 0, "Invalid bytes: ", bytes);
     BN_BASIC_ASSERT(empty(), "Allocator is not empty");
 
+    for(int fl = 0; fl < _fl_count; ++fl)
+    {
+        for(int sl = 0; sl < _sl_count; ++sl)
+        {
+            _free_items[fl][sl] = nullptr;
+        }
+
+        _sl_bitmaps[fl] = 0;
+    }
+
+    _fl_bitmap = 0;
+
     if(bytes >= _sizeof_free_item)
     {
         BN_BASIC_ASSERT(start, "Start is null");
@@ -320,18 +242,15 @@ void best_fit_allocator::reset(void* start, size_type bytes)
         first_item->previous = nullptr;
         first_item->size = bytes;
         first_item->used = false;
-        first_item->free_items.previous = nullptr;
-        first_item->free_items.next = nullptr;
 
         _start_ptr = static_cast<uint8_t*>(start);
-        _first_free_item = first_item;
         _total_bytes_count = bytes;
         _free_bytes_count = bytes;
+        _insert_free_item(first_item);
     }
     else
     {
         _start_ptr = nullptr;
-        _first_free_item = nullptr;
         _total_bytes_count = 0;
         _free_bytes_count = 0;
     }
@@ -349,6 +268,8 @@ void best_fit_allocator::log_status() const
 
         const item_type* item = _begin_item();
         const item_type* end_item = _end_item();
+        size_type free_items_count = 0;
+        size_type max_free_item_bytes = 0;
 
         while(item != end_item)
         {
@@ -356,18 +277,105 @@ void best_fit_allocator::log_status() const
                    item->used ? "used" : "free",
                    " - size: ", item->size);
 
+            if(! item->used)
+            {
+                ++free_items_count;
+                max_free_item_bytes = max(max_free_item_bytes, size_type(item->size));
+            }
+
             item = item->next();
         }
 
         BN_LOG(']');
         BN_LOG("free_bytes_count: ", _free_bytes_count);
         BN_LOG("total_bytes_count: ", _total_bytes_count);
+        BN_LOG("free_items_count: ", free_items_count);
+        BN_LOG("max_free_item_bytes: ", max_free_item_bytes);
+
+        if(_free_bytes_count)
+        {
+            BN_LOG("fragmentation: ", 100 - ((max_free_item_bytes * 100) / _free_bytes_count), '%');
+        }
     #endif
 }
 
-best_fit_allocator::item_type* best_fit_allocator::_best_free_item(size_type bytes)
+void best_fit_allocator::_free_items_indexes(size_type bytes, int& fl, int& sl)
+{
+    if(bytes < _small_bytes)
+    {
+        fl = 0;
+        sl = bytes >> _alignment_shift;
+        return;
+    }
+
+    int log2_bytes = _log2(bytes);
+    fl = log2_bytes - (_sl_shift + _alignment_shift) + 1;
+
+    if(fl >= _fl_count)
+    {
+        fl = _fl_count - 1;
+        sl = _sl_count - 1;
+        return;
+    }
+
+    sl = (bytes >> (log2_bytes - _sl_shift)) - _sl_count;
+}
+
+void best_fit_allocator::_insert_free_item(item_type* item)
+{
+    int fl;
+    int sl;
+    _free_items_indexes(item->size, fl, sl);
+
+    item_type* first_free_item = _free_items[fl][sl];
+    item->free_items.previous = nullptr;
+    item->free_items.next = first_free_item;
+
+    if(first_free_item)
+    {
+        first_free_item->free_items.previous = item;
+    }
+
+    _free_items[fl][sl] = item;
+    _fl_bitmap |= 1U << fl;
+    _sl_bitmaps[fl] |= uint8_t(1U << sl);
+}
+
+void best_fit_allocator::_erase_free_item(item_type* item)
+{
+    item_type* previous_free_item = item->free_items.previous;
+    item_type* next_free_item = item->free_items.next;
+
+    if(next_free_item)
+    {
+        next_free_item->free_items.previous = previous_free_item;
+    }
+
+    if(previous_free_item)
+    {
+        previous_free_item->free_items.next = next_free_item;
+    }
+    else
+    {
+        int fl;
+        int sl;
+        _free_items_indexes(item->size, fl, sl);
+        _free_items[fl][sl] = next_free_item;
+
+        if(! next_free_item)
+        {
+            _sl_bitmaps[fl] &= uint8_t(~(1U << sl));
+
+            if(! _sl_bitmaps[fl])
+            {
+                _fl_bitmap &= ~(1U << fl);
+            }
+        }
+    }
+}
+
+best_fit_allocator::item_type* best_fit_allocator::_fitting_free_item(item_type* free_item, size_type bytes)
 {
-    item_type* free_item = _first_free_item;
     item_type* best_free_item = nullptr;
     size_type best_free_item_bytes = numeric_limits<size_type>::max();
 
@@ -375,12 +383,7 @@ best_fit_allocator::item_type* best_fit_allocator::_best_free_item(size_type byt
     {
         size_type free_item_bytes = free_item->size;
 
-        if(free_item_bytes == bytes)
-        {
-            return free_item;
-        }
-
-        if(free_item_bytes > bytes && free_item_bytes < best_free_item_bytes)
+        if(free_item_bytes >= bytes && free_item_bytes < best_free_item_bytes)
         {
             best_free_item = free_item;
             best_free_item_bytes = free_item_bytes;
@@ -392,12 +395,62 @@ best_fit_allocator::item_type* best_fit_allocator::_best_free_item(size_type byt
     return best_free_item;
 }
 
+best_fit_allocator::item_type* best_fit_allocator::_best_free_item(size_type bytes)
+{
+    // Round up to the next size class, so any item of the found list is big enough:
+    size_type search_bytes = bytes;
+
+    if(bytes >= _small_bytes)
+    {
+        search_bytes += (1 << (_log2(bytes) - _sl_shift)) - 1;
+    }
+
+    int fl;
+    int sl;
+    _free_items_indexes(search_bytes, fl, sl);
+
+    if(fl < _fl_count - 1 || sl < _sl_count - 1)
+    {
+        unsigned sl_bitmap = _sl_bitmaps[fl] & (~0U << sl);
+
+        if(! sl_bitmap)
+        {
+            if(unsigned fl_bitmap = _fl_bitmap & (~0U << (fl + 1)))
+            {
+                fl = __builtin_ctz(fl_bitmap);
+                sl_bitmap = _sl_bitmaps[fl];
+            }
+        }
+
+        if(sl_bitmap)
+        {
+            sl = __builtin_ctz(sl_bitmap);
+
+            if(fl < _fl_count - 1 || sl < _sl_count - 1)
+            {
+                return _free_items[fl][sl];
+            }
+        }
+    }
+
+    // The last list holds items of any size above its lower bound.
+    // The list of the requested size class can hold an item big enough too:
+    item_type* best_free_item = _fitting_free_item(_free_items[_fl_count - 1][_sl_count - 1], bytes);
+
+    if(! best_free_item)
+    {
+        _free_items_indexes(bytes, fl, sl);
+        best_free_item = _fitting_free_item(_free_items[fl][sl], bytes);
+    }
+
+    return best_free_item;
+}
+
 #if BN_CFG_BEST_FIT_ALLOCATOR_SANITY_CHECK_ENABLED
     void best_fit_allocator::_sanity_check() const
     {
         const item_type* item = _begin_item();
         const item_type* end_item = _end_item();
-        const item_type* first_free_item = nullptr;
         size_type real_used_bytes = 0;
         size_type num_free_items = 0;
 
@@ -427,32 +480,42 @@ best_fit_allocator::item_type* best_fit_allocator::_best_free_item(size_type byt
             else
             {
                 ++num_free_items;
-
-                if(! first_free_item)
-                {
-                    first_free_item = item;
-                }
             }
 
             item = next_item;
         }
 
-        BN_ASSERT(first_free_item == _first_free_item);
         BN_ASSERT(real_used_bytes == used_bytes(), real_used_bytes, " - ", used_bytes());
 
-        item_type* free_item = _first_free_item;
         size_type num_list_free_items = 0;
 
-        while(free_item)
+        for(int fl = 0; fl < _fl_count; ++fl)
         {
-            ++num_list_free_items;
+            BN_ASSERT(bool(_fl_bitmap & (1U << fl)) == bool(_sl_bitmaps[fl]), fl);
 
-            BN_ASSERT(! free_item->used);
+            for(int sl = 0; sl < _sl_count; ++sl)
+            {
+                const item_type* free_item = _free_items[fl][sl];
+                BN_ASSERT(bool(_sl_bitmaps[fl] & (1U << sl)) == bool(free_item), fl, " - ", sl);
+                BN_ASSERT(! free_item || ! free_item->free_items.previous, fl, " - ", sl);
+
+                while(free_item)
+                {
+                    ++num_list_free_items;
 
-            item_type* next_free_item = free_item->free_items.next;
-            BN_ASSERT(! next_free_item || next_free_item->free_items.previous == free_item);
+                    BN_ASSERT(! free_item->used);
 
-            free_item = next_free_item;
+                    int item_fl;
+                    int item_sl;
+                    _free_items_indexes(free_item->size, item_fl, item_sl);
+                    BN_ASSERT(item_fl == fl && item_sl == sl, free_item);
+
+                    const item_type* next_free_item = free_item->free_items.next;
+                    BN_ASSERT(! next_free_item || next_free_item->free_items.previous == free_item);
+
+                    free_item = next_free_item;
+                }
+            }
         }
 
         BN_ASSERT(num_free_items == num_list_free_items);
@@ -6,6 +6,7 @@
 #include "bn_bg_blocks_manager.h"
 
 #include "bn_limits.h"
+#include "bn_memory.h"
 #include "bn_string_view.h"
 #include "bn_bgs_manager.h"
 #include "bn_config_bg_blocks.h"
@@ -180,11 +181,242 @@ namespace
     };
 
 
+    class tiles_cache_type
+    {
+
+    public:
+        static constexpr uint16_t empty = numeric_limits<uint16_t>::max();
+        static constexpr int canvas_cells = 32 * 32;
+
+        const tile* source_tiles_ptr;
+        tile* vram_tiles_ptr = nullptr;
+        uint16_t* slots_data = nullptr;
+        int source_tiles_count;
+        int tile_units;
+        int slots_count = 0;
+        int slots_data_source_tiles_count = 0;
+        int hits = 0;
+        int misses = 0;
+        uint16_t first_free_slot = empty;
+        uint16_t last_free_slot = empty;
+        uint16_t canvas_slots[canvas_cells];
+
+        tiles_cache_type(const regular_bg_tiles_item& source_tiles_item)
+        {
+            set_source(source_tiles_item);
+        }
+
+        ~tiles_cache_type()
+        {
+            if(slots_data)
+            {
+                memory::ewram_free(slots_data);
+            }
+        }
+
+        void set_source(const regular_bg_tiles_item& source_tiles_item)
+        {
+            const span<const tile>& source_tiles_ref = source_tiles_item.tiles_ref();
+            tile_units = source_tiles_item.bpp() == bpp_mode::BPP_8 ? 2 : 1;
+            source_tiles_ptr = source_tiles_ref.data();
+            source_tiles_count = source_tiles_ref.size() / tile_units;
+            hits = 0;
+            misses = 0;
+        }
+
+        void reset(tile* new_vram_tiles_ptr, int new_slots_count)
+        {
+            if(new_slots_count != slots_count || source_tiles_count != slots_data_source_tiles_count)
+            {
+                if(slots_data)
+                {
+                    memory::ewram_free(slots_data);
+                }
+
+                int slots_data_size = ((new_slots_count * 4) + source_tiles_count) * int(sizeof(uint16_t));
+                slots_data = static_cast<uint16_t*>(memory::ewram_alloc(slots_data_size));
+                BN_BASIC_ASSERT(slots_data, "Tiles cache allocation failed: ", new_slots_count, " - ",
+                                source_tiles_count);
+                slots_count = new_slots_count;
+                slots_data_source_tiles_count = source_tiles_count;
+            }
+
+            vram_tiles_ptr = new_vram_tiles_ptr;
+            hw::memory::set_half_words(empty, source_tiles_count, _source_slots());
+            hw::memory::set_half_words(empty, canvas_cells, canvas_slots);
+
+            uint16_t* sources = _slot_sources();
+            uint16_t* usages = _slot_usages();
+            uint16_t* previous = _previous_free_slots();
+            uint16_t* next = _next_free_slots();
+
+            for(int slot = 0; slot < slots_count; ++slot)
+            {
+                sources[slot] = empty;
+                usages[slot] = 0;
+                previous[slot] = slot ? uint16_t(slot - 1) : empty;
+                next[slot] = slot < slots_count - 1 ? uint16_t(slot + 1) : empty;
+            }
+
+            first_free_slot = 0;
+            last_free_slot = uint16_t(slots_count - 1);
+        }
+
+        void commit_cell(unsigned source_cell, int canvas_index, unsigned offset, uint16_t* vram_cells_ptr)
+        {
+            // Only cache slots must fit in the 10 bits of the tile index.
+            // 8BPP tiles don't use the palette bits, so they extend the source tile index up to 14 bits:
+            unsigned source_tile = source_cell & 1023;
+            unsigned cell_flags = source_cell & ~1023U;
+
+            if(tile_units == 2)
+            {
+                source_tile |= (source_cell >> 2) & 0x3C00;
+                cell_flags &= 0x0C00;
+            }
+
+            // Release the old slot first, so it can be reused when the cache is full:
+            int old_slot = canvas_slots[canvas_index];
+
+            if(old_slot != empty)
+            {
+                _release_slot(old_slot);
+            }
+
+            int slot = _acquire_slot(int(source_tile));
+            canvas_slots[canvas_index] = uint16_t(slot);
+            vram_cells_ptr[canvas_index] = uint16_t(cell_flags + unsigned(slot) + offset);
+        }
+
+    private:
+        [[nodiscard]] uint16_t* _slot_sources()
+        {
+            return slots_data;
+        }
+
+        [[nodiscard]] uint16_t* _slot_usages()
+        {
+            return slots_data + slots_count;
+        }
+
+        [[nodiscard]] uint16_t* _previous_free_slots()
+        {
+            return slots_data + (slots_count * 2);
+        }
+
+        [[nodiscard]] uint16_t* _next_free_slots()
+        {
+            return slots_data + (slots_count * 3);
+        }
+
+        [[nodiscard]] uint16_t* _source_slots()
+        {
+            return slots_data + (slots_count * 4);
+        }
+
+        void _unlink_free_slot(int slot)
+        {
+            uint16_t* previous = _previous_free_slots();
+            uint16_t* next = _next_free_slots();
+            uint16_t previous_slot = previous[slot];
+            uint16_t next_slot = next[slot];
+
+            if(previous_slot == empty)
+            {
+                first_free_slot = next_slot;
+            }
+            else
+            {
+                next[previous_slot] = next_slot;
+            }
+
+            if(next_slot == empty)
+            {
+                last_free_slot = previous_slot;
+            }
+            else
+            {
+                previous[next_slot] = previous_slot;
+            }
+        }
+
+        [[nodiscard]] int _acquire_slot(int source_tile)
+        {
+            BN_BASIC_ASSERT(source_tile < source_tiles_count,
+                            "Invalid source tile: ", source_tile, " - ", source_tiles_count);
+
+            uint16_t* source_slots = _source_slots();
+            uint16_t* usages = _slot_usages();
+            int slot = source_slots[source_tile];
+
+            if(slot != empty)
+            {
+                ++hits;
+
+                if(! usages[slot])
+                {
+                    _unlink_free_slot(slot);
+                }
+            }
+            else
+            {
+                // Reuse the slot released longest ago:
+                ++misses;
+                slot = first_free_slot;
+                BN_BASIC_ASSERT(slot != empty, "Tiles cache is full: ", slots_count);
+                _unlink_free_slot(slot);
+
+                uint16_t* sources = _slot_sources();
+                int old_source_tile = sources[slot];
+
+                if(old_source_tile != empty)
+                {
+                    source_slots[old_source_tile] = empty;
+                }
+
+                sources[slot] = uint16_t(source_tile);
+                source_slots[source_tile] = uint16_t(slot);
+                hw::memory::copy_words(source_tiles_ptr + (source_tile * tile_units),
+                                       tile_units * int(sizeof(tile) / 4), vram_tiles_ptr + (slot * tile_units));
+            }
+
+            ++usages[slot];
+            return slot;
+        }
+
+        void _release_slot(int slot)
+        {
+            uint16_t* usages = _slot_usages();
+            --usages[slot];
+
+            if(! usages[slot])
+            {
+                uint16_t* previous = _previous_free_slots();
+                uint16_t* next = _next_free_slots();
+                previous[slot] = last_free_slot;
+                next[slot] = empty;
+
+                if(last_free_slot == empty)
+                {
+                    first_free_slot = uint16_t(slot);
+                }
+                else
+                {
+                    next[last_free_slot] = uint16_t(slot);
+                }
+
+                last_free_slot = uint16_t(slot);
+            }
+        }
+    };
+
+
     class item_type
     {
 
     public:
         const uint16_t* data = nullptr;
+        tiles_cache_type* tiles_cache = nullptr;
         unsigned usages = 0;
         optional<regular_bg_tiles_ptr> regular_tiles;
         optional<affine_bg_tiles_ptr> affine_tiles;
@@ -1016,6 +1248,22 @@ namespace
         }
     }
 
+    [[nodiscard]] int _commit_bytes(const item_type& item)
+    {
+        if(item.is_tiles)
+        {
+            return item.width * 2;
+        }
+
+        if(item.is_big)
+        {
+            return 0;
+        }
+
+        int cells = item.width * item.height;
+        return item.is_affine ? cells : cells * 2;
+    }
+
     void _fix_blocks_count(const item_type& item, int new_item_blocks_count)
     {
         static_data& data = data_ref();
@@ -1316,6 +1564,29 @@ namespace
     {
         return _fix_map_x(map_y, map_height);
     }
+
+    void _reset_tiles_cache(const item_type& item)
+    {
+        const item_type& tiles_item = data_ref().items.item(item.regular_tiles->handle());
+        BN_BASIC_ASSERT(! tiles_item.data, "Tiles cache tiles must be allocated");
+
+        tiles_cache_type& tiles_cache = *item.tiles_cache;
+        BN_BASIC_ASSERT(tiles_cache.tile_units == (item.palette->bpp() == bpp_mode::BPP_8 ? 2 : 1),
+                        "Tiles cache BPP does not match palette BPP");
+
+        auto vram_tiles_ptr = reinterpret_cast<tile*>(hw::bg_blocks::vram(tiles_item.start_block));
+        tiles_cache.reset(vram_tiles_ptr, tiles_item.tiles_count() / tiles_cache.tile_units);
+    }
+
+    void _remove_tiles_cache(item_type& item)
+    {
+        if(tiles_cache_type* tiles_cache = item.tiles_cache)
+        {
+            tiles_cache->~tiles_cache_type();
+            memory::ewram_free(tiles_cache);
+            item.tiles_cache = nullptr;
+        }
+    }
 }
 
 void init()
@@ -1952,6 +2223,7 @@ void decrease_usages(int id)
     {
         item.set_status(status_type::TO_REMOVE);
         data.to_remove_blocks_count += item.blocks_count;
+        _remove_tiles_cache(item);
 
         item.regular_tiles.reset();
         item.affine_tiles.reset();
@@ -2273,7 +2545,7 @@ void set_regular_map_tiles(int id, regular_bg_tiles_ptr&& tiles)
 
         item.regular_tiles = move(tiles);
 
-        if(item.regular_tiles_offset() != old_tiles_offset)
+        if(item.tiles_cache || item.regular_tiles_offset() != old_tiles_offset)
         {
             item.commit = true;
             data.check_commit = true;
@@ -2447,7 +2719,8 @@ void set_regular_map_tiles_and_palette(int id, regular_bg_tiles_ptr&& tiles, bg_
         item.palette = move(palette);
     }
 
-    if(item.regular_tiles_offset() != old_tiles_offset || item.palette_offset() != old_palette_offset)
+    if(item.tiles_cache || item.regular_tiles_offset() != old_tiles_offset ||
+            item.palette_offset() != old_palette_offset)
     {
         item.commit = true;
         data.check_commit = true;
@@ -2501,6 +2774,57 @@ bool must_commit(int id)
     return data_ref().items.item(id).commit;
 }
 
+void set_regular_map_tiles_cache(int id, const regular_bg_tiles_item& source_tiles_item)
+{
+    static_data& data = data_ref();
+    item_type& item = data.items.item(id);
+    BN_ASSERT(item.is_big, "Map is not big");
+    BN_ASSERT(source_tiles_item.compression() == compression_type::NONE,
+              "Compressed source tiles not supported: ", int(source_tiles_item.compression()));
+    BN_ASSERT(source_tiles_item.bpp() == item.palette->bpp(),
+              "Source tiles BPP does not match palette BPP: ", int(source_tiles_item.bpp()));
+
+    if(tiles_cache_type* tiles_cache = item.tiles_cache)
+    {
+        tiles_cache->set_source(source_tiles_item);
+    }
+    else
+    {
+        void* tiles_cache_data = memory::ewram_alloc(int(sizeof(tiles_cache_type)));
+        BN_BASIC_ASSERT(tiles_cache_data, "Tiles cache allocation failed");
+
+        item.tiles_cache = ::new(tiles_cache_data) tiles_cache_type(source_tiles_item);
+    }
+
+    item.commit = true;
+    data.check_commit = true;
+}
+
+void remove_regular_map_tiles_cache(int id)
+{
+    static_data& data = data_ref();
+    item_type& item = data.items.item(id);
+
+    if(item.tiles_cache)
+    {
+        _remove_tiles_cache(item);
+        item.commit = true;
+        data.check_commit = true;
+    }
+}
+
+int regular_map_tiles_cache_hits(int id)
+{
+    const tiles_cache_type* tiles_cache = data_ref().items.item(id).tiles_cache;
+    return tiles_cache ? tiles_cache->hits : 0;
+}
+
+int regular_map_tiles_cache_misses(int id)
+{
+    const tiles_cache_type* tiles_cache = data_ref().items.item(id).tiles_cache;
+    return tiles_cache ? tiles_cache->misses : 0;
+}
+
 void update_regular_map_col(int id, int x, int y)
 {
     const item_type& item = data_ref().items.item(id);
@@ -2516,6 +2840,28 @@ void update_regular_map_col(int id, int x, int y)
     x = _fix_map_x(x, map_width);
     y = _fix_map_y(y, map_height);
 
+    if(tiles_cache_type* tiles_cache = item.tiles_cache)
+    {
+        uint16_t* vram_data = hw::bg_blocks::vram(item.start_block);
+        unsigned offset = hw::bg_blocks::regular_map_cells_offset(
+                    unsigned(item.regular_tiles_offset()), unsigned(item.palette_offset()));
+
+        for(int row = y, row_limit = y + 31; row <= row_limit; ++row)
+        {
+            int fixed_row = row;
+
+            if(fixed_row >= map_height)
+            {
+                fixed_row -= map_height;
+            }
+
+            tiles_cache->commit_cell(item_data[(fixed_row * map_width) + x], ((fixed_row & 31) * 32) + (x & 31),
+                                     offset, vram_data);
+        }
+
+        return;
+    }
+
     const uint16_t* first_source_data = item_data + ((y * map_width) + x);
     int y_separator = y & 31;
     int second_y = _fix_map_y(y + 32 - y_separator, map_height);
@@ -2715,6 +3061,29 @@ void update_regular_map_row(int id, int x, int y)
     x = _fix_map_x(x, map_width);
     y = _fix_map_y(y, map_height);
 
+    if(tiles_cache_type* tiles_cache = item.tiles_cache)
+    {
+        uint16_t* vram_data = hw::bg_blocks::vram(item.start_block);
+        unsigned offset = hw::bg_blocks::regular_map_cells_offset(
+                    unsigned(item.regular_tiles_offset()), unsigned(item.palette_offset()));
+        const uint16_t* source_data = item_data + (y * map_width);
+
+        for(int column = x, column_limit = x + 31; column <= column_limit; ++column)
+        {
+            int fixed_column = column;
+
+            if(fixed_column >= map_width)
+            {
+                fixed_column -= map_width;
+            }
+
+            tiles_cache->commit_cell(source_data[fixed_column], ((y & 31) * 32) + (fixed_column & 31),
+                                     offset, vram_data);
+        }
+
+        return;
+    }
+
     const uint16_t* first_source_data = item_data + ((y * map_width) + x);
     int x_separator = x & 31;
     int elements = 32 - x_separator;
@@ -2819,7 +3188,38 @@ void set_regular_map_position(int id, int x, int y)
     auto tiles_offset = unsigned(item.regular_tiles_offset());
     auto palette_offset = unsigned(item.palette_offset());
 
-    if(tiles_offset || palette_offset)
+    if(tiles_cache_type* tiles_cache = item.tiles_cache)
+    {
+        _reset_tiles_cache(item);
+
+        unsigned offset = hw::bg_blocks::regular_map_cells_offset(tiles_offset, palette_offset);
+
+        for(int row = y, row_limit = y + 31; row <= row_limit; ++row)
+        {
+            int fixed_row = row;
+
+            if(fixed_row >= map_height)
+            {
+                fixed_row -= map_height;
+            }
+
+            const uint16_t* source_data = item_data + (fixed_row * map_width);
+
+            for(int column = x, column_limit = x + 31; column <= column_limit; ++column)
+            {
+                int fixed_column = column;
+
+                if(fixed_column >= map_width)
+                {
+                    fixed_column -= map_width;
+                }
+
+                tiles_cache->commit_cell(source_data[fixed_column], ((fixed_row & 31) * 32) + (fixed_column & 31),
+                                         offset, vram_data);
+            }
+        }
+    }
+    else if(tiles_offset || palette_offset)
     {
         uint16_t offset = hw::bg_blocks::regular_map_cells_offset(tiles_offset, palette_offset);
 
@@ -3055,15 +3455,30 @@ void commit_compressed()
     {
         BN_BG_BLOCKS_LOG("bg_blocks_manager - COMMIT COMPRESSED");
 
+        constexpr int max_bytes = BN_CFG_BG_BLOCKS_MAX_COMPRESSED_COMMIT_BYTES;
+        int committed_bytes = 0;
+        int pending_items_count = 0;
+
         for(int index = 0; index < commit_items_count; ++index)
         {
             int item_index = data.to_commit_compressed_items_array[index];
             item_type& item = data.items.item(item_index);
-            item.commit = false;
-            _commit_item(item, false);
+            int item_bytes = _commit_bytes(item);
+
+            if(max_bytes && committed_bytes && committed_bytes + item_bytes > max_bytes)
+            {
+                data.to_commit_compressed_items_array[pending_items_count] = uint8_t(item_index);
+                ++pending_items_count;
+            }
+            else
+            {
+                item.commit = false;
+                _commit_item(item, false);
+                committed_bytes += item_bytes;
+            }
         }
 
-        data.to_commit_compressed_items_count = 0;
+        data.to_commit_compressed_items_count = pending_items_count;
 
         BN_BG_BLOCKS_LOG_STATUS();
     }
@@ -166,6 +166,14 @@ namespace bn::bg_blocks_manager
 
     [[nodiscard]] bool must_commit(int id);
 
+    void set_regular_map_tiles_cache(int id, const regular_bg_tiles_item& source_tiles_item);
+
+    void remove_regular_map_tiles_cache(int id);
+
+    [[nodiscard]] int regular_map_tiles_cache_hits(int id);
+
+    [[nodiscard]] int regular_map_tiles_cache_misses(int id);
+
     void update_regular_map_col(int id, int x, int y);
 
     inline void update_regular_map_left_col(int id, int x, int y)
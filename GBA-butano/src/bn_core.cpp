@@ -41,6 +41,13 @@
     #include "bn_assert_callback_type.h"
 #endif
 
+#if BN_CFG_PROFILER_LOG_CPU_TICKS
+    #include "bn_log.h"
+    #include "bn_string.h"
+
+    static_assert(BN_CFG_LOG_ENABLED, "Log is not enabled");
+#endif
+
 #if BN_CFG_ASSERT_ENABLED || BN_CFG_PROFILER_ENABLED
     #include "../hw/include/bn_hw_show.h"
 #endif
@@ -52,29 +59,19 @@
 #endif
 
 #if BN_CFG_PROFILER_ENABLED && BN_CFG_PROFILER_LOG_ENGINE
-    #if BN_CFG_PROFILER_LOG_ENGINE_DETAILED
-        #define BN_PROFILER_ENGINE_GENERAL_START(id) \
-            do \
-            { \
-            } while(false)
+    #define BN_PROFILER_ENGINE_GENERAL_START(id) \
+        BN_PROFILER_START(id)
 
-        #define BN_PROFILER_ENGINE_GENERAL_STOP() \
-            do \
-            { \
-            } while(false)
+    #define BN_PROFILER_ENGINE_GENERAL_STOP() \
+        BN_PROFILER_STOP()
 
+    #if BN_CFG_PROFILER_LOG_ENGINE_DETAILED
         #define BN_PROFILER_ENGINE_DETAILED_START(id) \
             BN_PROFILER_START(id)
 
         #define BN_PROFILER_ENGINE_DETAILED_STOP() \
             BN_PROFILER_STOP()
     #else
-        #define BN_PROFILER_ENGINE_GENERAL_START(id) \
-            BN_PROFILER_START(id)
-
-        #define BN_PROFILER_ENGINE_GENERAL_STOP() \
-            BN_PROFILER_STOP()
-
         #define BN_PROFILER_ENGINE_DETAILED_START(id) \
             do \
             { \
@@ -121,6 +118,48 @@ namespace
         int missed_frames = 0;
     };
 
+    #if BN_CFG_PROFILER_LOG_CPU_TICKS
+        class cpu_ticks_logger
+        {
+
+        public:
+            void log(int cpu_ticks)
+            {
+                if(_buffer.available() < 12)
+                {
+                    flush();
+                }
+
+                _buffer.append(to_string<11>(cpu_ticks));
+                _buffer.push_back(' ');
+            }
+
+            void update_keypad_commands(bool reading_keypad_commands)
+            {
+                if(_reading_keypad_commands && ! reading_keypad_commands)
+                {
+                    flush();
+                    BN_LOG("KEYPAD COMMANDS END");
+                }
+
+                _reading_keypad_commands = reading_keypad_commands;
+            }
+
+            void flush()
+            {
+                if(! _buffer.empty())
+                {
+                    BN_LOG(_buffer);
+                    _buffer.clear();
+                }
+            }
+
+        private:
+            string<min(BN_CFG_LOG_MAX_SIZE - 8, 128)> _buffer;
+            bool _reading_keypad_commands = false;
+        };
+    #endif
+
     class static_data
     {
 
@@ -140,6 +179,10 @@ namespace
         bool dma_enabled = hw::audio::dma_channel_free(3);
         bool slow_game_pak = false;
         volatile bool waiting_for_vblank = false;
+
+        #if BN_CFG_PROFILER_LOG_CPU_TICKS
+            cpu_ticks_logger cpu_ticks_logger;
+        #endif
     };
 
     alignas(static_data) BN_DATA_EWRAM_BSS char data_buffer[sizeof(static_data)];
@@ -187,6 +230,10 @@ namespace
         keypad_manager::stop();
         gpio_manager::stop();
 
+        #if BN_CFG_PROFILER_LOG_CPU_TICKS
+            data_ref().cpu_ticks_logger.flush();
+        #endif
+
         disable(disable_vblank_irq);
     }
 
@@ -228,6 +275,10 @@ namespace
         hblank_effects_manager::update();
         BN_PROFILER_ENGINE_DETAILED_STOP();
 
+        BN_PROFILER_ENGINE_DETAILED_START("eng_hblank_fx_entries");
+        hblank_effects_manager::update_entries();
+        BN_PROFILER_ENGINE_DETAILED_STOP();
+
         static_data& data = data_ref();
         bool use_dma = data.dma_enabled && ! link_manager::active();
 
@@ -421,6 +472,10 @@ void init(const optional<color>& transparent_color, const string_view& keypad_co
     bgs_manager::init();
     keypad_manager::init(keypad_commands);
 
+    #if BN_CFG_PROFILER_LOG_CPU_TICKS
+        data.cpu_ticks_logger.update_keypad_commands(keypad_manager::reading_commands());
+    #endif
+
     // First update:
     update();
 
@@ -481,9 +536,21 @@ void update()
         data.last_ticks = total_ticks;
     }
 
+    #if BN_CFG_PROFILER_LOG_CPU_TICKS
+        data.cpu_ticks_logger.log(data.last_ticks.cpu_usage_ticks);
+    #endif
+
     BN_PROFILER_ENGINE_DETAILED_START("eng_keypad");
     keypad_manager::update();
     BN_PROFILER_ENGINE_DETAILED_STOP();
+
+    #if BN_CFG_PROFILER_LOG_CPU_TICKS
+        data.cpu_ticks_logger.update_keypad_commands(keypad_manager::reading_commands());
+    #endif
+
+    #if BN_CFG_PROFILER_ENABLED
+        _bn::profiler::update();
+    #endif
 }
 
 void sleep(keypad::key_type wake_up_key)
@@ -5,6 +5,7 @@
 
 #include "bn_hblank_effects_manager.h"
 
+#include "bn_memory.h"
 #include "bn_vector.h"
 #include "../hw/include/bn_hw_hblank_effects.h"
 
@@ -282,10 +283,13 @@ namespace
         uint16_output_values_type* uint16_output_values = nullptr;
         uint32_output_values_type* uint32_output_values = nullptr;
         handler_type handler;
+        int8_t shared_item_index = -1;
+        int8_t entry_index = 0;
         bool visible: 1 = false;
         bool update: 1 = false;
         bool on_screen: 1 = false;
         bool output_values_written: 1 = false;
+        bool output_values_updated: 1 = false;
 
         void setup_target()
         {
@@ -470,6 +474,7 @@ namespace
         {
             bool updated = update;
             update = false;
+            output_values_updated = false;
 
             switch(handler)
             {
@@ -606,7 +611,7 @@ namespace
             }
         }
 
-        void setup_entry(hw_entries& entries) const
+        void setup_entry(hw_entries& entries)
         {
             if(_is_uint32(handler))
             {
@@ -614,29 +619,35 @@ namespace
                                 "Too many 32 bits entries");
 
                 hw::hblank_effects::uint32_entry& uint32_entry = entries.uint32_entries[entries.uint32_entries_count];
-                const uint16_t* src = uint32_output_values->a_active ? uint32_output_values->a : uint32_output_values->b;
-                uint32_entry.src = reinterpret_cast<const uint32_t*>(src);
+                uint32_entry.src = reinterpret_cast<const uint32_t*>(_active_output_values_ptr());
                 uint32_entry.dest = reinterpret_cast<uint32_t*>(output_register);
+                entry_index = int8_t(entries.uint32_entries_count);
                 ++entries.uint32_entries_count;
             }
             else
             {
                 hw::hblank_effects::uint16_entry& uint16_entry = entries.uint16_entries[entries.uint16_entries_count];
-
-                if(uint16_output_values)
-                {
-                    uint16_entry.src = uint16_output_values->a_active ? uint16_output_values->a : uint16_output_values->b;
-                }
-                else
-                {
-                    uint16_entry.src = uint32_output_values->a_active ? uint32_output_values->a : uint32_output_values->b;
-                }
-
+                uint16_entry.src = _active_output_values_ptr();
                 uint16_entry.dest = output_register;
+                entry_index = int8_t(entries.uint16_entries_count);
                 ++entries.uint16_entries_count;
             }
         }
 
+        void update_entry(hw_entries& entries) const
+        {
+            if(_is_uint32(handler))
+            {
+                hw::hblank_effects::uint32_entry& uint32_entry = entries.uint32_entries[entry_index];
+                uint32_entry.src = reinterpret_cast<const uint32_t*>(_active_output_values_ptr());
+            }
+            else
+            {
+                hw::hblank_effects::uint16_entry& uint16_entry = entries.uint16_entries[entry_index];
+                uint16_entry.src = _active_output_values_ptr();
+            }
+        }
+
         void show()
         {
             switch(handler)
@@ -996,6 +1007,16 @@ namespace
         }
 
     private:
+        [[nodiscard]] const uint16_t* _active_output_values_ptr() const
+        {
+            if(uint16_output_values)
+            {
+                return uint16_output_values->a_active ? uint16_output_values->a : uint16_output_values->b;
+            }
+
+            return uint32_output_values->a_active ? uint32_output_values->a : uint32_output_values->b;
+        }
+
         [[nodiscard]] __attribute__((noinline)) uint16_t* _output_values_ptr()
         {
             uint16_t* output_values_ptr;
@@ -1037,29 +1058,34 @@ namespace
             bool new_on_screen = Handler::target_visible(target_id);
             on_screen = new_on_screen;
 
-            if(new_on_screen)
+            if(! new_on_screen)
             {
-                updated |= Handler::target_updated(target_id, target_last_value);
-
-                if(! output_values_written)
-                {
-                    updated = true;
-                    output_values_written = true;
-                }
-
                 if(updated)
                 {
-                    uint16_t* output_values_ptr = _output_values_ptr();
-                    Handler::write_output_values(target_id, target_last_value, values_ptr, output_values_ptr);
+                    output_values_written = false;
                 }
 
-                uint16_t* old_output_register = output_register;
-                output_register = Handler::output_register(target_id);
-                updated |= old_output_register != output_register;
+                return old_on_screen;
+            }
+
+            updated |= Handler::target_updated(target_id, target_last_value);
+
+            if(! output_values_written)
+            {
+                updated = true;
+                output_values_written = true;
+            }
+
+            if(updated)
+            {
+                uint16_t* output_values_ptr = _output_values_ptr();
+                Handler::write_output_values(target_id, target_last_value, values_ptr, output_values_ptr);
+                output_values_updated = true;
             }
 
-            updated |= old_on_screen != new_on_screen;
-            return updated;
+            uint16_t* old_output_register = output_register;
+            output_register = Handler::output_register(target_id);
+            return ! old_on_screen || old_output_register != output_register;
         }
     };
 
@@ -1078,6 +1104,8 @@ namespace
         bool visible_entries = false;
         bool entries_a_active = false;
         bool update = false;
+        bool rebuild_entries = false;
+        bool patch_entries = false;
         bool commit = false;
         bool enabled = false;
     };
@@ -1101,6 +1129,55 @@ namespace
     static_internal_data internal_data;
 
 
+    [[nodiscard]] int _shared_item_index(const item_type& item, int first_item_index, int item_index)
+    {
+        static_external_data& data = external_data_ref();
+
+        for(int other_item_index = first_item_index; other_item_index < item_index; ++other_item_index)
+        {
+            const item_type& other_item = data.items[other_item_index];
+
+            if(other_item.visible && other_item.shared_item_index < 0 && other_item.values_ptr == item.values_ptr &&
+                    other_item.target_id == item.target_id && other_item.handler == item.handler)
+            {
+                return other_item_index;
+            }
+        }
+
+        return -1;
+    }
+
+    [[nodiscard]] bool _check_update(int item_index, int first_item_index, bool update_shared_items,
+                                     bool& output_values_updated)
+    {
+        item_type& item = external_data_ref().items[item_index];
+
+        if(update_shared_items)
+        {
+            int shared_item_index = _shared_item_index(item, first_item_index, item_index);
+
+            if(shared_item_index != item.shared_item_index)
+            {
+                if(shared_item_index < 0)
+                {
+                    item.output_values_written = false;
+                }
+
+                item.shared_item_index = int8_t(shared_item_index);
+            }
+        }
+
+        if(item.shared_item_index >= 0)
+        {
+            return false;
+        }
+
+        bool result = item.check_update();
+        output_values_updated |= item.output_values_updated;
+        return result;
+    }
+
+
     void _update_visible_item_index(int item_index)
     {
         static_external_data& data = external_data_ref();
@@ -1188,6 +1265,7 @@ namespace
         new_item.visible = true;
         new_item.update = true;
         new_item.on_screen = false;
+        new_item.shared_item_index = -1;
         new_item.output_values_written = false;
         new_item.setup_target();
 
@@ -1255,6 +1333,8 @@ void stop()
     external_data.first_visible_item_index = max_items - 1;
     external_data.last_visible_item_index = 0;
     external_data.update = false;
+    external_data.rebuild_entries = false;
+    external_data.patch_entries = false;
     external_data.commit = false;
     external_data.enabled = false;
 }
@@ -1341,6 +1421,11 @@ void reload_values_ref(int id)
     item_type& item = external_data.items[id];
     item.update = true;
 
+    if(int shared_item_index = item.shared_item_index; shared_item_index >= 0)
+    {
+        external_data.items[shared_item_index].update = true;
+    }
+
     if(item.visible)
     {
         external_data.update = true;
@@ -1377,7 +1462,9 @@ void set_visible(int id, bool visible)
 void update()
 {
     static_external_data& external_data = external_data_ref();
-    bool update = external_data.update;
+    bool update_shared_items = external_data.update;
+    bool update = update_shared_items;
+    bool output_values_updated = false;
     external_data.update = false;
 
     int first_visible_item_index = external_data.first_visible_item_index;
@@ -1387,11 +1474,10 @@ void update()
     {
         for(int item_index = first_visible_item_index; item_index <= last_visible_item_index; ++item_index)
         {
-            item_type& item = external_data.items[item_index];
-
-            if(item.visible)
+            if(external_data.items[item_index].visible)
             {
-                update |= item.check_update();
+                update |= _check_update(item_index, first_visible_item_index, update_shared_items,
+                                        output_values_updated);
             }
         }
     }
@@ -1399,13 +1485,12 @@ void update()
     {
         for(int item_index = 0; item_index < max_items; ++item_index)
         {
-            item_type& item = external_data.items[item_index];
-
-            if(item.visible)
+            if(external_data.items[item_index].visible)
             {
-                update |= item.check_update();
                 first_visible_item_index = min(first_visible_item_index, item_index);
                 last_visible_item_index = item_index;
+                update |= _check_update(item_index, first_visible_item_index, update_shared_items,
+                                        output_values_updated);
             }
         }
 
@@ -1421,37 +1506,79 @@ void update()
         }
     }
 
-    if(update)
+    external_data.rebuild_entries |= update;
+    external_data.patch_entries |= output_values_updated;
+}
+
+void update_entries()
+{
+    static_external_data& external_data = external_data_ref();
+    bool rebuild_entries = external_data.rebuild_entries;
+
+    if(rebuild_entries || external_data.patch_entries)
     {
+        int first_visible_item_index = external_data.first_visible_item_index;
+        int last_visible_item_index = external_data.last_visible_item_index;
+        hw_entries* active_entries;
         hw_entries* entries;
-        bool visible_entries = false;
 
         if(external_data.entries_a_active)
         {
+            active_entries = &internal_data.entries_a;
             entries = &internal_data.entries_b;
             external_data.entries_a_active = false;
         }
         else
         {
+            active_entries = &internal_data.entries_b;
             entries = &internal_data.entries_a;
             external_data.entries_a_active = true;
         }
 
-        entries->uint16_entries_count = 0;
-        entries->uint32_entries_count = 0;
+        external_data.rebuild_entries = false;
+        external_data.patch_entries = false;
 
-        for(int item_index = first_visible_item_index; item_index <= last_visible_item_index; ++item_index)
+        if(rebuild_entries)
         {
-            const item_type& item = external_data.items[item_index];
+            bool visible_entries = false;
+            entries->uint16_entries_count = 0;
+            entries->uint32_entries_count = 0;
 
-            if(item.visible && item.on_screen)
+            for(int item_index = first_visible_item_index; item_index <= last_visible_item_index; ++item_index)
             {
-                item.setup_entry(*entries);
-                visible_entries = true;
+                item_type& item = external_data.items[item_index];
+
+                if(item.visible && item.on_screen && item.shared_item_index < 0)
+                {
+                    item.setup_entry(*entries);
+                    visible_entries = true;
+                }
+            }
+
+            external_data.visible_entries = visible_entries;
+        }
+        else
+        {
+            // Only output values have been updated, so the active entries are copied and
+            // the ones of the updated items are patched:
+            int uint16_entries_count = active_entries->uint16_entries_count;
+            int uint32_entries_count = active_entries->uint32_entries_count;
+            entries->uint16_entries_count = uint16_entries_count;
+            entries->uint32_entries_count = uint32_entries_count;
+            memory::copy(active_entries->uint16_entries[0], uint16_entries_count, entries->uint16_entries[0]);
+            memory::copy(active_entries->uint32_entries[0], uint32_entries_count, entries->uint32_entries[0]);
+
+            for(int item_index = first_visible_item_index; item_index <= last_visible_item_index; ++item_index)
+            {
+                const item_type& item = external_data.items[item_index];
+
+                if(item.visible && item.on_screen && item.shared_item_index < 0 && item.output_values_updated)
+                {
+                    item.update_entry(*entries);
+                }
             }
         }
 
-        external_data.visible_entries = visible_entries;
         external_data.commit = true;
     }
 }
@@ -89,6 +89,8 @@ namespace bn::hblank_effects_manager
 
     void update();
 
+    void update_entries();
+
     bool commit();
 }
 
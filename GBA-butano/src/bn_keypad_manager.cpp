@@ -122,6 +122,11 @@ bool any_released()
     return data_ref().released_keys;
 }
 
+bool reading_commands()
+{
+    return data_ref().read_commands;
+}
+
 void update()
 {
     static_data& data = data_ref();
@@ -28,6 +28,8 @@ namespace bn::keypad_manager
 
     [[nodiscard]] bool any_released();
 
+    [[nodiscard]] bool reading_commands();
+
     void update();
 
     void set_interrupt(const span<const key_type>& keys);
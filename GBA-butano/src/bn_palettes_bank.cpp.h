@@ -30,6 +30,16 @@ namespace
         auto int_destination = reinterpret_cast<unsigned*>(destination);
         hw::memory::copy_words(int_source, count / 2, int_destination);
     }
+
+    // Channel independent effects applied to a ramp (the channels of each color are equal to its index)
+    // can be applied to any color with one lookup per channel (see hw::palettes::ramp_effect):
+    void init_ramp_colors(int count, color* ramp_colors)
+    {
+        for(int index = 0; index < count; ++index)
+        {
+            ramp_colors[index] = color(index, index, index);
+        }
+    }
 }
 
 uint16_t palettes_bank::colors_hash(const span<const color>& colors)
@@ -600,6 +610,7 @@ void palettes_bank::set_fade_color(color color)
     {
         _update = true;
         _update_global_effects = true;
+        _global_effects_ramp_ready = false;
     }
 }
 
@@ -656,13 +667,17 @@ void palettes_bank::update()
 
     if(_update)
     {
-        bool update_global_effects = _update_global_effects || _global_effects_enabled;
+        // Custom effects are applied once to the contiguous range of updated colors,
+        // so they can't be applied to each updated palette on its own:
+        bool update_global_effects = _update_global_effects || _custom_effect;
         _update = false;
-        _global_effects_updated = _update_global_effects;
+        _global_effects_updated = update_global_effects;
         _update_global_effects = false;
 
         if(update_global_effects)
         {
+            _update_global_effects_ramp();
+
             for(int index = 0, limit = hw::palettes::count(); index < limit; )
             {
                 const palette& pal = _palettes[index];
@@ -688,6 +703,14 @@ void palettes_bank::update()
                     _update_palette(index);
                     first_index = min(first_index, index);
                     last_index = index;
+
+                    // Global effects have not changed, so the other palettes are up to date:
+                    if(_global_effects_enabled)
+                    {
+                        color* pal_colors_ptr = _final_colors + (index * hw::palettes::colors_per_palette());
+                        int pal_colors_count = pal.slots_count * hw::palettes::colors_per_palette();
+                        _apply_global_effects(pal_colors_count, pal_colors_ptr);
+                    }
                 }
 
                 index += pal.slots_count;
@@ -696,11 +719,21 @@ void palettes_bank::update()
 
         if(const color* transparent_color = _transparent_color.get())
         {
-            _final_colors[0] = *transparent_color;
+            if(_global_effects_enabled && ! update_global_effects)
+            {
+                alignas(int) color transparent_colors[2] = { *transparent_color, *transparent_color };
+                _apply_global_effects(2, transparent_colors);
+                _final_colors[0] = transparent_colors[0];
+            }
+            else
+            {
+                _final_colors[0] = *transparent_color;
+            }
+
             first_index = 0;
         }
 
-        if(_global_effects_enabled && first_index != numeric_limits<int>::max())
+        if(_global_effects_enabled && update_global_effects && first_index != numeric_limits<int>::max())
         {
             color* all_colors_ptr = _final_colors + (first_index * hw::palettes::colors_per_palette());
             int all_colors_count = (last_index - first_index + _palettes[last_index].slots_count) *
@@ -819,6 +852,7 @@ void palettes_bank::_on_global_effect_updated(bool active)
 {
     _update = true;
     _update_global_effects = true;
+    _global_effects_ramp_ready = false;
 
     _global_effects_enabled = active || _inverted || _custom_effect || fixed_t<5>(_brightness).data() ||
             fixed_t<5>(_contrast).data() || fixed_t<5>(_intensity).data() ||
@@ -842,6 +876,7 @@ void palettes_bank::_update_palette(int id)
     int pal_colors_count = pal.slots_count * hw::palettes::colors_per_palette();
     copy_colors(initial_pal_colors_ptr, pal_colors_count, final_pal_colors_ptr);
     pal.apply_effects(pal_colors_count, final_pal_colors_ptr);
+    pal.update = false;
 
     if(int rotate_count = pal.rotate_count) [[unlikely]]
     {
@@ -856,7 +891,58 @@ void palettes_bank::_update_palette(int id)
     }
 }
 
+bool palettes_bank::_fused_global_effects() const
+{
+    // Hue shift and grayscale mix color channels:
+    if(fixed_t<5>(_hue_shift_intensity).data() || fixed_t<5>(_grayscale_intensity).data())
+    {
+        return false;
+    }
+
+    int channel_effects_count = int(_inverted) + int(fixed_t<5>(_brightness).data() != 0) +
+            int(fixed_t<5>(_contrast).data() != 0) + int(fixed_t<5>(_intensity).data() != 0) +
+            int(fixed_t<5>(_fade_intensity).data() != 0);
+    return channel_effects_count > 1;
+}
+
+void palettes_bank::_update_global_effects_ramp()
+{
+    bool ramp_ready = _global_effects_enabled && _fused_global_effects();
+
+    if(ramp_ready)
+    {
+        init_ramp_colors(_ramp_colors_count, _global_effects_ramp_colors);
+        _apply_global_color_effects(_ramp_colors_count, _global_effects_ramp_colors);
+    }
+
+    _global_effects_ramp_ready = ramp_ready;
+}
+
 void palettes_bank::_apply_global_effects(int dest_colors_count, color* dest_colors_ptr) const
+{
+    if(_global_effects_ramp_ready)
+    {
+        hw::palettes::ramp_effect(dest_colors_ptr, _global_effects_ramp_colors, dest_colors_count, dest_colors_ptr);
+    }
+    else if(dest_colors_count > _ramp_colors_count && _fused_global_effects())
+    {
+        alignas(int) color ramp_colors[_ramp_colors_count];
+        init_ramp_colors(_ramp_colors_count, ramp_colors);
+        _apply_global_color_effects(_ramp_colors_count, ramp_colors);
+        hw::palettes::ramp_effect(dest_colors_ptr, ramp_colors, dest_colors_count, dest_colors_ptr);
+    }
+    else
+    {
+        _apply_global_color_effects(dest_colors_count, dest_colors_ptr);
+    }
+
+    if(palette_effect_type effect = _custom_effect)
+    {
+        effect(span<color>(dest_colors_ptr, dest_colors_count));
+    }
+}
+
+void palettes_bank::_apply_global_color_effects(int dest_colors_count, color* dest_colors_ptr) const
 {
     if(int brightness = fixed_t<5>(_brightness).data())
     {
@@ -892,14 +978,26 @@ void palettes_bank::_apply_global_effects(int dest_colors_count, color* dest_col
     {
         hw::palettes::fade(dest_colors_ptr, _fade_color, fade_intensity, dest_colors_count, dest_colors_ptr);
     }
+}
 
-    if(palette_effect_type effect = _custom_effect)
+void palettes_bank::palette::apply_effects(int dest_colors_count, color* dest_colors_ptr) const
+{
+    if(inverted && dest_colors_count > _ramp_colors_count && fixed_t<5>(fade_intensity).data() &&
+            ! fixed_t<5>(hue_shift_intensity).data() && ! fixed_t<5>(grayscale_intensity).data())
     {
-        effect(span<color>(dest_colors_ptr, dest_colors_count));
+        // Invert and fade are channel independent:
+        alignas(int) color ramp_colors[_ramp_colors_count];
+        init_ramp_colors(_ramp_colors_count, ramp_colors);
+        _apply_color_effects(_ramp_colors_count, ramp_colors);
+        hw::palettes::ramp_effect(dest_colors_ptr, ramp_colors, dest_colors_count, dest_colors_ptr);
+    }
+    else
+    {
+        _apply_color_effects(dest_colors_count, dest_colors_ptr);
     }
 }
 
-void palettes_bank::palette::apply_effects(int dest_colors_count, color* dest_colors_ptr) const
+void palettes_bank::palette::_apply_color_effects(int dest_colors_count, color* dest_colors_ptr) const
 {
     if(int pal_hue_shift_intensity = fixed_t<5>(hue_shift_intensity).data())
     {
@@ -251,11 +251,17 @@ private:
         bool locked: 1 = false;
 
         void apply_effects(int dest_colors_count, color* dest_colors_ptr) const;
+
+    private:
+        void _apply_color_effects(int dest_colors_count, color* dest_colors_ptr) const;
     };
 
+    static constexpr int _ramp_colors_count = 32;
+
     palette _palettes[hw::palettes::count()] = {};
     alignas(int) color _initial_colors[hw::palettes::colors()] = {};
     alignas(int) color _final_colors[hw::palettes::colors()] = {};
+    alignas(int) color _global_effects_ramp_colors[_ramp_colors_count] = {};
     optional<color> _transparent_color;
     fixed _brightness;
     fixed _contrast;
@@ -273,6 +279,7 @@ private:
     bool _update_global_effects = false;
     bool _global_effects_enabled = false;
     bool _global_effects_updated = false;
+    bool _global_effects_ramp_ready = false;
 
     [[nodiscard]] bool _same_colors(const span<const color>& colors, int id) const;
 
@@ -291,7 +298,13 @@ private:
 
     void _update_palette(int id);
 
+    [[nodiscard]] bool _fused_global_effects() const;
+
+    void _update_global_effects_ramp();
+
     void _apply_global_effects(int dest_colors_count, color* dest_colors_ptr) const;
+
+    void _apply_global_color_effects(int dest_colors_count, color* dest_colors_ptr) const;
 };
 
 }
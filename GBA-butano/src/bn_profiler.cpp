@@ -6,9 +6,10 @@
 #include "bn_profiler.h"
 
 #if BN_CFG_PROFILER_ENABLED
+    #include "bn_log.h"
     #include "bn_timer.h"
-    #include "bn_optional.h"
-    #include "bn_unordered_map.h"
+    #include "bn_algorithm.h"
+    #include "bn_dense_unordered_map.h"
 
     namespace _bn::profiler
     {
@@ -16,15 +17,31 @@
         {
             static_assert(BN_CFG_PROFILER_MAX_ENTRIES > 0);
             static_assert(bn::power_of_two(BN_CFG_PROFILER_MAX_ENTRIES));
+            static_assert(BN_CFG_PROFILER_MAX_DEPTH > 0);
+            static_assert(BN_CFG_PROFILER_FRAME_SAMPLES >= 0);
+
+            class scope_type
+            {
+
+            public:
+                bn::timer timer;
+                const char* id;
+                unsigned id_hash;
+            };
+
 
             class static_data
             {
 
             public:
                 ticks_map ticks_per_entry;
-                bn::optional<bn::timer> current_timer;
-                const char* current_id = nullptr;
-                unsigned current_id_hash;
+                scope_type scopes[BN_CFG_PROFILER_MAX_DEPTH];
+                int scopes_count = 0;
+
+                #if BN_CFG_PROFILER_FRAME_SAMPLES > 0
+                    int frame_sample_index = 0;
+                    int frame_samples_count = 0;
+                #endif
             };
 
             BN_DATA_EWRAM static_data data;
@@ -33,37 +50,150 @@
         void start(const char* id, unsigned id_hash)
         {
             BN_BASIC_ASSERT(id, "Id is null");
-            BN_BASIC_ASSERT(! data.current_id, "There's already an active id: ", data.current_id);
 
-            data.current_id = id;
-            data.current_id_hash = id_hash;
-            data.current_timer = bn::timer();
+            int scopes_count = data.scopes_count;
+            BN_BASIC_ASSERT(scopes_count < BN_CFG_PROFILER_MAX_DEPTH, "Too many nested ids: ", scopes_count);
+
+            scope_type& scope = data.scopes[scopes_count];
+            scope.id = id;
+            scope.id_hash = id_hash;
+            data.scopes_count = scopes_count + 1;
+
+            BN_BARRIER;
+            scope.timer.restart();
         }
 
         void stop()
         {
-            BN_BASIC_ASSERT(data.current_id, "There's no active id");
+            int scopes_count = data.scopes_count;
+            BN_BASIC_ASSERT(scopes_count, "There's no active id");
+
+            --scopes_count;
 
-            int timer_ticks = data.current_timer->elapsed_ticks();
-            auto timer_ticks_64 = int64_t(timer_ticks);
-            ticks& ticks = data.ticks_per_entry(data.current_id_hash, data.current_id);
-            ticks.total += timer_ticks_64;
+            scope_type& scope = data.scopes[scopes_count];
+            int timer_ticks = scope.timer.elapsed_ticks();
+
+            BN_BARRIER;
+
+            ticks_map& ticks_per_entry = data.ticks_per_entry;
+            auto it = ticks_per_entry.find_hash(scope.id_hash, scope.id);
+
+            if(it == ticks_per_entry.end())
+            {
+                ticks new_ticks;
+
+                if(scopes_count)
+                {
+                    new_ticks.parent = data.scopes[scopes_count - 1].id;
+                }
+
+                it = ticks_per_entry.insert_hash(scope.id_hash, scope.id, new_ticks);
+            }
+
+            ticks& ticks = it->second;
+            ticks.total += int64_t(timer_ticks);
             ticks.max = bn::max(ticks.max, timer_ticks);
-            data.current_id = nullptr;
+
+            #if BN_CFG_PROFILER_FRAME_SAMPLES > 0
+                ticks.frame += timer_ticks;
+            #endif
+
+            data.scopes_count = scopes_count;
+        }
+
+        void update()
+        {
+            #if BN_CFG_PROFILER_FRAME_SAMPLES > 0
+                int frame_sample_index = data.frame_sample_index;
+
+                for(auto& ticks_per_entry_pair : data.ticks_per_entry)
+                {
+                    ticks& ticks = ticks_per_entry_pair.second;
+                    ticks.frame_samples[frame_sample_index] = ticks.frame;
+                    ticks.frame = 0;
+                }
+
+                ++frame_sample_index;
+
+                if(frame_sample_index == BN_CFG_PROFILER_FRAME_SAMPLES)
+                {
+                    frame_sample_index = 0;
+                }
+
+                data.frame_sample_index = frame_sample_index;
+                data.frame_samples_count = bn::min(data.frame_samples_count + 1, BN_CFG_PROFILER_FRAME_SAMPLES);
+            #endif
         }
 
         const ticks_map& ticks_per_entry()
         {
-            BN_BASIC_ASSERT(! data.current_id, "There's an active id: ", data.current_id);
+            BN_BASIC_ASSERT(! data.scopes_count, "There's an active id: ", data.scopes[data.scopes_count - 1].id);
 
             return data.ticks_per_entry;
         }
 
+        #if BN_CFG_PROFILER_FRAME_SAMPLES > 0
+            int frame_ticks_percentile(const ticks& ticks, int percentile)
+            {
+                BN_ASSERT(percentile >= 0 && percentile <= 100, "Invalid percentile: ", percentile);
+
+                int frame_samples_count = data.frame_samples_count;
+
+                if(! frame_samples_count)
+                {
+                    return 0;
+                }
+
+                int frame_samples[BN_CFG_PROFILER_FRAME_SAMPLES];
+                bn::copy(ticks.frame_samples, ticks.frame_samples + frame_samples_count, frame_samples);
+                bn::sort(frame_samples, frame_samples + frame_samples_count);
+                return frame_samples[((frame_samples_count - 1) * percentile) / 100];
+            }
+        #endif
+
         void reset()
         {
-            BN_BASIC_ASSERT(! data.current_id, "There's an active id: ", data.current_id);
+            BN_BASIC_ASSERT(! data.scopes_count, "There's an active id: ", data.scopes[data.scopes_count - 1].id);
 
             data.ticks_per_entry.clear();
+
+            #if BN_CFG_PROFILER_FRAME_SAMPLES > 0
+                data.frame_sample_index = 0;
+                data.frame_samples_count = 0;
+            #endif
+        }
+    }
+
+    namespace bn::profiler
+    {
+        void log()
+        {
+            #if BN_CFG_LOG_ENABLED
+                using namespace _bn::profiler;
+
+                #if BN_CFG_PROFILER_FRAME_SAMPLES > 0
+                    BN_LOG("PROFILER - Frames: ", data.frame_samples_count);
+                #else
+                    BN_LOG("PROFILER");
+                #endif
+
+                for(const auto& ticks_per_entry_pair : data.ticks_per_entry)
+                {
+                    const ticks& ticks = ticks_per_entry_pair.second;
+                    const char* parent = ticks.parent;
+
+                    #if BN_CFG_PROFILER_FRAME_SAMPLES > 0
+                        BN_LOG(ticks_per_entry_pair.first, " (", parent ? parent : "-", ")",
+                               " total: ", ticks.total, " max: ", ticks.max,
+                               " frame p50: ", frame_ticks_percentile(ticks, 50),
+                               " p95: ", frame_ticks_percentile(ticks, 95),
+                               " max: ", frame_ticks_percentile(ticks, 100));
+                    #else
+                        BN_LOG(ticks_per_entry_pair.first, " (", parent ? parent : "-", ")",
+                               " total: ", ticks.total, " max: ", ticks.max);
+                    #endif
+                }
+            #endif
         }
     }
 #endif
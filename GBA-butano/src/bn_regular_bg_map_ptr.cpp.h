@@ -424,6 +424,26 @@ void regular_bg_map_ptr::set_tiles_and_palette(const regular_bg_tiles_item& tile
     bg_blocks_manager::set_regular_map_tiles_and_palette(_handle, move(*tiles_ptr), move(*palette_ptr));
 }
 
+void regular_bg_map_ptr::set_tiles_cache(const regular_bg_tiles_item& source_tiles_item)
+{
+    bg_blocks_manager::set_regular_map_tiles_cache(_handle, source_tiles_item);
+}
+
+void regular_bg_map_ptr::remove_tiles_cache()
+{
+    bg_blocks_manager::remove_regular_map_tiles_cache(_handle);
+}
+
+int regular_bg_map_ptr::tiles_cache_hits() const
+{
+    return bg_blocks_manager::regular_map_tiles_cache_hits(_handle);
+}
+
+int regular_bg_map_ptr::tiles_cache_misses() const
+{
+    return bg_blocks_manager::regular_map_tiles_cache_misses(_handle);
+}
+
 optional<span<const regular_bg_map_cell>> regular_bg_map_ptr::vram() const
 {
     optional<span<regular_bg_map_cell>> vram_opt = bg_blocks_manager::regular_map_vram(_handle);
@@ -7,6 +7,8 @@
 #define BN_SORTED_SPRITES_H
 
 #include "bn_pool.h"
+#include "bn_vector.h"
+#include "bn_algorithm.h"
 #include "bn_config_sprites.h"
 #include "bn_sprites_manager_item.h"
 
@@ -75,29 +77,36 @@ namespace bn::sorted_sprites
                 item_sort_key.set_priority(0);
             }
 
+            // Binary search over the sorted layer pointers instead of walking the layers list:
             layers_type& layer_ptrs = _layer_ptrs;
-            layers_type::iterator layers_end = layer_ptrs.end();
-            layers_type::iterator layers_it = lower_bound(layer_ptrs.begin(), layers_end, item_sort_key,
-                    [](const layer& layer, sort_key sort_key) {
-                        return layer.layer_sort_key() < sort_key;
-                    });
+            sorted_layers_type& sorted_layers = _sorted_layers;
+            sorted_layers_type::iterator sorted_layers_end = sorted_layers.end();
+            sorted_layers_type::iterator sorted_layers_it = _lower_bound(item_sort_key);
+            layer* layer_ptr;
 
-            if(layers_it == layers_end)
+            if(sorted_layers_it != sorted_layers_end && item_sort_key == (*sorted_layers_it)->layer_sort_key())
             {
-                BN_BASIC_ASSERT(! _layer_pool.full(), "No more sprite sort layers available");
-
-                layer& pool_layer = _layer_pool.create(item_sort_key);
-                layers_it = layer_ptrs.insert(layers_end, pool_layer);
+                layer_ptr = *sorted_layers_it;
             }
-            else if(item_sort_key != layers_it->layer_sort_key())
+            else
             {
                 BN_BASIC_ASSERT(! _layer_pool.full(), "No more sprite sort layers available");
 
-                layer& pool_layer = _layer_pool.create(item_sort_key);
-                layers_it = layer_ptrs.insert(layers_it, pool_layer);
+                layer_ptr = &_layer_pool.create(item_sort_key);
+
+                if(sorted_layers_it == sorted_layers_end)
+                {
+                    layer_ptrs.push_back(*layer_ptr);
+                }
+                else
+                {
+                    layer_ptrs.insert(**sorted_layers_it, *layer_ptr);
+                }
+
+                sorted_layers.insert(sorted_layers_it, layer_ptr);
             }
 
-            layer& layer_ref = *layers_it;
+            layer& layer_ref = *layer_ptr;
             layer_ref.items().push_front(item);
 
             int diff = &layer_ref - reinterpret_cast<layer*>(&layer_ptrs);
@@ -112,6 +121,7 @@ namespace bn::sorted_sprites
 
             if(layer_items.empty())
             {
+                _sorted_layers.erase(_lower_bound(layer->layer_sort_key()));
                 _layer_ptrs.erase(*layer);
                 _layer_pool.destroy(*layer);
             }
@@ -148,10 +158,21 @@ namespace bn::sorted_sprites
         }
 
     private:
+        using sorted_layers_type = vector<layer*, BN_CFG_SPRITES_MAX_SORT_LAYERS>;
+
         pool<layer, BN_CFG_SPRITES_MAX_SORT_LAYERS> _layer_pool;
         layers_type _layer_ptrs;
+        sorted_layers_type _sorted_layers;
         bool _bg_sorting_disabled = false;
 
+        [[nodiscard]] sorted_layers_type::iterator _lower_bound(sort_key layer_sort_key)
+        {
+            return lower_bound(_sorted_layers.begin(), _sorted_layers.end(), layer_sort_key,
+                    [](const layer* layer, sort_key sort_key) {
+                        return layer->layer_sort_key() < sort_key;
+                    });
+        }
+
         [[nodiscard]] layer* _layer_ptr(int diff)
         {
             return reinterpret_cast<layer*>(&_layer_ptrs) + diff;
@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_sprite_affine_mats_manager.h"
+
+#include "bn_sprite_affine_mats_manager_hot.h"
+
+namespace bn::sprite_affine_mats_manager
+{
+
+bool _sprite_double_size_impl(int pa, int pb, int pc, int pd, int divisor, const sprite_shape_size& shape_size)
+{
+    return hot::sprite_double_size(pa, pb, pc, pd, divisor, shape_size);
+}
+
+}
@@ -5,7 +5,9 @@
 
 #include "bn_sprite_affine_mats_manager.h"
 
+#include "bn_memory.h"
 #include "bn_vector.h"
+#include "bn_config_sprites.h"
 #include "bn_sprites_manager_item.h"
 #include "bn_affine_mat_attributes_reader.h"
 #include "../hw/include/bn_hw_sprites_constants.h"
@@ -15,6 +17,10 @@
 #include "bn_sprite_affine_mats.cpp.h"
 #include "bn_sprite_affine_mat_ptr.cpp.h"
 
+#if ! BN_CFG_SPRITES_USE_IWRAM
+    #include "bn_sprite_affine_mats_manager_hot.h"
+#endif
+
 namespace bn::sprite_affine_mats_manager
 {
 
@@ -25,36 +31,14 @@ namespace
 
     static_assert(max_items <= numeric_limits<int8_t>::max());
 
-    template<int half_width, int half_height>
-    [[nodiscard]] bool _sprite_double_size(int pa, int pb, int pc, int pd, int divisor)
+    [[nodiscard]] bool _sprite_double_size(int pa, int pb, int pc, int pd, int divisor,
+                                           const sprite_shape_size& shape_size)
     {
-        if(pb || pd)
-        {
-            int ix1 = ((-256 * half_height * pb) - (256 * half_width * pd) + (256 * pb)) / divisor;
-
-            if(ix1 < -half_width || ix1 >= half_width)
-            {
-                return true;
-            }
-
-            int ix2 = ((-256 * half_height * pb) + (256 * half_width * pd) + (256 * pb) - (256 * pd)) / divisor;
-
-            if(ix2 < -half_width || ix2 >= half_width)
-            {
-                return true;
-            }
-        }
-
-        int iy1 = (256 * ((half_height * pa) + (half_width * pc) - pa)) / divisor;
-
-        if(iy1 < -half_height || iy1 >= half_height)
-        {
-            return true;
-        }
-
-        int iy2 = (256 * ((half_height * pa) - (half_width * pc) - pa + pc)) / divisor;
-
-        return iy2 < -half_height || iy2 >= half_height;
+        #if BN_CFG_SPRITES_USE_IWRAM
+            return _sprite_double_size_impl(pa, pb, pc, pd, divisor, shape_size);
+        #else
+            return hot::sprite_double_size(pa, pb, pc, pd, divisor, shape_size);
+        #endif
     }
 
 
@@ -87,56 +71,9 @@ namespace
 
         [[nodiscard]] bool sprite_double_size(int divisor, const sprite_shape_size& shape_size) const
         {
-            int pa = attributes.pa_register_value();
-            int pb = attributes.pb_register_value();
-            int pc = attributes.pc_register_value();
-            int pd = attributes.pd_register_value();
-
-            switch(shape_size.shape())
-            {
-
-            case sprite_shape::SQUARE:
-                return _sprite_double_size<32, 32>(pa, pb, pc, pd, divisor);
-
-            case sprite_shape::WIDE:
-                switch(shape_size.size())
-                {
-
-                case sprite_size::SMALL:
-                    return _sprite_double_size<32, 16>(pa, pb, pc, pd, divisor);
-
-                case sprite_size::NORMAL:
-                    return _sprite_double_size<32, 8>(pa, pb, pc, pd, divisor);
-
-                case sprite_size::BIG:
-                case sprite_size::HUGE:
-                    return _sprite_double_size<32, 16>(pa, pb, pc, pd, divisor);
-
-                default:
-                    return false;
-                }
-
-            case sprite_shape::TALL:
-                switch(shape_size.size())
-                {
-
-                case sprite_size::SMALL:
-                    return _sprite_double_size<16, 32>(pa, pb, pc, pd, divisor);
-
-                case sprite_size::NORMAL:
-                    return _sprite_double_size<8, 32>(pa, pb, pc, pd, divisor);
-
-                case sprite_size::BIG:
-                case sprite_size::HUGE:
-                    return _sprite_double_size<16, 32>(pa, pb, pc, pd, divisor);
-
-                default:
-                    return false;
-                }
-
-            default:
-                return false;
-            }
+            return _sprite_double_size(attributes.pa_register_value(), attributes.pb_register_value(),
+                                       attributes.pc_register_value(), attributes.pd_register_value(), divisor,
+                                       shape_size);
         }
 
         void update_attached_nodes_auto_double_size(bool double_size)
@@ -315,6 +252,13 @@ namespace
             int first_index_to_commit = data.first_index_to_commit;
             int last_index_to_commit = data.last_index_to_commit;
 
+            // Double size results are shared between consecutive items with the same register values:
+            uint8_t shape_size_values[12] = {};
+            int shape_size_values_pa = 0;
+            int shape_size_values_pb = 0;
+            int shape_size_values_pc = 0;
+            int shape_size_values_pd = 0;
+
             for(int index = first_index_to_update; index <= last_index_to_update; ++index)
             {
                 item_type& item = data.items[index];
@@ -341,55 +285,43 @@ namespace
 
                         if(divisor) [[likely]]
                         {
-                            if(item.attached_nodes.size() == 1)
+                            if(pa != shape_size_values_pa || pb != shape_size_values_pb ||
+                                    pc != shape_size_values_pc || pd != shape_size_values_pd)
+                            {
+                                memory::clear(shape_size_values);
+                                shape_size_values_pa = pa;
+                                shape_size_values_pb = pb;
+                                shape_size_values_pc = pc;
+                                shape_size_values_pd = pd;
+                            }
+
+                            for(sprite_affine_mat_attach_node_type& attached_node : item.attached_nodes)
                             {
                                 sprites_manager_item& sprite_item =
-                                        sprites_manager_item::affine_mat_attach_node_item(*item.attached_nodes.begin());
+                                        sprites_manager_item::affine_mat_attach_node_item(attached_node);
 
                                 if(sprite_item.double_size_mode == uint8_t(sprite_double_size_mode::AUTO))
                                 {
-                                    bool double_size = item.sprite_double_size(
-                                            divisor, hw::sprites::shape_size(sprite_item.handle));
+                                    sprite_shape shape = hw::sprites::shape(sprite_item.handle);
+                                    sprite_size size = hw::sprites::size(sprite_item.handle);
+                                    int shape_size_key = (int(shape) << 2) + int(size);
+                                    bool double_size;
 
-                                    if(sprite_item.double_size != double_size)
+                                    if(uint8_t shape_size_value = shape_size_values[shape_size_key])
                                     {
-                                        sprite_item.double_size = double_size;
-                                        sprites_manager::update_auto_double_size(&sprite_item);
+                                        double_size = shape_size_value == 2;
+                                    }
+                                    else
+                                    {
+                                        double_size = _sprite_double_size(
+                                                pa, pb, pc, pd, divisor, sprite_shape_size(shape, size));
+                                        shape_size_values[shape_size_key] = double_size ? 2 : 1;
                                     }
-                                }
-                            }
-                            else
-                            {
-                                uint8_t shape_size_values[12] = {};
-
-                                for(sprite_affine_mat_attach_node_type& attached_node : item.attached_nodes)
-                                {
-                                    sprites_manager_item& sprite_item =
-                                            sprites_manager_item::affine_mat_attach_node_item(attached_node);
 
-                                    if(sprite_item.double_size_mode == uint8_t(sprite_double_size_mode::AUTO))
+                                    if(sprite_item.double_size != double_size)
                                     {
-                                        sprite_shape shape = hw::sprites::shape(sprite_item.handle);
-                                        sprite_size size = hw::sprites::size(sprite_item.handle);
-                                        int shape_size_key = (int(shape) << 2) + int(size);
-                                        bool double_size;
-
-                                        if(uint8_t shape_size_value = shape_size_values[shape_size_key])
-                                        {
-                                            double_size = shape_size_value == 2;
-                                        }
-                                        else
-                                        {
-                                            double_size = item.sprite_double_size(
-                                                    divisor, sprite_shape_size(shape, size));
-                                            shape_size_values[shape_size_key] = double_size ? 2 : 1;
-                                        }
-
-                                        if(sprite_item.double_size != double_size)
-                                        {
-                                            sprite_item.double_size = double_size;
-                                            sprites_manager::update_auto_double_size(&sprite_item);
-                                        }
+                                        sprite_item.double_size = double_size;
+                                        sprites_manager::update_auto_double_size(&sprite_item);
                                     }
                                 }
                             }
@@ -8,6 +8,7 @@
 
 #include "bn_fixed.h"
 #include "bn_intrusive_list.h"
+#include "bn_config_sprites.h"
 
 namespace bn
 {
@@ -103,6 +104,11 @@ namespace bn::sprite_affine_mats_manager
     void update();
 
     [[nodiscard]] commit_data retrieve_commit_data();
+
+    #if BN_CFG_SPRITES_USE_IWRAM
+        [[nodiscard]] BN_CODE_IWRAM bool _sprite_double_size_impl(
+                int pa, int pb, int pc, int pd, int divisor, const sprite_shape_size& shape_size);
+    #endif
 }
 
 #endif
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_sprite_shape_size.h"
+
+namespace bn::sprite_affine_mats_manager::hot
+{
+
+// Returns the same as (numerator / divisor) < -half_size || (numerator / divisor) >= half_size
+// without dividing (divisor must be positive):
+[[nodiscard]] inline bool outside(int numerator, int64_t divisor, int half_size)
+{
+    return numerator <= -(half_size + 1) * divisor || numerator >= half_size * divisor;
+}
+
+template<int half_width, int half_height>
+[[nodiscard]] bool sprite_double_size(int pa, int pb, int pc, int pd, int divisor)
+{
+    int64_t positive_divisor = divisor;
+
+    if(divisor < 0)
+    {
+        pa = -pa;
+        pb = -pb;
+        pc = -pc;
+        pd = -pd;
+        positive_divisor = -positive_divisor;
+    }
+
+    if(pb || pd)
+    {
+        if(outside((-256 * half_height * pb) - (256 * half_width * pd) + (256 * pb), positive_divisor, half_width))
+        {
+            return true;
+        }
+
+        if(outside((-256 * half_height * pb) + (256 * half_width * pd) + (256 * pb) - (256 * pd), positive_divisor,
+                   half_width))
+        {
+            return true;
+        }
+    }
+
+    if(outside(256 * ((half_height * pa) + (half_width * pc) - pa), positive_divisor, half_height))
+    {
+        return true;
+    }
+
+    return outside(256 * ((half_height * pa) - (half_width * pc) - pa + pc), positive_divisor, half_height);
+}
+
+[[nodiscard]] inline bool sprite_double_size(int pa, int pb, int pc, int pd, int divisor,
+                                             const sprite_shape_size& shape_size)
+{
+    switch(shape_size.shape())
+    {
+
+    case sprite_shape::SQUARE:
+        return sprite_double_size<32, 32>(pa, pb, pc, pd, divisor);
+
+    case sprite_shape::WIDE:
+        switch(shape_size.size())
+        {
+
+        case sprite_size::SMALL:
+            return sprite_double_size<32, 16>(pa, pb, pc, pd, divisor);
+
+        case sprite_size::NORMAL:
+            return sprite_double_size<32, 8>(pa, pb, pc, pd, divisor);
+
+        case sprite_size::BIG:
+        case sprite_size::HUGE:
+            return sprite_double_size<32, 16>(pa, pb, pc, pd, divisor);
+
+        default:
+            return false;
+        }
+
+    case sprite_shape::TALL:
+        switch(shape_size.size())
+        {
+
+        case sprite_size::SMALL:
+            return sprite_double_size<16, 32>(pa, pb, pc, pd, divisor);
+
+        case sprite_size::NORMAL:
+            return sprite_double_size<8, 32>(pa, pb, pc, pd, divisor);
+
+        case sprite_size::BIG:
+        case sprite_size::HUGE:
+            return sprite_double_size<16, 32>(pa, pb, pc, pd, divisor);
+
+        default:
+            return false;
+        }
+
+    default:
+        return false;
+    }
+}
+
+}
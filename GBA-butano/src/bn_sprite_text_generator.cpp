@@ -5,10 +5,13 @@
 
 #include "bn_sprite_text_generator.h"
 
+#include "bn_string.h"
 #include "bn_sprites.h"
 #include "bn_sprite_ptr.h"
 #include "bn_sprite_builder.h"
 #include "bn_top_left_utils.h"
+#include "bn_config_sprites.h"
+#include "bn_sprite_tiles_manager.h"
 #include "../hw/include/bn_hw_sprite_tiles.h"
 
 namespace bn
@@ -26,6 +29,231 @@ namespace
         builder.set_camera(generator.camera());
     }
 
+    [[nodiscard]] fixed_point _aligned_position(sprite_text_generator::alignment_type alignment,
+                                                const fixed_point& position, int text_width)
+    {
+        fixed_point result = position;
+
+        switch(alignment)
+        {
+
+        case sprite_text_generator::alignment_type::LEFT:
+            break;
+
+        case sprite_text_generator::alignment_type::CENTER:
+            result.set_x(result.x() - (text_width / 2));
+            break;
+
+        case sprite_text_generator::alignment_type::RIGHT:
+            result.set_x(result.x() - text_width);
+            break;
+
+        default:
+            BN_ERROR("Invalid alignment: ", int(alignment));
+            break;
+        }
+
+        return result;
+    }
+
+
+#if BN_CFG_SPRITE_TEXT_CACHE_MAX_ENTRIES > 0
+    static_assert(BN_CFG_SPRITE_TEXT_CACHE_MAX_TEXT_SIZE > 1);
+
+    constexpr int max_cache_sprites = BN_CFG_SPRITE_TEXT_CACHE_MAX_TEXT_SIZE / 2;
+
+
+    class cache_sprite_type
+    {
+
+    public:
+        sprite_tiles_ptr tiles;
+        sprite_shape_size shape_size;
+        fixed x;
+    };
+
+
+    class cache_entry_type
+    {
+
+    public:
+        string<BN_CFG_SPRITE_TEXT_CACHE_MAX_TEXT_SIZE> text;
+        sprite_item font_item;
+        const int8_t* font_character_widths;
+        int font_space_between_characters;
+        int text_width;
+        unsigned last_use;
+        vector<cache_sprite_type, max_cache_sprites> sprites;
+
+        cache_entry_type(const sprite_font& font, const string_view& entry_text, int entry_text_width,
+                         unsigned entry_last_use) :
+            text(entry_text),
+            font_item(font.item()),
+            font_character_widths(font.character_widths_ref().data()),
+            font_space_between_characters(font.space_between_characters()),
+            text_width(entry_text_width),
+            last_use(entry_last_use)
+        {
+        }
+
+        [[nodiscard]] bool matches(const sprite_font& font, const string_view& other_text) const
+        {
+            return text == other_text && font_item == font.item() &&
+                    font_character_widths == font.character_widths_ref().data() &&
+                    font_space_between_characters == font.space_between_characters();
+        }
+    };
+
+
+    class cache_static_data
+    {
+
+    public:
+        vector<cache_entry_type, BN_CFG_SPRITE_TEXT_CACHE_MAX_ENTRIES> entries;
+        unsigned uses_counter = 0;
+    };
+
+    BN_DATA_EWRAM cache_static_data cache_data;
+
+
+    [[nodiscard]] const cache_entry_type* _find_cache_entry(const sprite_font& font, const string_view& text)
+    {
+        for(cache_entry_type& entry : cache_data.entries)
+        {
+            if(entry.matches(font, text))
+            {
+                ++cache_data.uses_counter;
+                entry.last_use = cache_data.uses_counter;
+                return &entry;
+            }
+        }
+
+        return nullptr;
+    }
+
+    bool _erase_least_recently_used_cache_entry()
+    {
+        auto& entries = cache_data.entries;
+
+        if(entries.empty())
+        {
+            return false;
+        }
+
+        auto lru_it = entries.begin();
+
+        for(auto it = lru_it + 1, end = entries.end(); it != end; ++it)
+        {
+            if(it->last_use < lru_it->last_use)
+            {
+                lru_it = it;
+            }
+        }
+
+        entries.erase(lru_it);
+        return true;
+    }
+
+    void _insert_cache_entry(const sprite_text_generator& generator, const string_view& text,
+                             fixed aligned_x, const ivector<sprite_ptr>& output_sprites, int first_sprite_index)
+    {
+        int sprites_count = output_sprites.size() - first_sprite_index;
+
+        if(! sprites_count || sprites_count > max_cache_sprites || text.size() > BN_CFG_SPRITE_TEXT_CACHE_MAX_TEXT_SIZE)
+        {
+            return;
+        }
+
+        auto& entries = cache_data.entries;
+
+        if(entries.full())
+        {
+            _erase_least_recently_used_cache_entry();
+        }
+
+        ++cache_data.uses_counter;
+
+        cache_entry_type& entry = entries.emplace_back(
+                    generator.font(), text, generator.width(text), cache_data.uses_counter);
+
+        for(int index = first_sprite_index, limit = output_sprites.size(); index < limit; ++index)
+        {
+            const sprite_ptr& sprite = output_sprites[index];
+            entry.sprites.push_back(cache_sprite_type{ sprite.tiles(), sprite.shape_size(), sprite.x() - aligned_x });
+        }
+    }
+
+    template<bool allow_failure>
+    [[nodiscard]] bool _generate_from_cache(
+        const sprite_text_generator& generator, const sprite_palette_ptr& palette, const fixed_point& position,
+        const cache_entry_type& cache_entry, ivector<sprite_ptr>& output_sprites)
+    {
+        fixed_point aligned_position = _aligned_position(generator.alignment(), position, cache_entry.text_width);
+        int output_sprites_count = output_sprites.size();
+
+        for(const cache_sprite_type& cache_sprite : cache_entry.sprites)
+        {
+            sprite_builder builder(cache_sprite.shape_size, cache_sprite.tiles, palette);
+            builder.set_position(aligned_position.x() + cache_sprite.x, aligned_position.y());
+            _setup_builder(generator, builder);
+
+            if(allow_failure)
+            {
+                optional<sprite_ptr> sprite;
+
+                if(! output_sprites.full())
+                {
+                    sprite = sprite_ptr::create_optional(move(builder));
+                }
+
+                sprite_ptr* sprite_ptr = sprite.get();
+
+                if(! sprite_ptr)
+                {
+                    output_sprites.shrink(output_sprites_count);
+                    return false;
+                }
+
+                output_sprites.push_back(move(*sprite_ptr));
+            }
+            else
+            {
+                BN_BASIC_ASSERT(! output_sprites.full(), "output_sprites vector is full,\ncan't hold more sprites");
+
+                output_sprites.push_back(sprite_ptr::create(move(builder)));
+            }
+        }
+
+        return true;
+    }
+#endif
+
+    [[nodiscard]] optional<sprite_tiles_ptr> _allocate_tiles_optional(int tiles_count)
+    {
+        optional<sprite_tiles_ptr> result = sprite_tiles_ptr::allocate_optional(tiles_count, bpp_mode::BPP_4);
+
+        #if BN_CFG_SPRITE_TEXT_CACHE_MAX_ENTRIES > 0
+            while(! result && _erase_least_recently_used_cache_entry())
+            {
+                result = sprite_tiles_ptr::allocate_optional(tiles_count, bpp_mode::BPP_4);
+            }
+        #endif
+
+        return result;
+    }
+
+    [[nodiscard]] sprite_tiles_ptr _allocate_tiles(int tiles_count)
+    {
+        optional<sprite_tiles_ptr> result = _allocate_tiles_optional(tiles_count);
+
+        if(sprite_tiles_ptr* result_ptr = result.get())
+        {
+            return move(*result_ptr);
+        }
+
+        return sprite_tiles_ptr::allocate(tiles_count, bpp_mode::BPP_4);
+    }
+
     template<sprite_size size>
     [[nodiscard]] tile* _build_sprite_optional(
         const sprite_text_generator& generator, const sprite_palette_ptr& palette,
@@ -39,7 +267,7 @@ namespace
             return nullptr;
         }
 
-        optional<sprite_tiles_ptr> tiles = sprite_tiles_ptr::allocate_optional(tiles_count, bpp_mode::BPP_4);
+        optional<sprite_tiles_ptr> tiles = _allocate_tiles_optional(tiles_count);
         sprite_tiles_ptr* tiles_ptr = tiles.get();
 
         if(! tiles_ptr)
@@ -75,7 +303,7 @@ namespace
 
         BN_BASIC_ASSERT(! output_sprites.full(), "output_sprites vector is full,\ncan't hold more sprites");
 
-        sprite_tiles_ptr tiles_ptr = sprite_tiles_ptr::allocate(tiles_count, bpp_mode::BPP_4);
+        sprite_tiles_ptr tiles_ptr = _allocate_tiles(tiles_count);
         optional<span<tile>> tiles_vram = tiles_ptr.vram();
 
         sprite_builder builder(shape_size, move(tiles_ptr), palette);
@@ -1053,26 +1281,20 @@ namespace
             palette_ptr = palette.get();
         }
 
-        fixed_point aligned_position = position;
-
-        switch(generator.alignment())
-        {
-
-        case sprite_text_generator::alignment_type::LEFT:
-            break;
-
-        case sprite_text_generator::alignment_type::CENTER:
-            aligned_position.set_x(aligned_position.x() - (generator.width(text) / 2));
-            break;
-
-        case sprite_text_generator::alignment_type::RIGHT:
-            aligned_position.set_x(aligned_position.x() - generator.width(text));
-            break;
+        #if BN_CFG_SPRITE_TEXT_CACHE_MAX_ENTRIES > 0
+            if(! one_sprite_per_character)
+            {
+                if(const cache_entry_type* cache_entry = _find_cache_entry(generator.font(), text))
+                {
+                    return _generate_from_cache<allow_failure>(
+                                generator, *palette_ptr, position, *cache_entry, output_sprites);
+                }
+            }
+        #endif
 
-        default:
-            BN_ERROR("Invalid alignment: ", int(generator.alignment()));
-            break;
-        }
+        sprite_text_generator::alignment_type alignment = generator.alignment();
+        int text_width = alignment == sprite_text_generator::alignment_type::LEFT ? 0 : generator.width(text);
+        fixed_point aligned_position = _aligned_position(alignment, position, text_width);
 
         const sprite_font& font = generator.font();
         int output_sprites_count = output_sprites.size();
@@ -1159,9 +1381,158 @@ namespace
         {
             output_sprites.shrink(output_sprites_count);
         }
+        #if BN_CFG_SPRITE_TEXT_CACHE_MAX_ENTRIES > 0
+            else if(! one_sprite_per_character)
+            {
+                _insert_cache_entry(generator, text, aligned_position.x(), output_sprites, output_sprites_count);
+            }
+        #endif
 
         return success;
     }
+
+
+    constexpr int update_space_index = -1;
+    constexpr int update_tab_index = -2;
+
+    [[nodiscard]] int _update_graphics_index(const string_view& text, const utf8_characters_map_ref& utf8_characters_map,
+                                             int& text_index)
+    {
+        const char* text_data = text.data();
+        char character = text_data[text_index];
+
+        if(character == ' ')
+        {
+            ++text_index;
+            return update_space_index;
+        }
+
+        if(character == '\t')
+        {
+            ++text_index;
+            return update_tab_index;
+        }
+
+        BN_ASSERT(character >= '!', "Invalid character: ", character, " (text: ", text, ")");
+
+        return _graphics_index(character, utf8_characters_map, text_data, text_index);
+    }
+
+    [[nodiscard]] tile* _exclusive_tiles_vram(sprite_ptr& sprite)
+    {
+        const sprite_tiles_ptr& tiles = sprite.tiles();
+        int tiles_handle = tiles.handle();
+
+        if(sprite_tiles_manager::usages(tiles_handle) > 1)
+        {
+            // Tiles shared with other sprites or with the generated text cache must not be modified:
+            int tiles_count = tiles.tiles_count();
+            sprite_tiles_ptr new_tiles = _allocate_tiles(tiles_count);
+            tile* new_tiles_vram = new_tiles.vram()->data();
+            hw::sprite_tiles::copy_tiles(tiles.vram()->data(), tiles_count, new_tiles_vram);
+            sprite.set_tiles(move(new_tiles));
+            return new_tiles_vram;
+        }
+
+        return sprite_tiles_manager::vram(tiles_handle)->data();
+    }
+
+    template<bool paint>
+    [[nodiscard]] bool _update(const sprite_font& font, const string_view& old_text, const string_view& new_text,
+                               ivector<sprite_ptr>& text_sprites)
+    {
+        constexpr int max_columns_per_sprite = 32;
+        constexpr int tiles_per_sprite_row = max_columns_per_sprite / 8;
+
+        const utf8_characters_map_ref& utf8_characters_map = font.utf8_characters_ref();
+        const sprite_item& item = font.item();
+        const sprite_tiles_item& tiles_item = item.tiles_item();
+        const sprite_shape_size& shape_size = item.shape_size();
+        int tiles_per_character_row = shape_size.width() / 8;
+        int character_rows = shape_size.height() / 8;
+        int max_characters_per_sprite = max_columns_per_sprite / shape_size.width();
+        int sprites_count = text_sprites.size();
+        int old_text_index = 0;
+        int old_text_size = old_text.size();
+        int new_text_index = 0;
+        int new_text_size = new_text.size();
+        int sprite_index = -1;
+        int sprite_character_index = max_characters_per_sprite;
+        int tiles_vram_sprite_index = -1;
+        tile* tiles_vram = nullptr;
+
+        // Characters are laid out like fixed_height_8_painter and fixed_height_16_painter do:
+        while(old_text_index < old_text_size && new_text_index < new_text_size)
+        {
+            int old_graphics_index = _update_graphics_index(old_text, utf8_characters_map, old_text_index);
+            int new_graphics_index = _update_graphics_index(new_text, utf8_characters_map, new_text_index);
+
+            if(old_graphics_index == update_tab_index || new_graphics_index == update_tab_index)
+            {
+                return false;
+            }
+
+            if(sprite_character_index == max_characters_per_sprite)
+            {
+                bool old_space = old_graphics_index == update_space_index;
+
+                if(old_space != (new_graphics_index == update_space_index))
+                {
+                    return false;
+                }
+
+                if(old_space)
+                {
+                    continue;
+                }
+
+                ++sprite_index;
+
+                if(sprite_index == sprites_count)
+                {
+                    return false;
+                }
+
+                sprite_character_index = 0;
+            }
+
+            if(paint && old_graphics_index != new_graphics_index)
+            {
+                if(tiles_vram_sprite_index != sprite_index)
+                {
+                    tiles_vram = _exclusive_tiles_vram(text_sprites[sprite_index]);
+                    tiles_vram_sprite_index = sprite_index;
+                }
+
+                tile* character_tiles_vram = tiles_vram + (sprite_character_index * tiles_per_character_row);
+
+                if(new_graphics_index == update_space_index)
+                {
+                    for(int row = 0; row < character_rows; ++row)
+                    {
+                        hw::sprite_tiles::clear_tiles(tiles_per_character_row,
+                                                      character_tiles_vram + (row * tiles_per_sprite_row));
+                    }
+                }
+                else
+                {
+                    const tile* source_tiles_data = tiles_item.graphics_tiles_ref(new_graphics_index).data();
+
+                    for(int row = 0; row < character_rows; ++row)
+                    {
+                        hw::sprite_tiles::copy_tiles(source_tiles_data + (row * tiles_per_character_row),
+                                                     tiles_per_character_row,
+                                                     character_tiles_vram + (row * tiles_per_sprite_row));
+                    }
+                }
+            }
+
+            ++sprite_character_index;
+        }
+
+        return old_text_index == old_text_size && new_text_index == new_text_size &&
+                sprite_index + 1 == sprites_count;
+    }
 }
 
 sprite_text_generator::sprite_text_generator(const sprite_font& font) :
@@ -1313,6 +1684,30 @@ bool sprite_text_generator::generate_top_left_optional(
     return success;
 }
 
+bool sprite_text_generator::update(const string_view& old_text, const string_view& new_text,
+                                   ivector<sprite_ptr>& text_sprites) const
+{
+    if(_one_sprite_per_character || _font_one_sprite_per_character || ! _font.character_widths_ref().empty())
+    {
+        return false;
+    }
+
+    if(! _update<false>(_font, old_text, new_text, text_sprites))
+    {
+        return false;
+    }
+
+    [[maybe_unused]] bool success = _update<true>(_font, old_text, new_text, text_sprites);
+    return true;
+}
+
+void sprite_text_generator::clear_cache()
+{
+    #if BN_CFG_SPRITE_TEXT_CACHE_MAX_ENTRIES > 0
+        cache_data.entries.clear();
+    #endif
+}
+
 void sprite_text_generator::_init()
 {
     const sprite_shape_size& shape_size = _font.item().shape_size();
@@ -1085,6 +1085,11 @@ void decrease_usages(int id)
     BN_SPRITE_TILES_LOG_STATUS();
 }
 
+int usages(int id)
+{
+    return int(data_ref().items.item(id).usages);
+}
+
 int start_tile(int id)
 {
     return int(data_ref().items.item(id).start_tile);
@@ -1307,14 +1312,29 @@ void commit_compressed()
     {
         BN_SPRITE_TILES_LOG("sprite_tiles_manager - COMMIT COMPRESSED");
 
+        constexpr int max_bytes = BN_CFG_SPRITE_TILES_MAX_COMPRESSED_COMMIT_BYTES;
+        int committed_bytes = 0;
+        int pending_items_count = 0;
+
         for(int item_index : data.to_commit_compressed_items)
         {
             item_type& item = data.items.item(item_index);
-            _hw_commit(item.data, item.compression(), int(item.start_tile), int(item.tiles_count));
-            item.commit = false;
+            int item_bytes = int(item.tiles_count) * int(sizeof(tile));
+
+            if(max_bytes && committed_bytes && committed_bytes + item_bytes > max_bytes)
+            {
+                data.to_commit_compressed_items[pending_items_count] = uint16_t(item_index);
+                ++pending_items_count;
+            }
+            else
+            {
+                _hw_commit(item.data, item.compression(), int(item.start_tile), int(item.tiles_count));
+                item.commit = false;
+                committed_bytes += item_bytes;
+            }
         }
 
-        data.to_commit_compressed_items.clear();
+        data.to_commit_compressed_items.shrink(pending_items_count);
 
         BN_SPRITE_TILES_LOG_STATUS();
     }
@@ -49,6 +49,8 @@ namespace bn::sprite_tiles_manager
 
     void decrease_usages(int id);
 
+    [[nodiscard]] int usages(int id);
+
     [[nodiscard]] int start_tile(int id);
 
     [[nodiscard]] int tiles_count(int id);
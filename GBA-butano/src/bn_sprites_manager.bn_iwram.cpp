@@ -10,14 +10,17 @@
 namespace bn::sprites_manager
 {
 
-void _check_items_on_screen(intrusive_list<sorted_sprites::layer>& layers)
+bool _check_items_on_screen(void* hw_handles, intrusive_list<sorted_sprites::layer>& layers,
+                            int& first_index_to_commit, int& last_index_to_commit)
 {
-    hot::check_items_on_screen(layers);
+    return hot::check_items_on_screen(hw_handles, layers, first_index_to_commit, last_index_to_commit);
 }
 
-int _rebuild_handles_impl(int reserved_handles_count, void* hw_handles, intrusive_list<sorted_sprites::layer>& layers)
+int _rebuild_handles_impl(int reserved_handles_count, void* hw_handles, intrusive_list<sorted_sprites::layer>& layers,
+                          int& first_index_to_commit, int& last_index_to_commit)
 {
-    return hot::rebuild_handles(reserved_handles_count, hw_handles, layers);
+    return hot::rebuild_handles(reserved_handles_count, hw_handles, layers, first_index_to_commit,
+                                last_index_to_commit);
 }
 
 bool _update_cameras_impl(intrusive_list<sorted_sprites::layer>& layers)
@@ -201,10 +201,15 @@ namespace
                 }
             }
 
+            int first_index_to_commit = data.first_index_to_commit;
+            int last_index_to_commit = data.last_index_to_commit;
+
             #if BN_CFG_SPRITES_USE_IWRAM
-                int visible_items_count = _rebuild_handles_impl(reserved_count, handles, data.sorter.layers());
+                int visible_items_count = _rebuild_handles_impl(
+                        reserved_count, handles, data.sorter.layers(), first_index_to_commit, last_index_to_commit);
             #else
-                int visible_items_count = hot::rebuild_handles(reserved_count, handles, data.sorter.layers());
+                int visible_items_count = hot::rebuild_handles(
+                        reserved_count, handles, data.sorter.layers(), first_index_to_commit, last_index_to_commit);
             #endif
 
             BN_BASIC_ASSERT(visible_items_count >= 0, "Too many on screen sprites");
@@ -212,40 +217,25 @@ namespace
             int last_visible_items_count = data.last_visible_items_count;
             data.last_visible_items_count = visible_items_count;
 
-            for(int index = visible_items_count; index < last_visible_items_count; ++index)
+            if(visible_items_count < last_visible_items_count)
             {
-                hw::sprites::hide_and_destroy(handles[index]);
+                for(int index = visible_items_count; index < last_visible_items_count; ++index)
+                {
+                    hw::sprites::hide_and_destroy(handles[index]);
+                }
+
+                first_index_to_commit = min(first_index_to_commit, visible_items_count);
+                last_index_to_commit = max(last_index_to_commit, last_visible_items_count - 1);
             }
 
             if(reload_all_handles) [[unlikely]]
             {
-                data.first_index_to_commit = 0;
-                data.last_index_to_commit = hw::sprites::count() - 1;
+                first_index_to_commit = 0;
+                last_index_to_commit = hw::sprites::count() - 1;
             }
-            else
-            {
-                int to_commit_items_count;
 
-                if(visible_items_count < last_visible_items_count)
-                {
-                    to_commit_items_count = min(last_visible_items_count, hw::sprites::count() - reserved_count);
-                }
-                else
-                {
-                    to_commit_items_count = visible_items_count;
-                }
-
-                if(to_commit_items_count)
-                {
-                    data.first_index_to_commit = reserved_count;
-                    data.last_index_to_commit = reserved_count + to_commit_items_count - 1;
-                }
-                else
-                {
-                    data.first_index_to_commit = hw::sprites::count();
-                    data.last_index_to_commit = 0;
-                }
-            }
+            data.first_index_to_commit = first_index_to_commit;
+            data.last_index_to_commit = last_index_to_commit;
         }
     }
 }
@@ -626,10 +616,8 @@ void set_x(id_type id, fixed x)
 
         if(item->visible)
         {
-            static_data& data = data_ref();
             item->check_on_screen = true;
-            data.check_items_on_screen = true;
-            data.rebuild_handles = true;
+            data_ref().check_items_on_screen = true;
         }
     }
 }
@@ -652,10 +640,8 @@ void set_y(id_type id, fixed y)
 
         if(item->visible)
         {
-            static_data& data = data_ref();
             item->check_on_screen = true;
-            data.check_items_on_screen = true;
-            data.rebuild_handles = true;
+            data_ref().check_items_on_screen = true;
         }
     }
 }
@@ -681,10 +667,8 @@ void set_position(id_type id, const fixed_point& position)
 
         if(item->visible)
         {
-            static_data& data = data_ref();
             item->check_on_screen = true;
-            data.check_items_on_screen = true;
-            data.rebuild_handles = true;
+            data_ref().check_items_on_screen = true;
         }
     }
 }
@@ -975,10 +959,8 @@ void set_camera(id_type id, camera_ptr&& camera)
 
         if(item->visible)
         {
-            static_data& data = data_ref();
             item->check_on_screen = true;
-            data.check_items_on_screen = true;
-            data.rebuild_handles = true;
+            data_ref().check_items_on_screen = true;
         }
     }
 }
@@ -994,10 +976,8 @@ void remove_camera(id_type id)
 
         if(item->visible)
         {
-            static_data& data = data_ref();
             item->check_on_screen = true;
-            data.check_items_on_screen = true;
-            data.rebuild_handles = true;
+            data_ref().check_items_on_screen = true;
         }
     }
 }
@@ -1387,7 +1367,6 @@ void update_cameras()
     if(check_items_on_screen)
     {
         data.check_items_on_screen = true;
-        data.rebuild_handles = true;
     }
 }
 
@@ -1419,10 +1398,17 @@ void update()
         data.check_items_on_screen = false;
 
         #if BN_CFG_SPRITES_USE_IWRAM
-            _check_items_on_screen(data.sorter.layers());
+            bool rebuild_handles = _check_items_on_screen(
+                    data.handles, data.sorter.layers(), data.first_index_to_commit, data.last_index_to_commit);
         #else
-            hot::check_items_on_screen(data.sorter.layers());
+            bool rebuild_handles = hot::check_items_on_screen(
+                    data.handles, data.sorter.layers(), data.first_index_to_commit, data.last_index_to_commit);
         #endif
+
+        if(rebuild_handles)
+        {
+            data.rebuild_handles = true;
+        }
     }
 
     _rebuild_handles();
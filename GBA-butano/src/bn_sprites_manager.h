@@ -228,10 +228,13 @@ namespace sprites_manager
     void commit(bool use_dma);
 
     #if BN_CFG_SPRITES_USE_IWRAM
-        BN_CODE_IWRAM void _check_items_on_screen(intrusive_list<sorted_sprites::layer>& layers);
+        [[nodiscard]] BN_CODE_IWRAM bool _check_items_on_screen(
+                void* hw_handles, intrusive_list<sorted_sprites::layer>& layers, int& first_index_to_commit,
+                int& last_index_to_commit);
 
         [[nodiscard]] BN_CODE_IWRAM int _rebuild_handles_impl(
-                int reserved_handles_count, void* hw_handles, intrusive_list<sorted_sprites::layer>& layers);
+                int reserved_handles_count, void* hw_handles, intrusive_list<sorted_sprites::layer>& layers,
+                int& first_index_to_commit, int& last_index_to_commit);
 
         [[nodiscard]] BN_CODE_IWRAM bool _update_cameras_impl(intrusive_list<sorted_sprites::layer>& layers);
     #endif
@@ -9,8 +9,13 @@
 namespace bn::sprites_manager::hot
 {
 
-inline void check_items_on_screen(intrusive_list<sorted_sprites::layer>& layers)
+[[nodiscard]] inline bool check_items_on_screen(
+        void* hw_handles, intrusive_list<sorted_sprites::layer>& layers, int& first_index_to_commit,
+        int& last_index_to_commit)
 {
+    auto handles = reinterpret_cast<hw::sprites::handle_type*>(hw_handles);
+    bool rebuild_handles = false;
+
     for(sorted_sprites::layer& layer : layers)
     {
         for(sprites_manager_item& item : layer.items())
@@ -34,6 +39,7 @@ inline void check_items_on_screen(intrusive_list<sorted_sprites::layer>& layers)
                 if(item.on_screen != on_screen)
                 {
                     item.on_screen = on_screen;
+                    rebuild_handles = true;
 
                     if(on_screen)
                     {
@@ -51,13 +57,28 @@ inline void check_items_on_screen(intrusive_list<sorted_sprites::layer>& layers)
                         hw::sprites::hide(item.handle);
                     }
                 }
+                else if(on_screen)
+                {
+                    // Visibility hasn't changed, so there's no need to rebuild all handles:
+                    int handles_index = item.handles_index;
+
+                    if(handles_index >= 0)
+                    {
+                        hw::sprites::copy_handle(item.handle, handles[handles_index]);
+                        first_index_to_commit = min(first_index_to_commit, handles_index);
+                        last_index_to_commit = max(last_index_to_commit, handles_index);
+                    }
+                }
             }
         }
     }
+
+    return rebuild_handles;
 }
 
 [[nodiscard]] inline int rebuild_handles(
-        int reserved_handles_count, void* hw_handles, intrusive_list<sorted_sprites::layer>& layers)
+        int reserved_handles_count, void* hw_handles, intrusive_list<sorted_sprites::layer>& layers,
+        int& first_index_to_commit, int& last_index_to_commit)
 {
     auto handles = reinterpret_cast<hw::sprites::handle_type*>(hw_handles);
     int visible_items_count = reserved_handles_count;
@@ -75,7 +96,16 @@ inline void check_items_on_screen(intrusive_list<sorted_sprites::layer>& layers)
                     }
                 #endif
 
-                hw::sprites::copy_handle(item.handle, handles[visible_items_count]);
+                hw::sprites::handle_type& handle = handles[visible_items_count];
+
+                // Only the handles that have changed are committed:
+                if(! hw::sprites::equal_handles(item.handle, handle))
+                {
+                    hw::sprites::copy_handle(item.handle, handle);
+                    first_index_to_commit = min(first_index_to_commit, visible_items_count);
+                    last_index_to_commit = max(last_index_to_commit, visible_items_count);
+                }
+
                 item.handles_index = int8_t(visible_items_count);
                 ++visible_items_count;
             }
@@ -0,0 +1,553 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_sram_journal.h"
+
+#include "bn_span.h"
+#include "bn_timer.h"
+#include "bn_cstring.h"
+#include "bn_algorithm.h"
+
+namespace bn
+{
+
+namespace
+{
+    constexpr int block_size = BN_CFG_SRAM_JOURNAL_BLOCK_SIZE;
+    constexpr unsigned magic = 0x4A534E42; // "BNSJ"
+    constexpr unsigned checksum_seed = 0x5A5A;
+    constexpr unsigned commit_block_index = 0xFFFF;
+    constexpr unsigned compressed_flag = 0x8000;
+
+    static_assert(block_size >= 4);
+    static_assert(block_size <= 1024);
+
+
+    class half_header
+    {
+
+    public:
+        uint32_t magic;
+        uint32_t generation;
+        uint16_t image_size;
+        uint16_t block_size;
+        uint16_t reserved;
+        uint16_t checksum;
+    };
+
+    static_assert(sizeof(half_header) == 16);
+
+
+    class record_header
+    {
+
+    public:
+        uint32_t generation;
+        uint16_t block_index;
+        uint16_t stored_size;
+        uint16_t reserved;
+        uint16_t checksum;
+    };
+
+    static_assert(sizeof(record_header) == 12);
+
+
+    constexpr int half_header_size = int(sizeof(half_header));
+    constexpr int record_header_size = int(sizeof(record_header));
+
+
+    // BSD checksum:
+    [[nodiscard]] unsigned _checksum(const void* data, int bytes, unsigned checksum)
+    {
+        auto data_ptr = static_cast<const uint8_t*>(data);
+
+        for(int index = 0; index < bytes; ++index)
+        {
+            checksum = (checksum >> 1) + ((checksum & 1) << 15);
+            checksum = (checksum + data_ptr[index]) & 0xFFFF;
+        }
+
+        return checksum;
+    }
+
+    [[nodiscard]] unsigned _checksum(const half_header& header)
+    {
+        return _checksum(&header, half_header_size - 2, checksum_seed);
+    }
+
+    [[nodiscard]] unsigned _checksum(const record_header& header, const uint8_t* data)
+    {
+        unsigned result = _checksum(&header, record_header_size - 2, checksum_seed);
+        return _checksum(data, header.stored_size & ~compressed_flag, result);
+    }
+
+    [[nodiscard]] bool _run(const uint8_t* data, int index, int size)
+    {
+        return index + 2 < size && data[index] == data[index + 1] && data[index] == data[index + 2];
+    }
+
+    // Run-length compression: control bytes lower than 128 are followed by (control + 1) literal bytes,
+    // the rest are followed by a byte repeated (control - 125) times.
+    // Returns 0 if the compressed size is not lower than the original one:
+    [[nodiscard]] int _compress(const uint8_t* source, int source_size, uint8_t* destination)
+    {
+        int source_index = 0;
+        int destination_index = 0;
+
+        while(source_index < source_size)
+        {
+            if(_run(source, source_index, source_size))
+            {
+                uint8_t value = source[source_index];
+                int count = 3;
+
+                while(count < 130 && source_index + count < source_size && source[source_index + count] == value)
+                {
+                    ++count;
+                }
+
+                if(destination_index + 2 >= source_size)
+                {
+                    return 0;
+                }
+
+                destination[destination_index] = uint8_t(count + 125);
+                destination[destination_index + 1] = value;
+                destination_index += 2;
+                source_index += count;
+            }
+            else
+            {
+                int literal_index = source_index;
+                int count = 0;
+
+                do
+                {
+                    ++source_index;
+                    ++count;
+                }
+                while(count < 128 && source_index < source_size && ! _run(source, source_index, source_size));
+
+                if(destination_index + count + 1 >= source_size)
+                {
+                    return 0;
+                }
+
+                destination[destination_index] = uint8_t(count - 1);
+                memcpy(destination + destination_index + 1, source + literal_index, count);
+                destination_index += count + 1;
+            }
+        }
+
+        return destination_index;
+    }
+
+    [[nodiscard]] bool _decompress(const uint8_t* source, int source_size, uint8_t* destination,
+                                   int destination_size)
+    {
+        int source_index = 0;
+        int destination_index = 0;
+
+        while(source_index < source_size)
+        {
+            int control = source[source_index];
+            ++source_index;
+
+            if(control < 128)
+            {
+                int count = control + 1;
+
+                if(source_index + count > source_size || destination_index + count > destination_size)
+                {
+                    return false;
+                }
+
+                memcpy(destination + destination_index, source + source_index, count);
+                source_index += count;
+                destination_index += count;
+            }
+            else
+            {
+                int count = control - 125;
+
+                if(source_index == source_size || destination_index + count > destination_size)
+                {
+                    return false;
+                }
+
+                memset(destination + destination_index, source[source_index], count);
+                ++source_index;
+                destination_index += count;
+            }
+        }
+
+        return destination_index == destination_size;
+    }
+}
+
+isram_journal::isram_journal(uint8_t* image, int image_size, int offset, int size) :
+    _image(image),
+    _image_size(image_size),
+    _offset(offset),
+    _size(size)
+{
+    BN_ASSERT(image_size > 0, "Invalid image size: ", image_size);
+    BN_ASSERT(offset >= 0, "Invalid offset: ", offset);
+    BN_ASSERT(size > 0, "Invalid size: ", size);
+    BN_ASSERT(size + offset <= sram::size(), "Size and offset are too high: ", size, " - ", offset);
+
+    int blocks_count = _blocks_count();
+    BN_ASSERT(blocks_count < int(commit_block_index), "Too many blocks: ", blocks_count);
+
+    // Compression can't reduce the size of every block, so a half must be able to store an uncompressed snapshot:
+    int min_half_size = half_header_size + (blocks_count * record_header_size) + image_size + record_header_size;
+    BN_ASSERT(size / 2 >= min_half_size, "Size is too low: ", size, " - ", min_half_size * 2);
+}
+
+bool isram_journal::_read(void* destination)
+{
+    half_header headers[2];
+    bool valid_headers[2];
+    unsigned max_generation = 0;
+
+    for(int half_index = 0; half_index < 2; ++half_index)
+    {
+        half_header& header = headers[half_index];
+        sram::read_offset(header, _half_offset(half_index));
+
+        bool valid = header.magic == magic && header.generation &&
+                int(header.image_size) == _image_size && int(header.block_size) == block_size &&
+                header.checksum == _checksum(header);
+        valid_headers[half_index] = valid;
+
+        if(valid)
+        {
+            max_generation = max(max_generation, unsigned(header.generation));
+        }
+    }
+
+    bool second_half_first = valid_headers[1] &&
+            (! valid_headers[0] || headers[1].generation > headers[0].generation);
+    int first_half_index = second_half_first ? 1 : 0;
+    _next_generation = max_generation + 1;
+    _loaded = true;
+
+    for(int candidate_index = 0; candidate_index < 2; ++candidate_index)
+    {
+        int half_index = first_half_index ^ candidate_index;
+
+        if(valid_headers[half_index])
+        {
+            unsigned generation = headers[half_index].generation;
+            int end_position;
+            int commit_position = _replay(half_index, generation, 0, end_position);
+
+            if(commit_position > 0)
+            {
+                memclear(_image, _image_size);
+
+                int applied_end_position;
+                [[maybe_unused]] int applied_commit_position = _replay(
+                        half_index, generation, commit_position, applied_end_position);
+                BN_BASIC_ASSERT(applied_commit_position == commit_position, "Journal replay failed");
+
+                _half_index = half_index;
+                _generation = generation;
+
+                // Uncommitted records after the last commit force a snapshot in the next write,
+                // so they can't be mistaken for new ones:
+                _position = end_position == commit_position && generation == max_generation ? commit_position : -1;
+                memcpy(destination, _image, _image_size);
+                return true;
+            }
+        }
+    }
+
+    memclear(_image, _image_size);
+    _half_index = 1;
+    _position = -1;
+    return false;
+}
+
+int isram_journal::_changed_blocks_count(const void* source) const
+{
+    BN_BASIC_ASSERT(_loaded, "Journal has not been read");
+
+    auto source_data = static_cast<const uint8_t*>(source);
+    int blocks_count = _blocks_count();
+    int result = 0;
+
+    for(int block_index = 0; block_index < blocks_count; ++block_index)
+    {
+        int block_offset = block_index * block_size;
+        const uint8_t* source_block = source_data + block_offset;
+
+        if(! equal(source_block, source_block + _block_size(block_index), _image + block_offset))
+        {
+            ++result;
+        }
+    }
+
+    return result;
+}
+
+void isram_journal::_write(const void* source)
+{
+    BN_BASIC_ASSERT(_loaded, "Journal has not been read");
+
+    timer timer;
+    auto source_data = static_cast<const uint8_t*>(source);
+    int blocks_count = _blocks_count();
+    int written_bytes = 0;
+    int position = _position;
+
+    if(position >= 0)
+    {
+        int required_bytes = record_header_size;
+        int changed_blocks_count = 0;
+
+        #if BN_CFG_SRAM_JOURNAL_COMPRESSION
+            uint8_t stored_data[block_size];
+        #endif
+
+        for(int block_index = 0; block_index < blocks_count; ++block_index)
+        {
+            int block_offset = block_index * block_size;
+            int current_block_size = _block_size(block_index);
+            const uint8_t* source_block = source_data + block_offset;
+
+            if(! equal(source_block, source_block + current_block_size, _image + block_offset))
+            {
+                #if BN_CFG_SRAM_JOURNAL_COMPRESSION
+                    int stored_size = _compress(source_block, current_block_size, stored_data);
+                #else
+                    int stored_size = 0;
+                #endif
+
+                required_bytes += record_header_size + (stored_size ? stored_size : current_block_size);
+                ++changed_blocks_count;
+            }
+        }
+
+        if(! changed_blocks_count)
+        {
+            _last_write_bytes = 0;
+            _last_write_ticks = timer.elapsed_ticks();
+            return;
+        }
+
+        if(position + required_bytes <= _size / 2)
+        {
+            for(int block_index = 0; block_index < blocks_count; ++block_index)
+            {
+                int block_offset = block_index * block_size;
+                int current_block_size = _block_size(block_index);
+                const uint8_t* source_block = source_data + block_offset;
+                uint8_t* image_block = _image + block_offset;
+
+                if(! equal(source_block, source_block + current_block_size, image_block))
+                {
+                    memcpy(image_block, source_block, current_block_size);
+                    position = _write_block(block_index, position);
+                }
+            }
+
+            _write_commit(position);
+            position += record_header_size;
+            written_bytes = position - _position;
+            _position = position;
+        }
+        else
+        {
+            position = -1;
+        }
+    }
+
+    if(position < 0)
+    {
+        memcpy(_image, source_data, _image_size);
+        _write_snapshot();
+        written_bytes = _position;
+    }
+
+    _last_write_bytes = written_bytes;
+    _last_write_ticks = timer.elapsed_ticks();
+}
+
+int isram_journal::_block_size(int block_index) const
+{
+    return min(block_size, _image_size - (block_index * block_size));
+}
+
+int isram_journal::_replay(int half_index, unsigned generation, int apply_end_position, int& end_position)
+{
+    int half_offset = _half_offset(half_index);
+    int half_size = _size / 2;
+    int blocks_count = _blocks_count();
+    int position = half_header_size;
+    int commit_position = -1;
+    uint8_t stored_data[block_size];
+    uint8_t block_data[block_size];
+
+    while(position + record_header_size <= half_size)
+    {
+        if(apply_end_position && position >= apply_end_position)
+        {
+            break;
+        }
+
+        record_header header;
+        sram::read_offset(header, half_offset + position);
+
+        if(header.generation != generation)
+        {
+            break;
+        }
+
+        if(header.block_index == commit_block_index)
+        {
+            if(header.stored_size || header.checksum != _checksum(header, nullptr))
+            {
+                break;
+            }
+
+            position += record_header_size;
+            commit_position = position;
+        }
+        else
+        {
+            int block_index = header.block_index;
+
+            if(block_index >= blocks_count)
+            {
+                break;
+            }
+
+            int current_block_size = _block_size(block_index);
+            int stored_size = header.stored_size & ~compressed_flag;
+            bool compressed = header.stored_size & compressed_flag;
+
+            if(compressed ? stored_size >= current_block_size : stored_size != current_block_size)
+            {
+                break;
+            }
+
+            if(position + record_header_size + stored_size > half_size)
+            {
+                break;
+            }
+
+            span<uint8_t> stored_data_span(stored_data, stored_size);
+            sram::read_span_offset(stored_data_span, half_offset + position + record_header_size);
+
+            if(header.checksum != _checksum(header, stored_data))
+            {
+                break;
+            }
+
+            if(compressed)
+            {
+                if(! _decompress(stored_data, stored_size, block_data, current_block_size))
+                {
+                    break;
+                }
+            }
+            else
+            {
+                memcpy(block_data, stored_data, current_block_size);
+            }
+
+            if(apply_end_position)
+            {
+                memcpy(_image + (block_index * block_size), block_data, current_block_size);
+            }
+
+            position += record_header_size + stored_size;
+        }
+    }
+
+    end_position = position;
+    return commit_position;
+}
+
+int isram_journal::_write_block(int block_index, int position)
+{
+    alignas(int) uint8_t record_data[record_header_size + block_size];
+    uint8_t* stored_data = record_data + record_header_size;
+    const uint8_t* block_data = _image + (block_index * block_size);
+    int current_block_size = _block_size(block_index);
+
+    #if BN_CFG_SRAM_JOURNAL_COMPRESSION
+        int stored_size = _compress(block_data, current_block_size, stored_data);
+    #else
+        int stored_size = 0;
+    #endif
+
+    record_header header;
+    header.generation = _generation;
+    header.block_index = uint16_t(block_index);
+    header.reserved = 0;
+
+    if(stored_size)
+    {
+        header.stored_size = uint16_t(stored_size | compressed_flag);
+    }
+    else
+    {
+        stored_size = current_block_size;
+        header.stored_size = uint16_t(stored_size);
+        memcpy(stored_data, block_data, stored_size);
+    }
+
+    header.checksum = uint16_t(_checksum(header, stored_data));
+
+    int record_size = record_header_size + stored_size;
+    BN_BASIC_ASSERT(position + record_size + record_header_size <= _size / 2, "Journal is full");
+
+    memcpy(record_data, &header, record_header_size);
+    _bn::sram::unsafe_write(record_data, record_size, _half_offset(_half_index) + position);
+    return position + record_size;
+}
+
+void isram_journal::_write_commit(int position)
+{
+    record_header header;
+    header.generation = _generation;
+    header.block_index = uint16_t(commit_block_index);
+    header.stored_size = 0;
+    header.reserved = 0;
+    header.checksum = uint16_t(_checksum(header, nullptr));
+    sram::write_offset(header, _half_offset(_half_index) + position);
+}
+
+void isram_journal::_write_snapshot()
+{
+    int half_index = _half_index ^ 1;
+    unsigned generation = _next_generation;
+    _next_generation = generation + 1;
+    _half_index = half_index;
+    _generation = generation;
+
+    half_header header;
+    header.magic = magic;
+    header.generation = generation;
+    header.image_size = uint16_t(_image_size);
+    header.block_size = uint16_t(block_size);
+    header.reserved = 0;
+    header.checksum = uint16_t(_checksum(header));
+    sram::write_offset(header, _half_offset(half_index));
+
+    int position = half_header_size;
+
+    for(int block_index = 0, blocks_count = _blocks_count(); block_index < blocks_count; ++block_index)
+    {
+        position = _write_block(block_index, position);
+    }
+
+    _write_commit(position);
+    _position = position + record_header_size;
+}
+
+}
@@ -17,12 +17,13 @@ if __name__ == "__main__":
     parser.add_argument('--dmg_audio_backend', required=True, help='dmg audio playback backend')
     parser.add_argument('--graphics', required=True, help='graphics folder and file paths')
     parser.add_argument('--build', required=True, help='build folder path')
+    parser.add_argument('--cache', default='', help='shared assets cache folder path (optional)')
 
     try:
         args = parser.parse_args()
         process_audio(args.audio_backend, args.audio_tool, args.audio, args.build)
         process_dmg_audio(args.dmg_audio_backend, args.dmg_audio, args.build)
-        process_graphics(args.grit, args.graphics, args.build)
+        process_graphics(args.grit, args.graphics, args.build, args.cache)
     except Exception as ex:
         sys.stderr.write('Error: ' + str(ex) + '\n')
         traceback.print_exc()
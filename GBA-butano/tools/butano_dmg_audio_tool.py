@@ -13,13 +13,15 @@ from pool import create_pool
 
 class DmgAudioFileInfo:
 
-    def __init__(self, json_file_path, file_path, file_name, file_name_no_ext, file_name_ext, file_info_path):
+    def __init__(self, json_file_path, file_path, file_name, file_name_no_ext, file_name_ext, file_info_path,
+                 file_info):
         self.__json_file_path = json_file_path
         self.__file_path = file_path
         self.__file_name = file_name
         self.__file_name_no_ext = file_name_no_ext
         self.__file_name_ext = file_name_ext
         self.__file_info_path = file_info_path
+        self.__file_info = file_info
         self.__import_instruments = False
         self.__mod_speed_conversion = True
 
@@ -63,9 +65,7 @@ class DmgAudioFileInfo:
 
             header_file_path = self.__write_header(build_folder_path, output_tag, music_type)
 
-            with open(self.__file_info_path, 'w') as file_info:
-                file_info.write('')
-
+            self.__file_info.write(self.__file_info_path)
             return [self.__file_name, header_file_path, file_size]
         except Exception as exc:
             if os.path.exists(output_file_name):
@@ -211,21 +211,15 @@ def list_dmg_audio_file_infos(audio_paths, build_folder_path):
                 else:
                     file_info_path += '_dmg_audio_without_json_file_info.txt'
 
-                if not os.path.exists(file_info_path):
-                    build = True
+                if json_file_path is not None:
+                    file_info = FileInfo.build_from_files([audio_file_path, json_file_path])
                 else:
-                    file_info_mtime = os.path.getmtime(file_info_path)
-                    audio_file_mtime = os.path.getmtime(audio_file_path)
-                    build = file_info_mtime < audio_file_mtime
-
-                    if not build and json_file_path is not None:
-                        json_file_mtime = os.path.getmtime(json_file_path)
-                        build = file_info_mtime < json_file_mtime
+                    file_info = FileInfo.build_from_files([audio_file_path])
 
-                if build:
+                if FileInfo.read(file_info_path) != file_info:
                     audio_file_infos.append(DmgAudioFileInfo(
                         json_file_path, audio_file_path, audio_file_name, audio_file_name_no_ext, audio_file_name_ext,
-                        file_info_path))
+                        file_info_path, file_info))
 
     return audio_file_infos
 
@@ -10,8 +10,9 @@ import string
 import subprocess
 import sys
 
+import compressor
 from bmp import BMP
-from file_info import FileInfo
+from file_info import FileCache, FileInfo
 from pool import create_pool
 
 
@@ -109,11 +110,180 @@ def append_compression_command(tag, compression, command):
         command.append('-' + tag + 'zh')
 
 
+def tiles_report(tiles_count, source_tiles_count):
+    return 'tiles: ' + str(tiles_count) + ' of ' + str(source_tiles_count) + ' (' + \
+        str(source_tiles_count - tiles_count) + ' removed by reduction)'
+
+
 def remove_file(file_path):
     if os.path.exists(file_path):
         os.remove(file_path)
 
 
+def compression_candidates(compression):
+    if compression == 'auto':
+        return ['none', 'run_length', 'lz77', 'huffman']
+
+    if compression == 'auto_no_huffman':
+        return ['none', 'run_length', 'lz77']
+
+    return [compression]
+
+
+def run_grit_command(grit, command):
+    try:
+        subprocess.check_output(command, shell=True, stderr=subprocess.STDOUT)
+    except subprocess.CalledProcessError as e:
+        raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
+
+
+_GRIT_ARRAY_UNITS = {'.byte': 1, '.hword': 2, '.word': 4}
+
+
+def read_grit_array(grit_file_path, array_name):
+    """Returns the directive and the data of the given array of the grit assembly output, or None if it's not found."""
+
+    directive = None
+    data = bytearray()
+
+    with open(grit_file_path + '.s', 'r') as grit_file:
+        for grit_line in grit_file:
+            grit_line = grit_line.strip()
+
+            if directive is None:
+                if grit_line == array_name + ':':
+                    directive = ''
+            else:
+                grit_words = grit_line.split(None, 1)
+
+                if len(grit_words) != 2 or grit_words[0] not in _GRIT_ARRAY_UNITS:
+                    break
+
+                directive = grit_words[0]
+                unit = _GRIT_ARRAY_UNITS[directive]
+
+                for value in grit_words[1].split(','):
+                    data.extend(int(value, 0).to_bytes(unit, 'little'))
+
+    if not directive:
+        return None
+
+    return directive, bytes(data)
+
+
+def write_grit_arrays(grit_file_path, arrays):
+    """Replaces the data of the given arrays of the grit output.
+
+    arrays is a dictionary with the array names as keys, and (directive, old data, new data) tuples as values."""
+
+    def replace_total_size(match):
+        total_size_terms = match.group(2).split(' + ')
+        total_size = int(match.group(3))
+
+        for directive, old_data, new_data in arrays.values():
+            if str(len(old_data)) in total_size_terms:
+                total_size_terms[total_size_terms.index(str(len(old_data)))] = str(len(new_data))
+
+            total_size += len(new_data) - len(old_data)
+
+        return match.group(1) + ' + '.join(total_size_terms) + ' = ' + str(total_size)
+
+    with open(grit_file_path + '.s', 'r') as grit_file:
+        grit_lines = grit_file.read().splitlines()
+
+    output_lines = []
+    line_index = 0
+
+    while line_index < len(grit_lines):
+        grit_line = grit_lines[line_index]
+        output_lines.append(grit_line)
+        line_index += 1
+        array_name = grit_line.strip()[:-1]
+
+        if grit_line.strip().endswith(':') and array_name in arrays:
+            directive, old_data, new_data = arrays[array_name]
+            unit = _GRIT_ARRAY_UNITS[directive]
+            values_per_line = 32 // unit
+
+            while line_index < len(grit_lines) and grit_lines[line_index].split(None, 1)[:1] == [directive]:
+                line_index += 1
+
+            values = ['0x%0*X' % (unit * 2, int.from_bytes(new_data[index:index + unit], 'little'))
+                      for index in range(0, len(new_data), unit)]
+
+            for values_index in range(0, len(values), values_per_line):
+                output_lines.append('\t' + directive + ' ' + ','.join(values[values_index:values_index +
+                                                                                  values_per_line]))
+
+    grit_data = '\n'.join(output_lines) + '\n'
+
+    for array_name, (directive, old_data, new_data) in arrays.items():
+        grit_data = re.sub(r'(\.global\s+' + array_name + r'\s+@\s*)[0-9]+', r'\g<1>' + str(len(new_data)),
+                           grit_data)
+
+    grit_data = re.sub(r'(Total size: )([0-9 +]+?) = ([0-9]+)', replace_total_size, grit_data)
+
+    with open(grit_file_path + '.s', 'w') as grit_file:
+        grit_file.write(grit_data)
+
+    with open(grit_file_path + '.h', 'r') as grit_file:
+        grit_data = grit_file.read()
+
+    for array_name, (directive, old_data, new_data) in arrays.items():
+        unit = _GRIT_ARRAY_UNITS[directive]
+        grit_data = re.sub(r'(#define\s+' + array_name + r'Len\s+)[0-9]+', r'\g<1>' + str(len(new_data)), grit_data)
+        grit_data = re.sub(r'(\b' + array_name + r'\[)[0-9]+]', r'\g<1>' + str(len(new_data) // unit) + ']',
+                           grit_data)
+
+    grit_data = re.sub(r'(Total size: )([0-9 +]+?) = ([0-9]+)', replace_total_size, grit_data)
+
+    with open(grit_file_path + '.h', 'w') as grit_file:
+        grit_file.write(grit_data)
+
+
+def select_compressions(grit, compressions, array_names, build_folder_path, file_name_no_ext, grit_command):
+    """Replaces the auto compressions with the candidate which gives the smallest output.
+
+    grit_command(compressions, output_file_path) returns the grit command line for the given compressions.
+    array_names contains the name suffix of the grit array of each compression ('Tiles', 'Pal', 'Map' or 'Bitmap').
+
+    grit runs only once, with the auto compressions set to none. Then each auto compressed array is read from the grit
+    output, every candidate is compressed in memory with the BIOS compatible compressors of compressor.py and only the
+    smallest one is written back. Arrays not generated by grit keep their compression set to none.
+
+    Returns the selected compressions, with their output already generated in the build folder."""
+
+    grit_file_path = build_folder_path + '/' + file_name_no_ext + '_bn_gfx'
+    selected_compressions = [compression_candidates(compression)[0] for compression in compressions]
+    run_grit_command(grit, grit_command(selected_compressions, grit_file_path))
+
+    arrays = {}
+
+    for index, compression in enumerate(compressions):
+        if compression.startswith('auto'):
+            array_name = file_name_no_ext + '_bn_gfx' + array_names[index]
+            grit_array = read_grit_array(grit_file_path, array_name)
+
+            if grit_array is not None:
+                directive, data = grit_array
+                selected_data = data
+
+                for candidate in compression_candidates(compression)[1:]:
+                    candidate_data = compressor.compress(data, candidate)
+
+                    if candidate_data is not None and len(candidate_data) < len(selected_data):
+                        selected_compressions[index] = candidate
+                        selected_data = candidate_data
+
+                if selected_data is not data:
+                    arrays[array_name] = (directive, data, selected_data)
+
+    if len(arrays):
+        write_grit_arrays(grit_file_path, arrays)
+
+    return selected_compressions
+
+
 class SpriteItem:
 
     @staticmethod
@@ -223,54 +393,13 @@ class SpriteItem:
                 self.__palette_compression = 'none'
 
     def process(self, grit):
-        tiles_compression = self.__tiles_compression
-        palette_compression = self.__palette_compression
-
-        if tiles_compression.startswith('auto'):
-            test_huffman = tiles_compression == 'auto'
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'none', None)
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'run_length',
-                                                                         file_size)
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'lz77', file_size)
-
-            if test_huffman:
-                tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'huffman',
-                                                                             file_size)
-
-        if palette_compression.startswith('auto'):
-            test_huffman = palette_compression == 'auto'
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'none', None)
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'run_length',
-                                                                             file_size)
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'lz77',
-                                                                             file_size)
-
-            if test_huffman:
-                palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'huffman',
-                                                                                 file_size)
-
-        self.__execute_command(grit, tiles_compression, palette_compression)
-        return self.__write_header(tiles_compression, palette_compression, False)
+        item_compressions = [self.__tiles_compression, self.__palette_compression]
+        tiles_compression, palette_compression = select_compressions(
+            grit, item_compressions, ('Tiles', 'Pal'), self.__build_folder_path, self.__file_name_no_ext,
+            lambda compressions, output_file_path: self.__grit_command(grit, *compressions, output_file_path))
+        return self.__write_header(tiles_compression, palette_compression)
 
-    def __test_tiles_compression(self, grit, best_tiles_compression, new_tiles_compression, best_file_size):
-        self.__execute_command(grit, new_tiles_compression, 'none')
-        new_file_size = self.__write_header(new_tiles_compression, 'none', True)
-
-        if best_file_size is None or new_file_size < best_file_size:
-            return new_tiles_compression, new_file_size
-
-        return best_tiles_compression, best_file_size
-
-    def __test_palette_compression(self, grit, best_palette_compression, new_palette_compression, best_file_size):
-        self.__execute_command(grit, 'none', new_palette_compression)
-        new_file_size = self.__write_header('none', new_palette_compression, True)
-
-        if best_file_size is None or new_file_size < best_file_size:
-            return new_palette_compression, new_file_size
-
-        return best_palette_compression, best_file_size
-
-    def __write_header(self, tiles_compression, palette_compression, skip_write):
+    def __write_header(self, tiles_compression, palette_compression):
         name = self.__file_name_no_ext
         grit_file_path = self.__build_folder_path + '/' + name + '_bn_gfx.h'
         header_file_path = self.__build_folder_path + '/bn_sprite_items_' + name + '.h'
@@ -292,10 +421,7 @@ class SpriteItem:
                 if 'Total size:' in grit_line:
                     total_size = int(grit_line.split()[-1])
 
-                    if skip_write:
-                        return total_size
-                    else:
-                        break
+                    break
 
         remove_file(grit_file_path)
 
@@ -334,7 +460,7 @@ class SpriteItem:
 
         return total_size, header_file_path
 
-    def __execute_command(self, grit, tiles_compression, palette_compression):
+    def __grit_command(self, grit, tiles_compression, palette_compression, output_file_path):
         command = [grit, self.__file_path, '-gt', '-pe' + str(self.__colors_count), '-Mw', str(self.__width / 8),
                    '-Mh', str(self.__height / 8)]
 
@@ -345,13 +471,8 @@ class SpriteItem:
 
         append_compression_command('g', tiles_compression, command)
         append_compression_command('p', palette_compression, command)
-        command.append('-o' + self.__build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx')
-        command = ' '.join(command)
-
-        try:
-            subprocess.check_output(command, shell=True, stderr=subprocess.STDOUT)
-        except subprocess.CalledProcessError as e:
-            raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
+        command.append('-o' + output_file_path)
+        return ' '.join(command)
 
 
 class SpriteTilesItem:
@@ -396,30 +517,13 @@ class SpriteTilesItem:
             self.__compression = 'none'
 
     def process(self, grit):
-        compression = self.__compression
-
-        if compression.startswith('auto'):
-            test_huffman = compression == 'auto'
-            compression, file_size = self.__test_compression(grit, compression, 'none', None)
-            compression, file_size = self.__test_compression(grit, compression, 'run_length', file_size)
-            compression, file_size = self.__test_compression(grit, compression, 'lz77', file_size)
-
-            if test_huffman:
-                compression, file_size = self.__test_compression(grit, compression, 'huffman', file_size)
-
-        self.__execute_command(grit, compression)
-        return self.__write_header(compression, False)
+        item_compressions = [self.__compression]
+        compression = select_compressions(
+            grit, item_compressions, ('Tiles',), self.__build_folder_path, self.__file_name_no_ext,
+            lambda compressions, output_file_path: self.__grit_command(grit, *compressions, output_file_path))[0]
+        return self.__write_header(compression)
 
-    def __test_compression(self, grit, best_compression, new_compression, best_file_size):
-        self.__execute_command(grit, new_compression)
-        new_file_size = self.__write_header(new_compression, True)
-
-        if best_file_size is None or new_file_size < best_file_size:
-            return new_compression, new_file_size
-
-        return best_compression, best_file_size
-
-    def __write_header(self, compression, skip_write):
+    def __write_header(self, compression):
         name = self.__file_name_no_ext
         grit_file_path = self.__build_folder_path + '/' + name + '_bn_gfx.h'
         header_file_path = self.__build_folder_path + '/bn_sprite_tiles_items_' + name + '.h'
@@ -440,10 +544,7 @@ class SpriteTilesItem:
                 if 'Total size:' in grit_line:
                     total_size = int(grit_line.split()[-1])
 
-                    if skip_write:
-                        return total_size
-                    else:
-                        break
+                    break
 
         remove_file(grit_file_path)
 
@@ -481,7 +582,7 @@ class SpriteTilesItem:
 
         return total_size, header_file_path
 
-    def __execute_command(self, grit, compression):
+    def __grit_command(self, grit, compression, output_file_path):
         command = [grit, self.__file_path, '-gt', '-p!', '-Mw', str(self.__width / 8), '-Mh', str(self.__height / 8)]
 
         if self.__bpp_8:
@@ -490,13 +591,8 @@ class SpriteTilesItem:
             command.append('-gB4')
 
         append_compression_command('g', compression, command)
-        command.append('-o' + self.__build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx')
-        command = ' '.join(command)
-
-        try:
-            subprocess.check_output(command, shell=True, stderr=subprocess.STDOUT)
-        except subprocess.CalledProcessError as e:
-            raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
+        command.append('-o' + output_file_path)
+        return ' '.join(command)
 
 
 class SpritePaletteItem:
@@ -516,30 +612,13 @@ class SpritePaletteItem:
             self.__compression = 'none'
 
     def process(self, grit):
-        compression = self.__compression
-
-        if compression.startswith('auto'):
-            test_huffman = compression == 'auto'
-            compression, file_size = self.__test_compression(grit, compression, 'none', None)
-            compression, file_size = self.__test_compression(grit, compression, 'run_length', file_size)
-            compression, file_size = self.__test_compression(grit, compression, 'lz77', file_size)
+        item_compressions = [self.__compression]
+        compression = select_compressions(
+            grit, item_compressions, ('Pal',), self.__build_folder_path, self.__file_name_no_ext,
+            lambda compressions, output_file_path: self.__grit_command(grit, *compressions, output_file_path))[0]
+        return self.__write_header(compression)
 
-            if test_huffman:
-                compression, file_size = self.__test_compression(grit, compression, 'huffman', file_size)
-
-        self.__execute_command(grit, compression)
-        return self.__write_header(compression, False)
-
-    def __test_compression(self, grit, best_compression, new_compression, best_file_size):
-        self.__execute_command(grit, new_compression)
-        new_file_size = self.__write_header(new_compression, True)
-
-        if best_file_size is None or new_file_size < best_file_size:
-            return new_compression, new_file_size
-
-        return best_compression, best_file_size
-
-    def __write_header(self, compression, skip_write):
+    def __write_header(self, compression):
         name = self.__file_name_no_ext
         grit_file_path = self.__build_folder_path + '/' + name + '_bn_gfx.h'
         header_file_path = self.__build_folder_path + '/bn_sprite_palette_items_' + name + '.h'
@@ -552,10 +631,7 @@ class SpritePaletteItem:
                 if 'Total size:' in grit_line:
                     total_size = int(grit_line.split()[-1])
 
-                    if skip_write:
-                        return total_size
-                    else:
-                        break
+                    break
 
         remove_file(grit_file_path)
 
@@ -587,16 +663,11 @@ class SpritePaletteItem:
 
         return total_size, header_file_path
 
-    def __execute_command(self, grit, compression):
+    def __grit_command(self, grit, compression, output_file_path):
         command = [grit, self.__file_path, '-g!', '-pe' + str(self.__colors_count)]
         append_compression_command('p', compression, command)
-        command.append('-o' + self.__build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx')
-        command = ' '.join(command)
-
-        try:
-            subprocess.check_output(command, shell=True, stderr=subprocess.STDOUT)
-        except subprocess.CalledProcessError as e:
-            raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
+        command.append('-o' + output_file_path)
+        return ' '.join(command)
 
 
 class RegularBgItem:
@@ -730,73 +801,13 @@ class RegularBgItem:
                 self.__map_compression = 'none'
 
     def process(self, grit):
-        tiles_compression = self.__tiles_compression
-        palette_compression = self.__palette_compression
-        map_compression = self.__map_compression
-
-        if tiles_compression.startswith('auto'):
-            test_huffman = tiles_compression == 'auto'
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'none', None)
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'run_length',
-                                                                         file_size)
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'lz77', file_size)
-
-            if test_huffman:
-                tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'huffman',
-                                                                             file_size)
-
-        if palette_compression.startswith('auto'):
-            test_huffman = palette_compression == 'auto'
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'none', None)
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'run_length',
-                                                                             file_size)
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'lz77',
-                                                                             file_size)
-
-            if test_huffman:
-                palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'huffman',
-                                                                                 file_size)
-
-        if map_compression.startswith('auto'):
-            test_huffman = map_compression == 'auto'
-            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'none', None)
-            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'run_length', file_size)
-            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'lz77', file_size)
-
-            if test_huffman:
-                map_compression, file_size = self.__test_map_compression(grit, map_compression, 'huffman', file_size)
-
-        self.__execute_command(grit, tiles_compression, palette_compression, map_compression)
-        return self.__write_header(tiles_compression, palette_compression, map_compression, False)
-
-    def __test_tiles_compression(self, grit, best_tiles_compression, new_tiles_compression, best_file_size):
-        self.__execute_command(grit, new_tiles_compression, 'none', 'none')
-        new_file_size = self.__write_header(new_tiles_compression, 'none', 'none', True)
-
-        if best_file_size is None or new_file_size < best_file_size:
-            return new_tiles_compression, new_file_size
-
-        return best_tiles_compression, best_file_size
-
-    def __test_palette_compression(self, grit, best_palette_compression, new_palette_compression, best_file_size):
-        self.__execute_command(grit, 'none', new_palette_compression, 'none')
-        new_file_size = self.__write_header('none', new_palette_compression, 'none', True)
+        item_compressions = [self.__tiles_compression, self.__palette_compression, self.__map_compression]
+        tiles_compression, palette_compression, map_compression = select_compressions(
+            grit, item_compressions, ('Tiles', 'Pal', 'Map'), self.__build_folder_path, self.__file_name_no_ext,
+            lambda compressions, output_file_path: self.__grit_command(grit, *compressions, output_file_path))
+        return self.__write_header(tiles_compression, palette_compression, map_compression)
 
-        if best_file_size is None or new_file_size < best_file_size:
-            return new_palette_compression, new_file_size
-
-        return best_palette_compression, best_file_size
-
-    def __test_map_compression(self, grit, best_map_compression, new_map_compression, best_file_size):
-        self.__execute_command(grit, 'none', 'none', new_map_compression)
-        new_file_size = self.__write_header('none', 'none', new_map_compression, True)
-
-        if best_file_size is None or new_file_size < best_file_size:
-            return new_map_compression, new_file_size
-
-        return best_map_compression, best_file_size
-
-    def __write_header(self, tiles_compression, palette_compression, map_compression, skip_write):
+    def __write_header(self, tiles_compression, palette_compression, map_compression):
         name = self.__file_name_no_ext
         grit_file_path = self.__build_folder_path + '/' + name + '_bn_gfx.h'
         header_file_path = self.__build_folder_path + '/bn_regular_bg_items_' + name + '.h'
@@ -819,17 +830,16 @@ class RegularBgItem:
                             pass
 
                     if tiles_count > 1024:
-                        raise ValueError('Regular BGs with more than 1024 tiles not supported: ' + str(tiles_count))
+                        raise ValueError('Regular BGs with more than 1024 tiles not supported: ' + str(tiles_count) +
+                                         ' (' + str(self.__width * self.__height * self.__maps) + ' without reduction)')
 
                 if 'Total size:' in grit_line:
                     total_size = int(grit_line.split()[-1])
 
-                    if skip_write:
-                        return total_size
-                    else:
-                        break
+                    break
 
         remove_file(grit_file_path)
+        map_tiles_count = tiles_count
 
         if self.__bpp_8:
             bpp_mode_label = 'bpp_mode::BPP_8'
@@ -876,9 +886,9 @@ class RegularBgItem:
             header_file.write('#endif' + '\n')
             header_file.write('\n')
 
-        return total_size, header_file_path
+        return total_size, header_file_path, tiles_report(map_tiles_count, self.__width * self.__height * self.__maps)
 
-    def __execute_command(self, grit, tiles_compression, palette_compression, map_compression):
+    def __grit_command(self, grit, tiles_compression, palette_compression, map_compression, output_file_path):
         command = [grit, self.__file_path]
 
         if self.__colors_count > 0:
@@ -915,13 +925,8 @@ class RegularBgItem:
         append_compression_command('g', tiles_compression, command)
         append_compression_command('p', palette_compression, command)
         append_compression_command('m', map_compression, command)
-        command.append('-o' + self.__build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx')
-        command = ' '.join(command)
-
-        try:
-            subprocess.check_output(command, shell=True, stderr=subprocess.STDOUT)
-        except subprocess.CalledProcessError as e:
-            raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
+        command.append('-o' + output_file_path)
+        return ' '.join(command)
 
 
 class RegularBgTilesItem:
@@ -957,54 +962,13 @@ class RegularBgTilesItem:
             self.__palette_compression = 'none'
 
     def process(self, grit):
-        tiles_compression = self.__tiles_compression
-        palette_compression = self.__palette_compression
-
-        if tiles_compression.startswith('auto'):
-            test_huffman = tiles_compression == 'auto'
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'none', None)
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'run_length',
-                                                                         file_size)
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'lz77', file_size)
-
-            if test_huffman:
-                tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'huffman',
-                                                                             file_size)
-
-        if palette_compression.startswith('auto'):
-            test_huffman = palette_compression == 'auto'
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'none', None)
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'run_length',
-                                                                             file_size)
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'lz77',
-                                                                             file_size)
-
-            if test_huffman:
-                palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'huffman',
-                                                                                 file_size)
-
-        self.__execute_command(grit, tiles_compression, palette_compression)
-        return self.__write_header(tiles_compression, palette_compression, False)
+        item_compressions = [self.__tiles_compression, self.__palette_compression]
+        tiles_compression, palette_compression = select_compressions(
+            grit, item_compressions, ('Tiles', 'Pal'), self.__build_folder_path, self.__file_name_no_ext,
+            lambda compressions, output_file_path: self.__grit_command(grit, *compressions, output_file_path))
+        return self.__write_header(tiles_compression, palette_compression)
 
-    def __test_tiles_compression(self, grit, best_compression, new_compression, best_file_size):
-        self.__execute_command(grit, new_compression, 'none')
-        new_file_size = self.__write_header(new_compression, 'none', True)
-
-        if best_file_size is None or new_file_size < best_file_size:
-            return new_compression, new_file_size
-
-        return best_compression, best_file_size
-
-    def __test_palette_compression(self, grit, best_compression, new_compression, best_file_size):
-        self.__execute_command(grit, 'none', new_compression)
-        new_file_size = self.__write_header('none', new_compression, True)
-
-        if best_file_size is None or new_file_size < best_file_size:
-            return new_compression, new_file_size
-
-        return best_compression, best_file_size
-
-    def __write_header(self, tiles_compression, palette_compression, skip_write):
+    def __write_header(self, tiles_compression, palette_compression):
         name = self.__file_name_no_ext
         grit_file_path = self.__build_folder_path + '/' + name + '_bn_gfx.h'
         header_file_path = self.__build_folder_path + '/bn_regular_bg_tiles_items_' + name + '.h'
@@ -1032,10 +996,7 @@ class RegularBgTilesItem:
                 if 'Total size:' in grit_line:
                     total_size = int(grit_line.split()[-1])
 
-                    if skip_write:
-                        return total_size
-                    else:
-                        break
+                    break
 
         remove_file(grit_file_path)
 
@@ -1083,7 +1044,7 @@ class RegularBgTilesItem:
 
         return total_size, header_file_path
 
-    def __execute_command(self, grit, tiles_compression, palette_compression):
+    def __grit_command(self, grit, tiles_compression, palette_compression, output_file_path):
         command = [grit, self.__file_path, '-m!']
 
         if self.__bpp_8:
@@ -1099,13 +1060,8 @@ class RegularBgTilesItem:
         else:
             command.append('-p!')
 
-        command.append('-o' + self.__build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx')
-        command = ' '.join(command)
-
-        try:
-            subprocess.check_output(command, shell=True, stderr=subprocess.STDOUT)
-        except subprocess.CalledProcessError as e:
-            raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
+        command.append('-o' + output_file_path)
+        return ' '.join(command)
 
 
 class AffineBgItem:
@@ -1211,73 +1167,13 @@ class AffineBgItem:
                 self.__map_compression = 'none'
 
     def process(self, grit):
-        tiles_compression = self.__tiles_compression
-        palette_compression = self.__palette_compression
-        map_compression = self.__map_compression
-
-        if tiles_compression.startswith('auto'):
-            test_huffman = tiles_compression == 'auto'
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'none', None)
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'run_length',
-                                                                         file_size)
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'lz77', file_size)
-
-            if test_huffman:
-                tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'huffman',
-                                                                             file_size)
-
-        if palette_compression.startswith('auto'):
-            test_huffman = palette_compression == 'auto'
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'none', None)
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'run_length',
-                                                                             file_size)
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'lz77',
-                                                                             file_size)
-
-            if test_huffman:
-                palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'huffman',
-                                                                                 file_size)
-
-        if map_compression.startswith('auto'):
-            test_huffman = map_compression == 'auto'
-            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'none', None)
-            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'run_length', file_size)
-            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'lz77', file_size)
+        item_compressions = [self.__tiles_compression, self.__palette_compression, self.__map_compression]
+        tiles_compression, palette_compression, map_compression = select_compressions(
+            grit, item_compressions, ('Tiles', 'Pal', 'Map'), self.__build_folder_path, self.__file_name_no_ext,
+            lambda compressions, output_file_path: self.__grit_command(grit, *compressions, output_file_path))
+        return self.__write_header(tiles_compression, palette_compression, map_compression)
 
-            if test_huffman:
-                map_compression, file_size = self.__test_map_compression(grit, map_compression, 'huffman', file_size)
-
-        self.__execute_command(grit, tiles_compression, palette_compression, map_compression)
-        return self.__write_header(tiles_compression, palette_compression, map_compression, False)
-
-    def __test_tiles_compression(self, grit, best_tiles_compression, new_tiles_compression, best_file_size):
-        self.__execute_command(grit, new_tiles_compression, 'none', 'none')
-        new_file_size = self.__write_header(new_tiles_compression, 'none', 'none', True)
-
-        if best_file_size is None or new_file_size < best_file_size:
-            return new_tiles_compression, new_file_size
-
-        return best_tiles_compression, best_file_size
-
-    def __test_palette_compression(self, grit, best_palette_compression, new_palette_compression, best_file_size):
-        self.__execute_command(grit, 'none', new_palette_compression, 'none')
-        new_file_size = self.__write_header('none', new_palette_compression, 'none', True)
-
-        if best_file_size is None or new_file_size < best_file_size:
-            return new_palette_compression, new_file_size
-
-        return best_palette_compression, best_file_size
-
-    def __test_map_compression(self, grit, best_map_compression, new_map_compression, best_file_size):
-        self.__execute_command(grit, 'none', 'none', new_map_compression)
-        new_file_size = self.__write_header('none', 'none', new_map_compression, True)
-
-        if best_file_size is None or new_file_size < best_file_size:
-            return new_map_compression, new_file_size
-
-        return best_map_compression, best_file_size
-
-    def __write_header(self, tiles_compression, palette_compression, map_compression, skip_write):
+    def __write_header(self, tiles_compression, palette_compression, map_compression):
         name = self.__file_name_no_ext
         grit_file_path = self.__build_folder_path + '/' + name + '_bn_gfx.h'
         header_file_path = self.__build_folder_path + '/bn_affine_bg_items_' + name + '.h'
@@ -1300,17 +1196,16 @@ class AffineBgItem:
                             pass
 
                     if tiles_count > 256:
-                        raise ValueError('Affine BGs with more than 256 tiles not supported: ' + str(tiles_count))
+                        raise ValueError('Affine BGs with more than 256 tiles not supported: ' + str(tiles_count) +
+                                         ' (' + str(self.__width * self.__height * self.__maps) + ' without reduction)')
 
                 if 'Total size:' in grit_line:
                     total_size = int(grit_line.split()[-1])
 
-                    if skip_write:
-                        return total_size
-                    else:
-                        break
+                    break
 
         remove_file(grit_file_path)
+        map_tiles_count = tiles_count
 
         tiles_count *= 2
         grit_data = re.sub(r'Tiles\[([0-9]+)]', 'Tiles[' + str(tiles_count) + ']', grit_data)
@@ -1352,9 +1247,9 @@ class AffineBgItem:
             header_file.write('#endif' + '\n')
             header_file.write('\n')
 
-        return total_size, header_file_path
+        return total_size, header_file_path, tiles_report(map_tiles_count, self.__width * self.__height * self.__maps)
 
-    def __execute_command(self, grit, tiles_compression, palette_compression, map_compression):
+    def __grit_command(self, grit, tiles_compression, palette_compression, map_compression, output_file_path):
         command = [grit, self.__file_path, '-gB8', '-mLa', '-mu8']
 
         if self.__colors_count > 0:
@@ -1370,13 +1265,8 @@ class AffineBgItem:
         append_compression_command('g', tiles_compression, command)
         append_compression_command('p', palette_compression, command)
         append_compression_command('m', map_compression, command)
-        command.append('-o' + self.__build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx')
-        command = ' '.join(command)
-
-        try:
-            subprocess.check_output(command, shell=True, stderr=subprocess.STDOUT)
-        except subprocess.CalledProcessError as e:
-            raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
+        command.append('-o' + output_file_path)
+        return ' '.join(command)
 
 
 class AffineBgTilesItem:
@@ -1411,54 +1301,13 @@ class AffineBgTilesItem:
             self.__palette_compression = 'none'
 
     def process(self, grit):
-        tiles_compression = self.__tiles_compression
-        palette_compression = self.__palette_compression
-
-        if tiles_compression.startswith('auto'):
-            test_huffman = tiles_compression == 'auto'
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'none', None)
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'run_length',
-                                                                         file_size)
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'lz77', file_size)
-
-            if test_huffman:
-                tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'huffman',
-                                                                             file_size)
-
-        if palette_compression.startswith('auto'):
-            test_huffman = palette_compression == 'auto'
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'none', None)
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'run_length',
-                                                                             file_size)
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'lz77',
-                                                                             file_size)
-
-            if test_huffman:
-                palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'huffman',
-                                                                                 file_size)
-
-        self.__execute_command(grit, tiles_compression, palette_compression)
-        return self.__write_header(tiles_compression, palette_compression, False)
-
-    def __test_tiles_compression(self, grit, best_compression, new_compression, best_file_size):
-        self.__execute_command(grit, new_compression, 'none')
-        new_file_size = self.__write_header(new_compression, 'none', True)
-
-        if best_file_size is None or new_file_size < best_file_size:
-            return new_compression, new_file_size
-
-        return best_compression, best_file_size
-
-    def __test_palette_compression(self, grit, best_compression, new_compression, best_file_size):
-        self.__execute_command(grit, 'none', new_compression)
-        new_file_size = self.__write_header('none', new_compression, True)
-
-        if best_file_size is None or new_file_size < best_file_size:
-            return new_compression, new_file_size
-
-        return best_compression, best_file_size
+        item_compressions = [self.__tiles_compression, self.__palette_compression]
+        tiles_compression, palette_compression = select_compressions(
+            grit, item_compressions, ('Tiles', 'Pal'), self.__build_folder_path, self.__file_name_no_ext,
+            lambda compressions, output_file_path: self.__grit_command(grit, *compressions, output_file_path))
+        return self.__write_header(tiles_compression, palette_compression)
 
-    def __write_header(self, tiles_compression, palette_compression, skip_write):
+    def __write_header(self, tiles_compression, palette_compression):
         name = self.__file_name_no_ext
         grit_file_path = self.__build_folder_path + '/' + name + '_bn_gfx.h'
         header_file_path = self.__build_folder_path + '/bn_affine_bg_tiles_items_' + name + '.h'
@@ -1486,10 +1335,7 @@ class AffineBgTilesItem:
                 if 'Total size:' in grit_line:
                     total_size = int(grit_line.split()[-1])
 
-                    if skip_write:
-                        return total_size
-                    else:
-                        break
+                    break
 
         remove_file(grit_file_path)
 
@@ -1532,7 +1378,7 @@ class AffineBgTilesItem:
 
         return total_size, header_file_path
 
-    def __execute_command(self, grit, tiles_compression, palette_compression):
+    def __grit_command(self, grit, tiles_compression, palette_compression, output_file_path):
         command = [grit, self.__file_path, '-gB8', '-m!']
         append_compression_command('g', tiles_compression, command)
 
@@ -1542,13 +1388,8 @@ class AffineBgTilesItem:
         else:
             command.append('-p!')
 
-        command.append('-o' + self.__build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx')
-        command = ' '.join(command)
-
-        try:
-            subprocess.check_output(command, shell=True, stderr=subprocess.STDOUT)
-        except subprocess.CalledProcessError as e:
-            raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
+        command.append('-o' + output_file_path)
+        return ' '.join(command)
 
 
 class PaletteBitmapItem:
@@ -1581,54 +1422,13 @@ class PaletteBitmapItem:
                 self.__palette_compression = 'none'
 
     def process(self, grit):
-        pixels_compression = self.__pixels_compression
-        palette_compression = self.__palette_compression
-
-        if pixels_compression.startswith('auto'):
-            test_huffman = pixels_compression == 'auto'
-            pixels_compression, file_size = self.__test_pixels_compression(grit, pixels_compression, 'none', None)
-            pixels_compression, file_size = self.__test_pixels_compression(grit, pixels_compression, 'run_length',
-                                                                           file_size)
-            pixels_compression, file_size = self.__test_pixels_compression(grit, pixels_compression, 'lz77', file_size)
-
-            if test_huffman:
-                pixels_compression, file_size = self.__test_pixels_compression(grit, pixels_compression, 'huffman',
-                                                                               file_size)
-
-        if palette_compression.startswith('auto'):
-            test_huffman = palette_compression == 'auto'
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'none', None)
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'run_length',
-                                                                             file_size)
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'lz77',
-                                                                             file_size)
-
-            if test_huffman:
-                palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'huffman',
-                                                                                 file_size)
-
-        self.__execute_command(grit, pixels_compression, palette_compression)
-        return self.__write_header(pixels_compression, palette_compression, False)
-
-    def __test_pixels_compression(self, grit, best_pixels_compression, new_pixels_compression, best_file_size):
-        self.__execute_command(grit, new_pixels_compression, 'none')
-        new_file_size = self.__write_header(new_pixels_compression, 'none', True)
-
-        if best_file_size is None or new_file_size < best_file_size:
-            return new_pixels_compression, new_file_size
-
-        return best_pixels_compression, best_file_size
-
-    def __test_palette_compression(self, grit, best_palette_compression, new_palette_compression, best_file_size):
-        self.__execute_command(grit, 'none', new_palette_compression)
-        new_file_size = self.__write_header('none', new_palette_compression, True)
-
-        if best_file_size is None or new_file_size < best_file_size:
-            return new_palette_compression, new_file_size
-
-        return best_palette_compression, best_file_size
+        item_compressions = [self.__pixels_compression, self.__palette_compression]
+        pixels_compression, palette_compression = select_compressions(
+            grit, item_compressions, ('Bitmap', 'Pal'), self.__build_folder_path, self.__file_name_no_ext,
+            lambda compressions, output_file_path: self.__grit_command(grit, *compressions, output_file_path))
+        return self.__write_header(pixels_compression, palette_compression)
 
-    def __write_header(self, pixels_compression, palette_compression, skip_write):
+    def __write_header(self, pixels_compression, palette_compression):
         name = self.__file_name_no_ext
         grit_file_path = self.__build_folder_path + '/' + name + '_bn_gfx.h'
         header_file_path = self.__build_folder_path + '/bn_palette_bitmap_items_' + name + '.h'
@@ -1642,10 +1442,7 @@ class PaletteBitmapItem:
                 if 'Total size:' in grit_line:
                     total_size = int(grit_line.split()[-1])
 
-                    if skip_write:
-                        return total_size
-                    else:
-                        break
+                    break
 
         remove_file(grit_file_path)
 
@@ -1677,17 +1474,12 @@ class PaletteBitmapItem:
 
         return total_size, header_file_path
 
-    def __execute_command(self, grit, tiles_compression, palette_compression):
+    def __grit_command(self, grit, tiles_compression, palette_compression, output_file_path):
         command = [grit, self.__file_path, '-gb', '-gB8', '-pe' + str(self.__colors_count)]
         append_compression_command('g', tiles_compression, command)
         append_compression_command('p', palette_compression, command)
-        command.append('-o' + self.__build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx')
-        command = ' '.join(command)
-
-        try:
-            subprocess.check_output(command, shell=True, stderr=subprocess.STDOUT)
-        except subprocess.CalledProcessError as e:
-            raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
+        command.append('-o' + output_file_path)
+        return ' '.join(command)
 
 
 class PaletteBitmapPixelsItem:
@@ -1705,30 +1497,13 @@ class PaletteBitmapPixelsItem:
             self.__compression = 'none'
 
     def process(self, grit):
-        compression = self.__compression
-
-        if compression.startswith('auto'):
-            test_huffman = compression == 'auto'
-            compression, file_size = self.__test_compression(grit, compression, 'none', None)
-            compression, file_size = self.__test_compression(grit, compression, 'run_length', file_size)
-            compression, file_size = self.__test_compression(grit, compression, 'lz77', file_size)
-
-            if test_huffman:
-                compression, file_size = self.__test_compression(grit, compression, 'huffman', file_size)
-
-        self.__execute_command(grit, compression)
-        return self.__write_header(compression, False)
+        item_compressions = [self.__compression]
+        compression = select_compressions(
+            grit, item_compressions, ('Bitmap',), self.__build_folder_path, self.__file_name_no_ext,
+            lambda compressions, output_file_path: self.__grit_command(grit, *compressions, output_file_path))[0]
+        return self.__write_header(compression)
 
-    def __test_compression(self, grit, best_compression, new_compression, best_file_size):
-        self.__execute_command(grit, new_compression)
-        new_file_size = self.__write_header(new_compression, True)
-
-        if best_file_size is None or new_file_size < best_file_size:
-            return new_compression, new_file_size
-
-        return best_compression, best_file_size
-
-    def __write_header(self, compression, skip_write):
+    def __write_header(self, compression):
         name = self.__file_name_no_ext
         grit_file_path = self.__build_folder_path + '/' + name + '_bn_gfx.h'
         header_file_path = self.__build_folder_path + '/bn_palette_bitmap_pixels_items_' + name + '.h'
@@ -1741,10 +1516,7 @@ class PaletteBitmapPixelsItem:
                 if 'Total size:' in grit_line:
                     total_size = int(grit_line.split()[-1])
 
-                    if skip_write:
-                        return total_size
-                    else:
-                        break
+                    break
 
         remove_file(grit_file_path)
 
@@ -1772,16 +1544,11 @@ class PaletteBitmapPixelsItem:
 
         return total_size, header_file_path
 
-    def __execute_command(self, grit, compression):
+    def __grit_command(self, grit, compression, output_file_path):
         command = [grit, self.__file_path, '-gb', '-gB8', '-p!']
         append_compression_command('g', compression, command)
-        command.append('-o' + self.__build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx')
-        command = ' '.join(command)
-
-        try:
-            subprocess.check_output(command, shell=True, stderr=subprocess.STDOUT)
-        except subprocess.CalledProcessError as e:
-            raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
+        command.append('-o' + output_file_path)
+        return ' '.join(command)
 
 
 class DirectBitmapItem:
@@ -1799,30 +1566,13 @@ class DirectBitmapItem:
             self.__compression = 'none'
 
     def process(self, grit):
-        compression = self.__compression
-
-        if compression.startswith('auto'):
-            test_huffman = compression == 'auto'
-            compression, file_size = self.__test_compression(grit, compression, 'none', None)
-            compression, file_size = self.__test_compression(grit, compression, 'run_length', file_size)
-            compression, file_size = self.__test_compression(grit, compression, 'lz77', file_size)
-
-            if test_huffman:
-                compression, file_size = self.__test_compression(grit, compression, 'huffman', file_size)
-
-        self.__execute_command(grit, compression)
-        return self.__write_header(compression, False)
-
-    def __test_compression(self, grit, best_compression, new_compression, best_file_size):
-        self.__execute_command(grit, new_compression)
-        new_file_size = self.__write_header(new_compression, True)
+        item_compressions = [self.__compression]
+        compression = select_compressions(
+            grit, item_compressions, ('Bitmap',), self.__build_folder_path, self.__file_name_no_ext,
+            lambda compressions, output_file_path: self.__grit_command(grit, *compressions, output_file_path))[0]
+        return self.__write_header(compression)
 
-        if best_file_size is None or new_file_size < best_file_size:
-            return new_compression, new_file_size
-
-        return best_compression, best_file_size
-
-    def __write_header(self, compression, skip_write):
+    def __write_header(self, compression):
         name = self.__file_name_no_ext
         grit_file_path = self.__build_folder_path + '/' + name + '_bn_gfx.h'
         header_file_path = self.__build_folder_path + '/bn_direct_bitmap_items_' + name + '.h'
@@ -1835,10 +1585,7 @@ class DirectBitmapItem:
                 if 'Total size:' in grit_line:
                     total_size = int(grit_line.split()[-1])
 
-                    if skip_write:
-                        return total_size
-                    else:
-                        break
+                    break
 
         remove_file(grit_file_path)
 
@@ -1866,16 +1613,11 @@ class DirectBitmapItem:
 
         return total_size, header_file_path
 
-    def __execute_command(self, grit, compression):
+    def __grit_command(self, grit, compression, output_file_path):
         command = [grit, self.__file_path, '-gb', '-gB16', '-p!']
         append_compression_command('g', compression, command)
-        command.append('-o' + self.__build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx')
-        command = ' '.join(command)
-
-        try:
-            subprocess.check_output(command, shell=True, stderr=subprocess.STDOUT)
-        except subprocess.CalledProcessError as e:
-            raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
+        command.append('-o' + output_file_path)
+        return ' '.join(command)
 
 
 class BgPaletteItem:
@@ -1895,30 +1637,13 @@ class BgPaletteItem:
             self.__compression = 'none'
 
     def process(self, grit):
-        compression = self.__compression
-
-        if compression.startswith('auto'):
-            test_huffman = compression == 'auto'
-            compression, file_size = self.__test_compression(grit, compression, 'none', None)
-            compression, file_size = self.__test_compression(grit, compression, 'run_length', file_size)
-            compression, file_size = self.__test_compression(grit, compression, 'lz77', file_size)
-
-            if test_huffman:
-                compression, file_size = self.__test_compression(grit, compression, 'huffman', file_size)
-
-        self.__execute_command(grit, compression)
-        return self.__write_header(compression, False)
-
-    def __test_compression(self, grit, best_compression, new_compression, best_file_size):
-        self.__execute_command(grit, new_compression)
-        new_file_size = self.__write_header(new_compression, True)
+        item_compressions = [self.__compression]
+        compression = select_compressions(
+            grit, item_compressions, ('Pal',), self.__build_folder_path, self.__file_name_no_ext,
+            lambda compressions, output_file_path: self.__grit_command(grit, *compressions, output_file_path))[0]
+        return self.__write_header(compression)
 
-        if best_file_size is None or new_file_size < best_file_size:
-            return new_compression, new_file_size
-
-        return best_compression, best_file_size
-
-    def __write_header(self, compression, skip_write):
+    def __write_header(self, compression):
         name = self.__file_name_no_ext
         grit_file_path = self.__build_folder_path + '/' + name + '_bn_gfx.h'
         header_file_path = self.__build_folder_path + '/bn_bg_palette_items_' + name + '.h'
@@ -1931,10 +1656,7 @@ class BgPaletteItem:
                 if 'Total size:' in grit_line:
                     total_size = int(grit_line.split()[-1])
 
-                    if skip_write:
-                        return total_size
-                    else:
-                        break
+                    break
 
         remove_file(grit_file_path)
 
@@ -1966,32 +1688,37 @@ class BgPaletteItem:
 
         return total_size, header_file_path
 
-    def __execute_command(self, grit, compression):
+    def __grit_command(self, grit, compression, output_file_path):
         command = [grit, self.__file_path, '-g!', '-pe' + str(self.__colors_count)]
         append_compression_command('p', compression, command)
-        command.append('-o' + self.__build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx')
-        command = ' '.join(command)
-
-        try:
-            subprocess.check_output(command, shell=True, stderr=subprocess.STDOUT)
-        except subprocess.CalledProcessError as e:
-            raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
+        command.append('-o' + output_file_path)
+        return ' '.join(command)
 
 
 class GraphicsFileInfo:
 
-    def __init__(self, json_file_path, file_path, file_name, file_name_no_ext, file_info_path):
+    def __init__(self, json_file_path, file_path, file_name, file_name_no_ext, file_info_path, file_info):
         self.__json_file_path = json_file_path
         self.__file_path = file_path
         self.__file_name = file_name
         self.__file_name_no_ext = file_name_no_ext
         self.__file_info_path = file_info_path
+        self.__file_info = file_info
 
     def print_file_name(self):
         print(self.__file_name)
 
-    def process(self, grit, build_folder_path):
+    def process(self, grit, build_folder_path, cache_folder_path):
         try:
+            file_cache = FileCache(cache_folder_path, self.__file_info, [grit])
+            cache_data = file_cache.load(build_folder_path)
+
+            if cache_data is not None:
+                header_file_name, total_size, *reports = cache_data
+                self.__file_info.write(self.__file_info_path)
+                return [self.__file_name, build_folder_path + '/' + header_file_name, total_size, *reports,
+                        'restored from cache']
+
             try:
                 with open(self.__json_file_path) as json_file:
                     info = json.load(json_file)
@@ -2029,24 +1756,26 @@ class GraphicsFileInfo:
                 raise ValueError('Unknown graphics type "' + graphics_type +
                                  '" found in graphics json file: ' + self.__json_file_path)
 
-            total_size, header_file_path = item.process(grit)
-
-            with open(self.__file_info_path, 'w') as file_info:
-                file_info.write('')
-
-            return [self.__file_name, header_file_path, total_size]
+            total_size, header_file_path, *reports = item.process(grit)
+            output_file_paths = [header_file_path, build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx.s']
+            file_cache.store([output_file_path for output_file_path in output_file_paths
+                              if os.path.isfile(output_file_path)],
+                             [os.path.basename(header_file_path), total_size, *reports])
+            self.__file_info.write(self.__file_info_path)
+            return [self.__file_name, header_file_path, total_size, *reports]
         except Exception as exc:
             return [self.__file_name, exc]
 
 
 class GraphicsFileInfoProcessor:
 
-    def __init__(self, grit, build_folder_path):
+    def __init__(self, grit, build_folder_path, cache_folder_path):
         self.__grit = grit
         self.__build_folder_path = build_folder_path
+        self.__cache_folder_path = cache_folder_path
 
     def __call__(self, graphics_file_info):
-        return graphics_file_info.process(self.__grit, self.__build_folder_path)
+        return graphics_file_info.process(self.__grit, self.__build_folder_path, self.__cache_folder_path)
 
 
 def list_graphics_file_infos(graphics_paths, build_folder_path):
@@ -2088,28 +1817,17 @@ def list_graphics_file_infos(graphics_paths, build_folder_path):
                     raise ValueError('Graphics json file not found: ' + json_file_path)
 
                 file_info_path = build_folder_path + '/_bn_' + graphics_file_name_no_ext + '_graphics_file_info.txt'
+                file_info = FileInfo.build_from_files([graphics_file_path, json_file_path])
 
-                if not os.path.exists(file_info_path):
-                    build = True
-                else:
-                    file_info_mtime = os.path.getmtime(file_info_path)
-                    graphics_file_mtime = os.path.getmtime(graphics_file_path)
-
-                    if file_info_mtime < graphics_file_mtime:
-                        build = True
-                    else:
-                        json_file_mtime = os.path.getmtime(json_file_path)
-                        build = file_info_mtime < json_file_mtime
-
-                if build:
+                if FileInfo.read(file_info_path) != file_info:
                     graphics_file_infos.append(GraphicsFileInfo(
                         json_file_path, graphics_file_path, graphics_file_name, graphics_file_name_no_ext,
-                        file_info_path))
+                        file_info_path, file_info))
 
     return graphics_file_infos
 
 
-def process_graphics(grit, graphics_paths, build_folder_path):
+def process_graphics(grit, graphics_paths, build_folder_path, cache_folder_path=None):
     graphics_file_infos = list_graphics_file_infos(graphics_paths, build_folder_path)
 
     if len(graphics_file_infos) > 0:
@@ -2119,18 +1837,24 @@ def process_graphics(grit, graphics_paths, build_folder_path):
         sys.stdout.flush()
 
         pool = create_pool()
-        process_results = pool.map(GraphicsFileInfoProcessor(grit, build_folder_path), graphics_file_infos)
+        process_results = pool.map(GraphicsFileInfoProcessor(grit, build_folder_path, cache_folder_path),
+                                 graphics_file_infos)
         pool.close()
 
         total_size = 0
         process_excs = []
 
         for process_result in process_results:
-            if len(process_result) == 3:
+            if len(process_result) >= 3:
                 file_size = process_result[2]
                 total_size += file_size
+                file_report = 'graphics size: ' + str(file_size) + ' bytes'
+
+                for report in process_result[3:]:
+                    file_report += ', ' + report
+
                 print('    ' + str(process_result[0]) + ' item header written in ' + str(process_result[1]) +
-                      ' (graphics size: ' + str(file_size) + ' bytes)')
+                      ' (' + file_report + ')')
             else:
                 process_excs.append(process_result)
 
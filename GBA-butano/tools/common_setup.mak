@@ -91,7 +91,8 @@ all:
 $(BUILD):
 	@$(PYTHON) -B $(BN_TOOLS)/butano_assets_tool.py --grit="$(BN_GRIT)" --audio="$(AUDIO)" \
 			--audio_backend="$(AUDIOBACKEND)" --audio_tool="$(AUDIOTOOL)" --dmg_audio="$(DMGAUDIO)" \
-			--dmg_audio_backend="$(DMGAUDIOBACKEND)" --graphics="$(GRAPHICS)" --build=$(BUILD)
+			--dmg_audio_backend="$(DMGAUDIOBACKEND)" --graphics="$(GRAPHICS)" --build=$(BUILD) \
+			--cache="$(BN_ASSETS_CACHE)"
 	@$(MAKE) --no-print-directory -C $(BUILD) -f $(CURDIR)/Makefile
 
 #---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,465 @@
+"""
+Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+zlib License, see LICENSE file.
+"""
+
+import heapq
+
+# GBA BIOS compatible LZ77, run-length and Huffman compressors, plus reference decompressors used to test them.
+#
+# Compressed streams start with a 32-bit little endian header: the decompressed size in the upper 24 bits and the
+# compression type in the lower 8 bits. They are padded with zeros to a multiple of 4 bytes.
+
+_LZ77_TYPE = 0x10
+_HUFFMAN_TYPE = 0x20
+_RUN_LENGTH_TYPE = 0x30
+
+_LZ77_MIN_LENGTH = 3
+_LZ77_MAX_LENGTH = 18
+
+# LZ77 data is decompressed with 16-bit writes, so a match can't copy the previous byte:
+_LZ77_MIN_DISTANCE = 2
+_LZ77_MAX_DISTANCE = 4096
+
+# Max number of previous positions checked when looking for LZ77 matches:
+_LZ77_MAX_CHAIN_LENGTH = 256
+
+_RUN_LENGTH_MIN_RUN = 3
+_RUN_LENGTH_MAX_RUN = 130
+_RUN_LENGTH_MAX_LITERALS = 128
+
+
+def _header(data, compression_type):
+    data_size = len(data)
+
+    if data_size == 0 or data_size >= 1 << 24:
+        raise ValueError('Invalid data size: ' + str(data_size))
+
+    return bytearray(((data_size << 8) | compression_type).to_bytes(4, 'little'))
+
+
+def _padded(output):
+    while len(output) % 4:
+        output.append(0)
+
+    return bytes(output)
+
+
+def _lz77_longest_matches(data):
+    """Returns the length and distance of the longest match at each position (length 0 if there's no match)."""
+
+    data_size = len(data)
+    lengths = [0] * data_size
+    distances = [0] * data_size
+    chains = {}
+
+    for position in range(data_size - _LZ77_MIN_LENGTH + 1):
+        key = data[position:position + _LZ77_MIN_LENGTH]
+        chain = chains.get(key)
+
+        if chain is None:
+            chains[key] = [position]
+            continue
+
+        max_length = min(_LZ77_MAX_LENGTH, data_size - position)
+        best_length = 0
+        best_distance = 0
+        checked = 0
+
+        for chain_index in range(len(chain) - 1, -1, -1):
+            candidate = chain[chain_index]
+            distance = position - candidate
+
+            if distance > _LZ77_MAX_DISTANCE or checked == _LZ77_MAX_CHAIN_LENGTH:
+                break
+
+            if distance < _LZ77_MIN_DISTANCE:
+                continue
+
+            checked += 1
+
+            if best_length and data[candidate + best_length] != data[position + best_length]:
+                continue
+
+            length = _LZ77_MIN_LENGTH
+
+            while length < max_length and data[candidate + length] == data[position + length]:
+                length += 1
+
+            if length > best_length:
+                best_length = length
+                best_distance = distance
+
+                if length == max_length:
+                    break
+
+        lengths[position] = best_length
+        distances[position] = best_distance
+        chain.append(position)
+
+    return lengths, distances
+
+
+def lz77_compress(data):
+    """Returns the given data LZ77 compressed.
+
+    The parse is optimal for the matches found: it minimizes the number of bits of the output, counting one flag
+    bit plus one byte per literal and one flag bit plus two bytes per match."""
+
+    data = bytes(data)
+    output = _header(data, _LZ77_TYPE)
+    data_size = len(data)
+    lengths, distances = _lz77_longest_matches(data)
+
+    # Cheapest encoding of the data from each position to the end:
+    costs = [0] * (data_size + 1)
+    steps = [1] * (data_size + 1)
+
+    for position in range(data_size - 1, -1, -1):
+        best_cost = costs[position + 1] + 9
+        best_step = 1
+
+        for length in range(_LZ77_MIN_LENGTH, lengths[position] + 1):
+            cost = costs[position + length] + 17
+
+            if cost <= best_cost:
+                best_cost = cost
+                best_step = length
+
+        costs[position] = best_cost
+        steps[position] = best_step
+
+    position = 0
+
+    while position < data_size:
+        flags_index = len(output)
+        output.append(0)
+
+        for flag_index in range(8):
+            if position == data_size:
+                break
+
+            length = steps[position]
+
+            if length == 1:
+                output.append(data[position])
+            else:
+                distance = distances[position] - 1
+                output[flags_index] |= 0x80 >> flag_index
+                output.append(((length - _LZ77_MIN_LENGTH) << 4) | (distance >> 8))
+                output.append(distance & 0xFF)
+
+            position += length
+
+    return _padded(output)
+
+
+def run_length_compress(data):
+    """Returns the given data run-length compressed."""
+
+    data = bytes(data)
+    output = _header(data, _RUN_LENGTH_TYPE)
+    data_size = len(data)
+    literals_begin = 0
+    position = 0
+
+    def append_literals(literals_end):
+        for literals_index in range(literals_begin, literals_end, _RUN_LENGTH_MAX_LITERALS):
+            literals = data[literals_index:min(literals_index + _RUN_LENGTH_MAX_LITERALS, literals_end)]
+            output.append(len(literals) - 1)
+            output.extend(literals)
+
+    while position < data_size:
+        value = data[position]
+        run = 1
+
+        while run < _RUN_LENGTH_MAX_RUN and position + run < data_size and data[position + run] == value:
+            run += 1
+
+        if run >= _RUN_LENGTH_MIN_RUN:
+            append_literals(position)
+            output.append(0x80 | (run - _RUN_LENGTH_MIN_RUN))
+            output.append(value)
+            position += run
+            literals_begin = position
+        else:
+            position += run
+
+    append_literals(data_size)
+    return _padded(output)
+
+
+class _HuffmanNode:
+
+    def __init__(self, symbol, children=None):
+        self.symbol = symbol
+        self.children = children
+
+
+def _huffman_symbols(data, data_bits):
+    if data_bits == 8:
+        symbols = list(data)
+    else:
+        symbols = []
+
+        for byte in data:
+            symbols.append(byte & 0xF)
+            symbols.append(byte >> 4)
+
+    # Decompressed data is written a word at a time, so the stream must fill the last word:
+    while (len(symbols) * data_bits) % 32:
+        symbols.append(symbols[0])
+
+    return symbols
+
+
+def huffman_compress(data, data_bits):
+    """Returns the given data Huffman compressed with the given symbol size (4 or 8 bits).
+
+    Returns None if the Huffman tree can't be stored in the BIOS format."""
+
+    if data_bits != 4 and data_bits != 8:
+        raise ValueError('Invalid data bits: ' + str(data_bits))
+
+    data = bytes(data)
+    output = _header(data, _HUFFMAN_TYPE | data_bits)
+    symbols = _huffman_symbols(data, data_bits)
+    frequencies = {}
+
+    for symbol in symbols:
+        frequencies[symbol] = frequencies.get(symbol, 0) + 1
+
+    if len(frequencies) == 1:
+        frequencies[(symbols[0] + 1) % (1 << data_bits)] = 0
+
+    # The insertion counter keeps the tree deterministic when frequencies are equal:
+    queue = []
+
+    for symbol in sorted(frequencies):
+        queue.append((frequencies[symbol], len(queue), _HuffmanNode(symbol)))
+
+    heapq.heapify(queue)
+    counter = len(queue)
+
+    while len(queue) > 1:
+        first_frequency, _, first_node = heapq.heappop(queue)
+        second_frequency, _, second_node = heapq.heappop(queue)
+        heapq.heappush(queue, (first_frequency + second_frequency, counter,
+                               _HuffmanNode(None, (first_node, second_node))))
+        counter += 1
+
+    root = queue[0][2]
+
+    # Breadth first layout, the children of each node are stored in pairs:
+    slots = [root]
+    children_slots = {}
+    slot = 0
+
+    while slot < len(slots):
+        node = slots[slot]
+
+        if node.children is not None:
+            children_slots[slot] = len(slots)
+            slots.extend(node.children)
+
+        slot += 1
+
+    tree = bytearray(len(slots) + 1)
+
+    for slot, node in enumerate(slots):
+        address = slot + 1
+
+        if node.children is None:
+            tree[address] = node.symbol
+        else:
+            children_address = children_slots[slot] + 1
+            offset = (children_address - (address & ~1) - 2) // 2
+
+            if offset >= 64:
+                return None
+
+            value = offset
+
+            if node.children[0].children is None:
+                value |= 0x80
+
+            if node.children[1].children is None:
+                value |= 0x40
+
+            tree[address] = value
+
+    while len(tree) % 4:
+        tree.append(0)
+
+    tree[0] = (len(tree) // 2) - 1
+    output.extend(tree)
+
+    codes = {}
+    pending_nodes = [(root, '')]
+
+    while pending_nodes:
+        node, code = pending_nodes.pop()
+
+        if node.children is None:
+            codes[node.symbol] = code
+        else:
+            pending_nodes.append((node.children[0], code + '0'))
+            pending_nodes.append((node.children[1], code + '1'))
+
+    bits = ''.join(codes[symbol] for symbol in symbols)
+
+    while len(bits) % 32:
+        bits += '0'
+
+    for bits_index in range(0, len(bits), 32):
+        output.extend(int(bits[bits_index:bits_index + 32], 2).to_bytes(4, 'little'))
+
+    return bytes(output)
+
+
+def compress(data, compression):
+    """Returns the given data compressed with the given compression ('none', 'run_length', 'lz77' or 'huffman').
+
+    Huffman compression uses the symbol size which gives the smallest output.
+    Returns None if the data can't be compressed with the given compression."""
+
+    if compression == 'none':
+        return bytes(data)
+
+    if compression == 'run_length':
+        return run_length_compress(data)
+
+    if compression == 'lz77':
+        return lz77_compress(data)
+
+    if compression == 'huffman':
+        result = None
+
+        for data_bits in (4, 8):
+            candidate = huffman_compress(data, data_bits)
+
+            if candidate is not None and (result is None or len(candidate) < len(result)):
+                result = candidate
+
+        return result
+
+    raise ValueError('Unknown compression: ' + str(compression))
+
+
+def _read_header(data, compression_type):
+    header = int.from_bytes(data[0:4], 'little')
+
+    if (header & 0xF0) != compression_type:
+        raise ValueError('Invalid compression type: ' + hex(header & 0xFF))
+
+    return header & 0xFF, header >> 8
+
+
+def lz77_decompress(data):
+    _, data_size = _read_header(data, _LZ77_TYPE)
+    output = bytearray()
+    position = 4
+
+    while len(output) < data_size:
+        flags = data[position]
+        position += 1
+
+        for flag_index in range(8):
+            if len(output) == data_size:
+                break
+
+            if flags & (0x80 >> flag_index):
+                length = (data[position] >> 4) + _LZ77_MIN_LENGTH
+                distance = (((data[position] & 0xF) << 8) | data[position + 1]) + 1
+                position += 2
+
+                if distance < _LZ77_MIN_DISTANCE or distance > len(output):
+                    raise ValueError('Invalid distance: ' + str(distance))
+
+                for _ in range(length):
+                    output.append(output[-distance])
+            else:
+                output.append(data[position])
+                position += 1
+
+    # The last match can't write past the decompressed size:
+    if len(output) != data_size:
+        raise ValueError('Invalid decompressed size: ' + str(len(output)))
+
+    return bytes(output)
+
+
+def run_length_decompress(data):
+    _, data_size = _read_header(data, _RUN_LENGTH_TYPE)
+    output = bytearray()
+    position = 4
+
+    while len(output) < data_size:
+        flag = data[position]
+        position += 1
+
+        if flag & 0x80:
+            output.extend(bytes([data[position]]) * ((flag & 0x7F) + _RUN_LENGTH_MIN_RUN))
+            position += 1
+        else:
+            literals_count = (flag & 0x7F) + 1
+            output.extend(data[position:position + literals_count])
+            position += literals_count
+
+    if len(output) != data_size:
+        raise ValueError('Invalid decompressed size: ' + str(len(output)))
+
+    return bytes(output)
+
+
+def huffman_decompress(data):
+    compression_type, data_size = _read_header(data, _HUFFMAN_TYPE)
+    data_bits = compression_type & 0xF
+    tree_size = (data[4] + 1) * 2
+    tree_address = 5
+    position = 4 + tree_size
+    symbols = []
+    symbols_count = (data_size * 8) // data_bits
+    node_address = tree_address
+    node = data[node_address]
+
+    while len(symbols) < symbols_count:
+        word = int.from_bytes(data[position:position + 4], 'little')
+        position += 4
+
+        for bit_index in range(31, -1, -1):
+            bit = (word >> bit_index) & 1
+            child_address = (node_address & ~1) + ((node & 0x3F) * 2) + 2 + bit
+            leaf = node & (0x80 >> bit)
+            node_address = child_address
+            node = data[node_address]
+
+            if leaf:
+                symbols.append(node)
+                node_address = tree_address
+                node = data[node_address]
+
+                if len(symbols) == symbols_count:
+                    break
+
+    if data_bits == 8:
+        return bytes(symbols)
+
+    return bytes(symbols[index] | (symbols[index + 1] << 4) for index in range(0, len(symbols), 2))
+
+
+def decompress(data):
+    """Returns the given BIOS compatible compressed data decompressed."""
+
+    compression_type = data[0] & 0xF0
+
+    if compression_type == _LZ77_TYPE:
+        return lz77_decompress(data)
+
+    if compression_type == _RUN_LENGTH_TYPE:
+        return run_length_decompress(data)
+
+    if compression_type == _HUFFMAN_TYPE:
+        return huffman_decompress(data)
+
+    raise ValueError('Unknown compression type: ' + hex(data[0]))
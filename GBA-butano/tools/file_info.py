@@ -3,10 +3,46 @@ Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
 zlib License, see LICENSE file.
 """
 
+import hashlib
+import json
 import os
+import shutil
 import string
 
 
+def _file_hash(file_path):
+    file_hash = hashlib.sha1()
+
+    with open(file_path, 'rb') as file:
+        for chunk in iter(lambda: file.read(1024 * 1024), b''):
+            file_hash.update(chunk)
+
+    return file_hash.hexdigest()
+
+
+def _tools_hash():
+    tools_folder_path = os.path.dirname(os.path.abspath(__file__))
+    tools_hash = hashlib.sha1()
+
+    for tool_file_name in sorted(os.listdir(tools_folder_path)):
+        if tool_file_name.endswith('.py'):
+            tools_hash.update(tool_file_name.encode())
+            tools_hash.update(_file_hash(os.path.join(tools_folder_path, tool_file_name)).encode())
+
+    return tools_hash.hexdigest()
+
+
+def _executable_identity(executable):
+    executable_path = shutil.which(executable) or executable
+
+    try:
+        executable_stat = os.stat(executable_path)
+    except OSError:
+        return executable
+
+    return '%s %d %d' % (os.path.abspath(executable_path), executable_stat.st_size, executable_stat.st_mtime_ns)
+
+
 class FileInfo:
     valid_characters = '_.%s%s' % (string.ascii_lowercase, string.digits)
     cpp_keywords = {'alignas', 'alignof', 'and', 'and_eq', 'asm', 'auto', 'bitand', 'bitor', 'bool', 'break', 'case',
@@ -18,6 +54,7 @@ class FileInfo:
                     'or_eq', 'private', 'protected', 'public', 'register', 'reinterpret_cast', 'requires', 'return',
                     'short', 'signed', 'sizeof', 'static', 'static_assert', 'static_cast', 'struct', 'switch',
                     'template', 'this', 'thread_local', 'throw', 'true', 'try'}
+    tools_hash = None
 
     @staticmethod
     def validate(file_name):
@@ -56,11 +93,19 @@ class FileInfo:
 
     @staticmethod
     def build_from_files(file_paths):
-        info = []
+        """Fingerprints the given files by their content (not by their modification time),
+        so checkouts and branch switches don't trigger a rebuild of unchanged files.
+
+        The tools version is also fingerprinted, so tools updates trigger a rebuild."""
+
+        if FileInfo.tools_hash is None:
+            FileInfo.tools_hash = _tools_hash()
+
+        info = ['tools', FileInfo.tools_hash]
 
         for file_path in file_paths:
             info.append(file_path)
-            info.append(str(os.path.getmtime(file_path)))
+            info.append(_file_hash(file_path))
 
         return FileInfo('\n'.join(info), False)
 
@@ -72,6 +117,9 @@ class FileInfo:
         with open(file_path, 'w') as file:
             file.write(self.__info)
 
+    def hash(self):
+        return hashlib.sha1(self.__info.encode()).hexdigest()
+
     def __eq__(self, other):
         return self.__info == other.__info and self.__read_failed == other.__read_failed
 
@@ -83,3 +131,73 @@ class FileInfo:
             return '[read failed]'
 
         return self.__info
+
+
+class FileCache:
+    """Content addressed cache of generated files, which can be shared between build folders and projects.
+
+    Each entry is stored in a folder named after the hash of the FileInfo of its source files
+    and of the path, size and modification time of the executables used to convert them,
+    so unchanged files can be restored without converting them again,
+    and updating a converter doesn't restore files generated by the previous one."""
+
+    data_file_name = '_bn_cache_data.json'
+
+    def __init__(self, cache_folder_path, file_info, executables=()):
+        if cache_folder_path:
+            entry_hash = hashlib.sha1(file_info.hash().encode())
+
+            for executable in executables:
+                entry_hash.update(_executable_identity(executable).encode())
+
+            self.__entry_folder_path = os.path.join(cache_folder_path, entry_hash.hexdigest())
+        else:
+            self.__entry_folder_path = None
+
+    def load(self, build_folder_path):
+        """Copies the cached files into the given build folder.
+
+        Returns the data stored with them, or None if the cache entry is not found."""
+
+        if self.__entry_folder_path is None:
+            return None
+
+        try:
+            with open(os.path.join(self.__entry_folder_path, FileCache.data_file_name), 'r') as data_file:
+                entry = json.load(data_file)
+
+            for file_name in entry['files']:
+                shutil.copyfile(os.path.join(self.__entry_folder_path, file_name),
+                                os.path.join(build_folder_path, file_name))
+
+            return entry['data']
+        except (OSError, ValueError, KeyError):
+            return None
+
+    def store(self, file_paths, data):
+        """Stores the given files and JSON serializable data in the cache.
+
+        Cache errors are ignored, since the files have already been generated."""
+
+        if self.__entry_folder_path is None:
+            return
+
+        temp_folder_path = self.__entry_folder_path + '.' + str(os.getpid()) + '.tmp'
+
+        try:
+            os.makedirs(temp_folder_path, exist_ok=True)
+            file_names = []
+
+            for file_path in file_paths:
+                file_name = os.path.basename(file_path)
+                shutil.copyfile(file_path, os.path.join(temp_folder_path, file_name))
+                file_names.append(file_name)
+
+            with open(os.path.join(temp_folder_path, FileCache.data_file_name), 'w') as data_file:
+                json.dump({'files': file_names, 'data': data}, data_file)
+
+            os.replace(temp_folder_path, self.__entry_folder_path)
+        except OSError:
+            pass
+        finally:
+            shutil.rmtree(temp_folder_path, ignore_errors=True)
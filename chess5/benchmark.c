@@ -29,6 +29,7 @@
 #include "nnue.h"
 #endif
 #include "position.h"
+#include "prof.h"
 #include "search.h"
 #include "settings.h"
 #include "thread.h"
@@ -172,7 +173,7 @@ void benchmark(Position *current, char *str)
     fclose(F);
   }
 
-  uint64_t nodes = 0;
+  uint64_t nodes = 0, tbCacheHits = 0, tbCacheProbes = 0;
   Position pos;
   memset(&pos, 0, sizeof(pos));
   pos.stackAllocation = malloc(63 + 217 * sizeof(*pos.stack));
@@ -180,6 +181,9 @@ void benchmark(Position *current, char *str)
   pos.st = pos.stack + 7;
   pos.moveList = malloc(10000 * sizeof(*pos.moveList));
   TimePoint elapsed = now();
+#ifdef PROF
+  prof_reset();
+#endif
 
   int numOpts = 0;
   for (int i = 0; i < numFens; i++)
@@ -223,6 +227,8 @@ void benchmark(Position *current, char *str)
       start_thinking(&pos, false);
       thread_wait_until_sleeping(threads_main());
       nodes += threads_nodes_searched();
+      tbCacheHits += threads_tb_cache_hits();
+      tbCacheProbes += threads_tb_cache_probes();
     }
   }
 
@@ -233,6 +239,12 @@ void benchmark(Position *current, char *str)
                   "\nNodes searched  : %" PRIu64
                   "\nNodes/second    : %" PRIu64 "\n",
                   elapsed, nodes, 1000 * nodes / elapsed);
+  if (tbCacheProbes)
+    fprintf(stderr, "TB cache hits   : %.1f%%\n",
+                    100.0 * tbCacheHits / tbCacheProbes);
+#ifdef PROF
+  prof_print(threads);
+#endif
 
   if (fens != Defaults) {
     for (int i = 0; i < numFens; i++)
@@ -21,6 +21,7 @@
 #include <assert.h>
 
 #include "bitboard.h"
+#include "snapshot.h"
 #include "types.h"
 
 // There are 24 possible pawn squares: the first 4 files and ranks from 2 to 7
@@ -127,6 +128,9 @@ static uint8_t classify(uint8_t *db, unsigned idx)
 
 void bitbases_init()
 {
+  if (snapshot_restore("kpk", KPKBitbase, sizeof(KPKBitbase)))
+    return;
+
   uint8_t *db = malloc(MAX_INDEX);
   unsigned idx, repeat = 1;
 
@@ -146,4 +150,6 @@ void bitbases_init()
           KPKBitbase[idx / 32] |= 1UL << (idx & 0x1F);
 
   free(db);
+
+  snapshot_record("kpk", KPKBitbase, sizeof(KPKBitbase));
 }
@@ -20,6 +20,7 @@
 
 #include "bitboard.h"
 #include "misc.h"
+#include "snapshot.h"
 
 #ifndef USE_POPCNT
 uint8_t PopCnt16[1 << 16];
@@ -204,7 +205,7 @@ typedef unsigned (Fn)(Square, Bitboard);
 
 static void init_magics(struct MagicInit *magic_init, Bitboard *attacks[],
                         Bitboard magics[], Bitboard masks[], int deltas[],
-                        Fn index)
+                        Fn index, bool fill)
 {
   Bitboard edges, b;
 
@@ -217,6 +218,9 @@ static void init_magics(struct MagicInit *magic_init, Bitboard *attacks[],
 
     masks[s] = sliding_attack(deltas, s, 0) & ~edges;
 
+    if (!fill)
+      continue;
+
     // Use Carry-Rippler trick to enumerate all subsets of masks[s] and
     // fill the attacks table.
     b = 0;
@@ -227,12 +231,20 @@ static void init_magics(struct MagicInit *magic_init, Bitboard *attacks[],
   }
 }
 
+// The attack tables are the bulk of the bitboard initialization, so they
+// are taken from the startup snapshot if there is one.
+
 static void init_sliding_attacks(void)
 {
+  bool fill = !snapshot_restore("attacks", AttacksTable, sizeof(AttacksTable));
+
   init_magics(rook_init, RookAttacks, RookMagics, RookMasks,
-              RookDirs, magic_index_rook);
+              RookDirs, magic_index_rook, fill);
   init_magics(bishop_init, BishopAttacks, BishopMagics, BishopMasks,
-              BishopDirs, magic_index_bishop);
+              BishopDirs, magic_index_bishop, fill);
+
+  if (fill)
+    snapshot_record("attacks", AttacksTable, sizeof(AttacksTable));
 }
 //end magic-plain.c
 
@@ -4,8 +4,12 @@
 #define INCBIN_STYLE INCBIN_STYLE_SNAKE
 #include "incbin.h"
 
-/* Embeds book.bin into raw machine code */
-INCBIN(book, "Balsa3750.bin");
+/* Embeds the book into raw machine code. Both raw PolyGlot books and
+   books packed with bookpack (see packbook.h) can be embedded. */
+#ifndef EMBEDDED_BOOK_FILE
+#define EMBEDDED_BOOK_FILE "Balsa3750.bin"
+#endif
+INCBIN(book, EMBEDDED_BOOK_FILE);
 
 #else
 // Prevent compiler warnings for empty translation unit when disabled
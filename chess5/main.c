@@ -36,6 +36,7 @@
 #include "polybook.h"
 #include "position.h"
 #include "search.h"
+#include "snapshot.h"
 #include "thread.h"
 #include "tt.h"
 #include "uci.h"
@@ -148,6 +149,20 @@ void enable_raw_mode() {
     printf("\033[?25l"); // Hide cursor
 }
 
+// Builds the engine's lookup tables, from the CFISH_SNAPSHOT startup
+// snapshot file when one is set and valid
+static void init_tables(void) {
+    snapshot_open(getenv("CFISH_SNAPSHOT"));
+    psqt_init();
+    bitboards_init();
+    zob_init();
+    bitbases_init();
+#ifndef NNUE_PURE
+    endgames_init();
+#endif
+    snapshot_close();
+}
+
 // Spawns the integrated UCI Engine in a child process
 void start_engine() {
     engine_recvd_uciok = false;
@@ -167,13 +182,7 @@ void start_engine() {
 
         // Run the engine setup in-process
         print_engine_info(false);
-        psqt_init();
-        bitboards_init();
-        zob_init();
-        bitbases_init();
-#ifndef NNUE_PURE
-        endgames_init();
-#endif
+        init_tables();
         threads_init();
         options_init();
         search_clear();
@@ -1407,13 +1416,7 @@ int main(int argc, char **argv)
     if (force_cli || (!force_gui && !isatty(STDIN_FILENO))) {
         print_engine_info(false);
 
-        psqt_init();
-        bitboards_init();
-        zob_init();
-        bitbases_init();
-#ifndef NNUE_PURE
-        endgames_init();
-#endif
+        init_tables();
         threads_init();
         options_init();
         search_clear();
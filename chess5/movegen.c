@@ -22,6 +22,7 @@
 
 #include "movegen.h"
 #include "position.h"
+#include "prof.h"
 #include "types.h"
 
 enum { CAPTURES, QUIETS, QUIET_CHECKS, EVASIONS, NON_EVASIONS, LEGAL };
@@ -241,8 +242,12 @@ INLINE ExtMove *generate(const Position *pos, ExtMove *list, const int Type)
 
   Color us = stm();
 
-  return us == WHITE ? generate_all(pos, list, WHITE, Type)
+  PROF_BEGIN(MOVEGEN);
+  list = us == WHITE ? generate_all(pos, list, WHITE, Type)
                      : generate_all(pos, list, BLACK, Type);
+  PROF_END(MOVEGEN);
+
+  return list;
 }
 
 // "template" instantiations
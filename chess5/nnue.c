@@ -31,6 +31,7 @@
 #include "misc.h"
 #include "nnue.h"
 #include "position.h"
+#include "prof.h"
 #include "settings.h"
 #include "uci.h"
 
@@ -467,8 +468,12 @@ INLINE void update_accumulator(const Position *pos, const Color c)
 INLINE void transform(const Position *pos, clipped_t *output, mask_t *outMask)
 {
   (void)outMask;
+  PROF_BEGIN(NNUE_UPDATE);
   update_accumulator(pos, WHITE);
   update_accumulator(pos, BLACK);
+  PROF_END(NNUE_UPDATE);
+
+  PROF_BEGIN(NNUE_TRANSFORM);
 
   int16_t (*accumulation)[2][256] = &pos->st->accumulator.accumulation;
 
@@ -510,6 +515,8 @@ INLINE void transform(const Position *pos, clipped_t *output, mask_t *outMask)
 #endif
 
   }
+
+  PROF_END(NNUE_TRANSFORM);
 }
 
 #ifndef USE_NEON
@@ -0,0 +1,40 @@
+#ifndef PACKBOOK_H
+#define PACKBOOK_H
+
+// Packed PolyGlot book format, written by bookpack and read in place by
+// polybook.c. It is meant for the memory-starved targets that embed their
+// book. All multi-byte integers are little-endian.
+//
+// Header (16 bytes):
+//   char     magic[4]      "PKB1"
+//   uint32_t entryCount    number of book entries
+//   uint32_t blockCount    number of blocks
+//   uint32_t blockEntries  entries per block (the last block may be short)
+//
+// Index (blockCount * 12 bytes), sorted like the blocks:
+//   uint64_t firstKey      key of the first entry of the block
+//   uint32_t offset        byte offset of the block from the file start
+//
+// Block:
+//   uint8_t  deltaBits     bits used for a key delta
+//   uint8_t  weightBits    bits used for a weight
+//   followed by a LSB-first bit stream with one record per entry:
+//     newKey  1 bit        (absent for the first entry of a block)
+//     delta   deltaBits    (only if newKey) key minus the previous key
+//     move    15 bits      PolyGlot move
+//     weight  weightBits   PolyGlot weight
+//
+// The first key of a block is taken from the index. The PolyGlot learn
+// field is not stored.
+
+#define PKB_MAGIC "PKB1"
+
+enum {
+  PKB_HEADER_SIZE = 16,
+  PKB_INDEX_ENTRY_SIZE = 12,
+  PKB_BLOCK_HEADER_SIZE = 2,
+  PKB_BLOCK_ENTRIES = 64,
+  PKB_MOVE_BITS = 15
+};
+
+#endif
@@ -1,9 +1,11 @@
 /* polybook.c from BrainFish, Copyright (C) 2016-2017 Thomas Zipproth */
 
 #include <stdio.h>
+#include <string.h>
 
 #include "misc.h"
 #include "movegen.h"
+#include "packbook.h"
 #include "polybook.h"
 #include "thread.h"
 #include "types.h"
@@ -23,7 +25,10 @@ struct PolyHash {
 static Key polyglot_key(const Position *pos);
 static Move pg_move_to_sf_move(const Position *pos, uint16_t pg_move);
 
+static bool set_book_data(PolyBook *pb, const void *data, size_t size);
 static int find_first_key(PolyBook *pb, uint64_t key);
+static void find_raw_moves(PolyBook *pb, uint64_t key);
+static void find_packed_moves(PolyBook *pb, uint64_t key);
 static int get_key_data(PolyBook *pb);
 
 static bool check_do_search(PolyBook *pb, const Position *pos);
@@ -324,6 +329,7 @@ static void pb_release(PolyBook *pb)
       pb->polyhash = NULL;
     }
   }
+  pb->packed = NULL;
 }
 
 void pb_free(void)
@@ -351,18 +357,22 @@ void pb_init(PolyBook *pb, const char *bookfile)
 #ifdef USE_EMBEDDED_BOOK
   if (strcmp(bookfile, "<embedded>") == 0) {
     pb->polyhash = (const struct PolyHash *)embedded_book_data;
-    pb->keycount = (ssize_t)(embedded_book_size / 16);
     pb->is_embedded = true;
-    printf("info string Embedded book loaded (%d moves)\n", (int)pb->keycount);
+    if (set_book_data(pb, embedded_book_data, embedded_book_size))
+      printf("info string Embedded book loaded (%d moves)\n", (int)pb->keycount);
+    else
+      pb_release(pb);
   } else {
     pb->is_embedded = false;
 #endif
 
     FD fd = open_file(bookfile);
     if (fd != FD_ERR) {
-      pb->keycount = file_size(fd) / 16;
+      size_t size = file_size(fd);
       pb->polyhash = map_file(fd, &pb->mapping);
       close_file(fd);
+      if (pb->polyhash && !set_book_data(pb, pb->polyhash, size))
+        pb_release(pb);
     }
 
 #ifdef USE_EMBEDDED_BOOK
@@ -425,7 +435,7 @@ Move pb_probe(PolyBook *pb, Position *pos)
 
   ssize_t idx1 = useBestBookMove ? pb->index_best : pb->index_rand;
 
-  m1 = pg_move_to_sf_move(pos, from_be_u16(pb->polyhash[idx1].move));
+  m1 = pg_move_to_sf_move(pos, pb->moves[idx1].move);
 
   if (!is_draw(pos)) return m1; // 64
   if (n == 1) return m1;
@@ -438,7 +448,7 @@ Move pb_probe(PolyBook *pb, Position *pos)
   ssize_t idx2 = pb->index_first;
   if (idx1 == idx2) idx2++;
 
-  Move m2 = pg_move_to_sf_move(pos, from_be_u16(pb->polyhash[idx2].move));
+  Move m2 = pg_move_to_sf_move(pos, pb->moves[idx2].move);
 
   if (!check_draw(pos, m2))
     return m2;
@@ -507,6 +517,81 @@ static Move pg_move_to_sf_move(const Position *pos, uint16_t pg_move)
   return 0;
 }
 
+// Reads n <= 64 bits from the LSB-first bit stream p at bit position *pos.
+INLINE uint64_t read_bits(const uint8_t *p, size_t *pos, int n)
+{
+  uint64_t v = 0;
+  for (int done = 0; done < n; ) {
+    int shift = *pos & 7;
+    int take = min(8 - shift, n - done);
+    v |= (uint64_t)((p[*pos >> 3] >> shift) & ((1 << take) - 1)) << done;
+    *pos += take;
+    done += take;
+  }
+  return v;
+}
+
+// set_book_data() checks the format of a mapped or embedded book. Books
+// starting with the packbook.h magic are probed in place through their
+// block index, anything else is treated as a raw PolyGlot book.
+static bool set_book_data(PolyBook *pb, const void *data, size_t size)
+{
+  const uint8_t *p = data;
+
+  if (size < PKB_HEADER_SIZE || memcmp(p, PKB_MAGIC, 4) != 0) {
+    pb->packed = NULL;
+    pb->keycount = size / 16;
+    return pb->keycount > 0;
+  }
+
+  pb->packed = p;
+  pb->keycount = readu_le_u32(p + 4);
+  pb->blockCount = readu_le_u32(p + 8);
+
+  if (   pb->keycount <= 0
+      || readu_le_u32(p + 12) != PKB_BLOCK_ENTRIES
+      || pb->blockCount != (pb->keycount + PKB_BLOCK_ENTRIES - 1) / PKB_BLOCK_ENTRIES
+      || (size - PKB_HEADER_SIZE) / PKB_INDEX_ENTRY_SIZE < (size_t)pb->blockCount)
+    return false;
+
+  // Walk every block once so that probing never reads past its end. Blocks
+  // are stored in index order, so a block ends where the next one starts.
+  size_t dataStart = PKB_HEADER_SIZE + (size_t)pb->blockCount * PKB_INDEX_ENTRY_SIZE;
+
+  for (ssize_t block = 0; block < pb->blockCount; block++) {
+    const uint8_t *q = p + PKB_HEADER_SIZE + block * PKB_INDEX_ENTRY_SIZE;
+    size_t offset = readu_le_u32(q + 8);
+    size_t end = block + 1 < pb->blockCount ? readu_le_u32(q + 8 + PKB_INDEX_ENTRY_SIZE) : size;
+    if (offset < dataStart || end > size || end < offset + PKB_BLOCK_HEADER_SIZE)
+      return false;
+
+    int deltaBits = p[offset], weightBits = p[offset + 1];
+    if (deltaBits > 64 || weightBits > 16)
+      return false;
+
+    const uint8_t *blockData = p + offset + PKB_BLOCK_HEADER_SIZE;
+    size_t maxBits = (end - offset - PKB_BLOCK_HEADER_SIZE) * 8, pos = 0;
+    ssize_t n = min(pb->keycount - block * PKB_BLOCK_ENTRIES, PKB_BLOCK_ENTRIES);
+
+    for (ssize_t i = 0; i < n; i++) {
+      if (i > 0) {
+        if (pos + 1 > maxBits)
+          return false;
+        if (read_bits(blockData, &pos, 1))
+          pos += deltaBits;
+      }
+      pos += PKB_MOVE_BITS + weightBits;
+      if (pos > maxBits)
+        return false;
+    }
+    dataStart = end;
+  }
+
+  return true;
+}
+
+// find_first_key() collects the moves stored for key in pb->moves and
+// returns their number, or -1 if the position is not in the book.
 static int find_first_key(PolyBook *pb, uint64_t key)
 {
   pb->index_first = -1;
@@ -515,6 +600,20 @@ static int find_first_key(PolyBook *pb, uint64_t key)
   pb->index_best = -1;
   pb->index_rand = -1;
 
+  if (pb->packed)
+    find_packed_moves(pb, key);
+  else
+    find_raw_moves(pb, key);
+
+  if (!pb->index_count)
+    return -1;
+
+  pb->index_first = 0;
+  return get_key_data(pb);
+}
+
+static void find_raw_moves(PolyBook *pb, uint64_t key)
+{
   ssize_t start = 0;
   ssize_t end = pb->keycount;
 
@@ -535,33 +634,81 @@ static int find_first_key(PolyBook *pb, uint64_t key)
 
   for (ssize_t i = start; i < end; i++)
     if (key == from_be_u64(pb->polyhash[i].key)) {
-      pb->index_first = i;
-      while (   pb->index_first > 0
-             && key == from_be_u64(pb->polyhash[pb->index_first - 1].key))
-        pb->index_first--;
-      return get_key_data(pb);
+      while (i > 0 && key == from_be_u64(pb->polyhash[i - 1].key))
+        i--;
+      for (; i < pb->keycount && key == from_be_u64(pb->polyhash[i].key); i++)
+        if (pb->index_count < MAX_BOOK_MOVES) {
+          pb->moves[pb->index_count].move = from_be_u16(pb->polyhash[i].move);
+          pb->moves[pb->index_count].weight = from_be_u16(pb->polyhash[i].weight);
+          pb->index_count++;
+        }
+      return;
     }
+}
 
-  return -1;
+INLINE uint64_t packed_first_key(const PolyBook *pb, ssize_t block)
+{
+  const uint8_t *p = pb->packed + PKB_HEADER_SIZE + block * PKB_INDEX_ENTRY_SIZE;
+  return readu_le_u32(p) | ((uint64_t)readu_le_u32(p + 4) << 32);
 }
 
-static int get_key_data(PolyBook *pb)
+// find_packed_moves() finds the last block starting before key through a
+// binary search on the index and then decodes the entries one by one. Only
+// the bit position inside the current block is kept, so the working memory
+// does not depend on the size of the book.
+static void find_packed_moves(PolyBook *pb, uint64_t key)
 {
-  int best_weight = from_be_u16(pb->polyhash[pb->index_first].weight);
-  pb->index_weight_count = best_weight;
-  uint64_t key = pb->polyhash[pb->index_first].key;
+  ssize_t lo = 0, hi = pb->blockCount;
+
+  while (hi - lo > 1) {
+    ssize_t mid = (lo + hi) / 2;
+    if (packed_first_key(pb, mid) < key)
+      lo = mid;
+    else
+      hi = mid;
+  }
 
-  pb->index_count = 1;
-  pb->index_best = pb->index_first;
+  for (ssize_t block = lo; block < pb->blockCount; block++) {
+    const uint8_t *p = pb->packed + PKB_HEADER_SIZE + block * PKB_INDEX_ENTRY_SIZE;
+    const uint8_t *data = pb->packed + readu_le_u32(p + 8);
+    int deltaBits = data[0], weightBits = data[1];
+    ssize_t n = min(pb->keycount - block * PKB_BLOCK_ENTRIES, PKB_BLOCK_ENTRIES);
+    uint64_t k = packed_first_key(pb, block);
+    size_t pos = 0;
 
-  for (ssize_t i = pb->index_first + 1; i < pb->keycount; i++) {
-    if (pb->polyhash[i].key != key)
-      break;
+    data += PKB_BLOCK_HEADER_SIZE;
+
+    if (k > key)
+      return;
+
+    for (ssize_t i = 0; i < n; i++) {
+      if (i > 0 && read_bits(data, &pos, 1))
+        k += read_bits(data, &pos, deltaBits);
+      if (k > key)
+        return;
+
+      uint16_t move = read_bits(data, &pos, PKB_MOVE_BITS);
+      uint16_t weight = read_bits(data, &pos, weightBits);
+
+      if (k == key && pb->index_count < MAX_BOOK_MOVES) {
+        pb->moves[pb->index_count].move = move;
+        pb->moves[pb->index_count].weight = weight;
+        pb->index_count++;
+      }
+    }
+  }
+}
+
+static int get_key_data(PolyBook *pb)
+{
+  int best_weight = pb->moves[0].weight;
+  pb->index_weight_count = best_weight;
+  pb->index_best = 0;
 
-    pb->index_count++;
-    pb->index_weight_count += from_be_u16(pb->polyhash[i].weight);
-    if (from_be_u16(pb->polyhash[i].weight) > best_weight) {
-      best_weight = from_be_u16(pb->polyhash[i].weight);
+  for (int i = 1; i < pb->index_count; i++) {
+    pb->index_weight_count += pb->moves[i].weight;
+    if (pb->moves[i].weight > best_weight) {
+      best_weight = pb->moves[i].weight;
       pb->index_best = i;
     }
   }
@@ -570,14 +717,14 @@ static int get_key_data(PolyBook *pb)
   int weight_count = 0;
   pb->index_rand = pb->index_best;
 
-  for (ssize_t i = pb->index_first; i < pb->index_first + pb->index_count; i++) {
+  for (int i = 0; i < pb->index_count; i++) {
     if (   rand_pos >= weight_count
-        && rand_pos < weight_count + from_be_u16(pb->polyhash[i].weight))
+        && rand_pos < weight_count + pb->moves[i].weight)
     {
       pb->index_rand = i;
       break;
     }
-    weight_count += from_be_u16(pb->polyhash[i].weight);
+    weight_count += pb->moves[i].weight;
   }
 
   return pb->index_count;
@@ -7,9 +7,19 @@
 #include "misc.h"
 #include "position.h"
 
+// Maximum number of book moves kept for a single position
+enum { MAX_BOOK_MOVES = 64 };
+
+typedef struct {
+  uint16_t move;
+  uint16_t weight;
+} BookMove;
+
 struct PolyBook {
   ssize_t keycount;
   const struct PolyHash *polyhash;
+  const uint8_t *packed; // Non-NULL for books in the packbook.h format
+  ssize_t blockCount;
 
   map_t mapping;
 
@@ -22,6 +32,7 @@ struct PolyBook {
   ssize_t index_best;
   ssize_t index_rand;
   int index_weight_count;
+  BookMove moves[MAX_BOOK_MOVES]; // Book moves of the last probed position
 
 //  PRNG sr;
 
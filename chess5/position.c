@@ -9,6 +9,8 @@
 #include "movegen.h"
 #include "pawns.h"
 #include "position.h"
+#include "prof.h"
+#include "snapshot.h"
 #include "tbprobe.h"
 #include "thread.h"
 #include "tt.h"
@@ -171,7 +173,14 @@ void zob_init(void) {
   zob.side = prng_rand(&rng);
   zob.noPawns = prng_rand(&rng);
 
-  // Prepare the cuckoo tables
+  // Prepare the cuckoo tables, unless they are in the startup snapshot
+  if (   snapshot_restore("cuckoo", cuckoo, sizeof(cuckoo))
+      && snapshot_restore("cuckoomove", cuckooMove, sizeof(cuckooMove)))
+    return;
+
+  memset(cuckoo, 0, sizeof(cuckoo));
+  memset(cuckooMove, 0, sizeof(cuckooMove));
+
   int count = 0;
   for (int c = 0; c < 2; c++)
     for (int pt = PAWN; pt <= KING; pt++) {
@@ -198,6 +207,9 @@ void zob_init(void) {
           }
     }
   assert(count == 3668);
+
+  snapshot_record("cuckoo", cuckoo, sizeof(cuckoo));
+  snapshot_record("cuckoomove", cuckooMove, sizeof(cuckooMove));
 }
 
 
@@ -1124,7 +1136,7 @@ Key key_after(const Position *pos, Move m)
 
 
 // Test whether SEE >= value.
-bool see_test(const Position *pos, Move m, int value)
+INLINE bool see_ge(const Position *pos, Move m, int value)
 {
   if (unlikely(type_of_m(m) != NORMAL))
     return 0 >= value;
@@ -1187,6 +1199,15 @@ bool see_test(const Position *pos, Move m, int value)
   return res;
 }
 
+bool see_test(const Position *pos, Move m, int value)
+{
+  PROF_BEGIN(SEE);
+  bool res = see_ge(pos, m, value);
+  PROF_END(SEE);
+
+  return res;
+}
+
 
 // is_draw() tests whether the position is drawn by 50-move rule or by
 // repetition. It does not detect stalemates.
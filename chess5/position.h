@@ -162,6 +162,7 @@ struct Position {
   Stack *stack;
   uint64_t nodes;
   uint64_t tbHits;
+  uint64_t tbCacheHits, tbCacheProbes;
   uint64_t ttHitAverage;
   int pvIdx, pvLast;
   int selDepth, nmpMinPly;
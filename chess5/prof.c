@@ -0,0 +1,99 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2008 Tord Romstad (Glaurung author)
+  Copyright (C) 2008-2015 Marco Costalba, Joona Kiiski, Tord Romstad
+  Copyright (C) 2015-2016 Marco Costalba, Joona Kiiski, Gary Linscott, Tord Romstad
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "prof.h"
+
+#ifdef PROF
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "thread.h"
+
+static ProfStats profSlots[MAX_THREADS + 1];
+static uint64_t profStartTicks;
+static uint64_t profDepthTime[MAX_PLY];
+static uint64_t profDepthCount[MAX_PLY];
+
+_Thread_local ProfStats *profStats = &profSlots[0];
+
+static const char *ProfNames[PROF_NB] = {
+  "movegen", "tt_probe", "nnue_update", "nnue_transform", "see", "qsearch"
+};
+
+// prof_bind_thread() is called by search thread idx when it starts.
+
+void prof_bind_thread(int idx)
+{
+  profStats = &profSlots[idx + 1];
+}
+
+void prof_reset(void)
+{
+  memset(profSlots, 0, sizeof(profSlots));
+  memset(profDepthTime, 0, sizeof(profDepthTime));
+  memset(profDepthCount, 0, sizeof(profDepthCount));
+  profStartTicks = prof_ticks();
+}
+
+// prof_depth_done() is called by the main thread each time it completes an
+// iteration. elapsed is the time in milliseconds since the search started.
+
+void prof_depth_done(int depth, int64_t elapsed)
+{
+  profDepthTime[depth] += elapsed;
+  profDepthCount[depth]++;
+}
+
+// prof_print() sums up the slots of all threads and prints one line per
+// counter. The share is relative to the ticks elapsed since prof_reset()
+// on all threads together. The qsearch line is inclusive (it is measured
+// where the main search enters qsearch), so the shares do not add up.
+
+void prof_print(int numThreads)
+{
+  uint64_t elapsed = (prof_ticks() - profStartTicks) * numThreads + 1;
+
+  fprintf(stderr, "\n%-16s %14s %16s %10s %7s\n",
+                  "Hot path", "Calls", "Ticks", "Ticks/call", "Share");
+
+  for (int id = 0; id < PROF_NB; id++) {
+    uint64_t calls = 0, ticks = 0;
+    for (int i = 0; i <= MAX_THREADS; i++) {
+      calls += profSlots[i].calls[id];
+      ticks += profSlots[i].ticks[id];
+    }
+    fprintf(stderr, "%-16s %14" PRIu64 " %16" PRIu64 " %10" PRIu64 " %6.2f%%\n",
+                    ProfNames[id], calls, ticks, calls ? ticks / calls : 0,
+                    100.0 * ticks / elapsed);
+  }
+
+  // Time to depth: how long the searches took on average to complete each
+  // depth, over the positions that completed it.
+  fprintf(stderr, "\n%-16s %14s %16s\n", "Depth", "Positions", "Avg time (ms)");
+
+  for (int d = 1; d < MAX_PLY; d++)
+    if (profDepthCount[d])
+      fprintf(stderr, "%-16d %14" PRIu64 " %16.1f\n", d, profDepthCount[d],
+                      (double)profDepthTime[d] / profDepthCount[d]);
+}
+
+#endif
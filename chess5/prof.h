@@ -0,0 +1,95 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2008 Tord Romstad (Glaurung author)
+  Copyright (C) 2008-2015 Marco Costalba, Joona Kiiski, Tord Romstad
+  Copyright (C) 2015-2016 Marco Costalba, Joona Kiiski, Gary Linscott, Tord Romstad
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PROF_H
+#define PROF_H
+
+// Optional hot-path cycle counters and time to depth statistics, enabled
+// with "make prof=yes" (-DPROF).
+// Without PROF every macro below expands to nothing, so release builds are
+// not affected at all.
+
+#ifdef PROF
+
+#include <stdint.h>
+#if !defined(__x86_64__) && !defined(__i386__) && !defined(__aarch64__)
+#include <time.h>
+#endif
+
+#include "types.h"
+
+enum {
+  PROF_MOVEGEN, PROF_TT_PROBE, PROF_NNUE_UPDATE, PROF_NNUE_TRANSFORM,
+  PROF_SEE, PROF_QSEARCH, PROF_NB
+};
+
+typedef struct {
+  uint64_t calls[PROF_NB];
+  uint64_t ticks[PROF_NB];
+} ProfStats;
+
+// Each search thread counts into its own slot, so no atomics are needed.
+// Slot 0 is shared by all threads that were not bound to a slot, e.g. the
+// UCI thread running perft.
+extern _Thread_local ProfStats *profStats;
+
+void prof_bind_thread(int idx);
+void prof_reset(void);
+void prof_depth_done(int depth, int64_t elapsed);
+void prof_print(int numThreads);
+
+// prof_ticks() reads the cheapest monotonic counter available: the time
+// stamp counter on x86, the virtual counter on ARMv8 and clock_gettime()
+// everywhere else.
+
+INLINE uint64_t prof_ticks(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+  uint64_t t;
+  __asm__ volatile("mrs %0, cntvct_el0" : "=r"(t));
+  return t;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return 1000000000ULL * (uint64_t)ts.tv_sec + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+INLINE void prof_add(int id, uint64_t ticks)
+{
+  profStats->calls[id]++;
+  profStats->ticks[id] += ticks;
+}
+
+#define PROF_BEGIN(id) uint64_t profStart_##id = prof_ticks()
+#define PROF_END(id) prof_add(PROF_##id, prof_ticks() - profStart_##id)
+#define PROF_COUNT(id) (profStats->calls[PROF_##id]++)
+
+#else
+
+#define PROF_BEGIN(id) do {} while (0)
+#define PROF_END(id) do {} while (0)
+#define PROF_COUNT(id) do {} while (0)
+
+#endif
+
+#endif
@@ -27,6 +27,7 @@
 #include "movegen.h"
 #include "movepick.h"
 #include "polybook.h"
+#include "prof.h"
 #include "search.h"
 #include "settings.h"
 #include "tbprobe.h"
@@ -577,6 +578,11 @@ skip_search:
     if (pos->threadIdx != 0)
       continue;
 
+#ifdef PROF
+    if (!Threads.stop)
+      prof_depth_done(pos->rootDepth, now() - Limits.startTime);
+#endif
+
 #if 0
     // If skill level is enabled and time is up, pick a sub-optimal best move
     if (skill.enabled() && skill.time_to_pick(thread->rootDepth))
@@ -667,14 +673,18 @@ INLINE Value search_node(Position *pos, Stack *ss, Value alpha, Value beta,
   }
 
   // Dive into quiescense search when the depth reaches zero
-  if (depth <= 0)
-    return  PvNode
-          ?   checkers()
-            ? qsearch_PV_true(pos, ss, alpha, beta, 0)
-            : qsearch_PV_false(pos, ss, alpha, beta, 0)
-          :   checkers()
-            ? qsearch_NonPV_true(pos, ss, alpha, 0)
-            : qsearch_NonPV_false(pos, ss, alpha, 0);
+  if (depth <= 0) {
+    PROF_BEGIN(QSEARCH);
+    Value qsValue =  PvNode
+                   ?   checkers()
+                     ? qsearch_PV_true(pos, ss, alpha, beta, 0)
+                     : qsearch_PV_false(pos, ss, alpha, beta, 0)
+                   :   checkers()
+                     ? qsearch_NonPV_true(pos, ss, alpha, 0)
+                     : qsearch_NonPV_false(pos, ss, alpha, 0);
+    PROF_END(QSEARCH);
+    return qsValue;
+  }
 
   assert(-VALUE_INFINITE <= alpha && alpha < beta && beta <= VALUE_INFINITE);
   assert(PvNode || (alpha == beta - 1));
@@ -991,9 +1001,11 @@ INLINE Value search_node(Position *pos, Stack *ss, Value alpha, Value beta,
         do_move(pos, move, givesCheck);
 
         // Perform a preliminary qsearch to verify that the move holds
+        PROF_BEGIN(QSEARCH);
         value =   givesCheck
                ? -qsearch_NonPV_true(pos, ss+1, -probCutBeta, 0)
                : -qsearch_NonPV_false(pos, ss+1, -probCutBeta, 0);
+        PROF_END(QSEARCH);
 
         // If the qsearch held, perform the regular search
         if (value >= probCutBeta)
@@ -2083,6 +2095,7 @@ void start_thinking(Position *root, bool ponderMode)
     pos->nmpMinPly = 0;
     pos->rootDepth = 0;
     pos->nodes = pos->tbHits = 0;
+    pos->tbCacheHits = pos->tbCacheProbes = 0;
     RootMoves *rm = pos->rootMoves;
     rm->size = end - list;
     for (int i = 0; i < rm->size; i++) {
@@ -4,13 +4,14 @@
 #include "numa.h"
 #include "search.h"
 #include "settings.h"
+#include "tbprobe.h"
 #include "thread.h"
 #include "tt.h"
 #include "types.h"
 
 struct settings settings, delayedSettings;
 
-// Process Hash, Threads, NUMA and LargePages settings.
+// Process Hash, Threads, NUMA, LargePages and SyzygyCache settings.
 
 void process_delayed_settings(void)
 {
@@ -44,6 +45,13 @@ void process_delayed_settings(void)
     tt_allocate(settings.ttSize);
   }
 
+  // The Syzygy probe cache is only allocated once tablebases were found.
+  size_t tbCacheSize = TB_MaxCardinality ? delayedSettings.tbCacheSize : 0;
+  if (settings.tbCacheSize != tbCacheSize) {
+    settings.tbCacheSize = tbCacheSize;
+    TB_cache_resize(settings.tbCacheSize);
+  }
+
   if (delayedSettings.clear) {
     delayedSettings.clear = false;
     search_clear();
@@ -6,6 +6,7 @@
 struct settings {
   NodeMask mask;
   size_t ttSize;
+  size_t tbCacheSize;
   size_t numThreads;
   bool numaEnabled;
   bool largePages;
@@ -0,0 +1,334 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2008 Tord Romstad (Glaurung author)
+  Copyright (C) 2008-2015 Marco Costalba, Joona Kiiski, Tord Romstad
+  Copyright (C) 2015-2016 Marco Costalba, Joona Kiiski, Gary Linscott, Tord Romstad
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "misc.h"
+#include "snapshot.h"
+
+// Bump SNAPSHOT_VERSION whenever the contents of a snapshotted table change
+// without a change of its size, so that old snapshot files are rejected.
+#define SNAPSHOT_VERSION 1
+
+// A snapshot file is written in native byte order and consists of a header
+// followed by the sections, each one a SectionHeader and the table data
+// padded to a multiple of 8 bytes. The checksum covers everything after
+// the header, the build key the compile options that affect the tables.
+
+typedef struct {
+  char magic[4];
+  uint32_t version;
+  uint64_t buildKey;
+  uint64_t checksum;
+  uint64_t sectionCount;
+} SnapshotHeader;
+
+enum { NAME_SIZE = 16, MAX_SECTIONS = 8 };
+
+typedef struct {
+  char name[NAME_SIZE];
+  uint64_t size;
+} SectionHeader;
+
+static const char BuildFlags[] = "cfish"
+#ifdef IS_64BIT
+  " 64bit"
+#endif
+#ifdef USE_POPCNT
+  " popcnt"
+#endif
+#ifdef PEDANTIC
+  " pedantic"
+#endif
+#ifdef NNUE_PURE
+  " nnue_pure"
+#endif
+  ;
+
+static struct {
+  char *file;
+  const uint8_t *data;
+  map_t mapping;
+  size_t size;
+  bool loaded;
+  int numSections, numRestored, numComputed;
+  struct {
+    char name[NAME_SIZE];
+    const void *data;
+    size_t size;
+  } sections[MAX_SECTIONS];
+  uint64_t startTime, elapsed;
+} snap;
+
+static uint64_t micros(void)
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return 1000000 * (uint64_t)tv.tv_sec + (uint64_t)tv.tv_usec;
+}
+
+// FNV-1a, fast enough to check a snapshot in a fraction of the time it
+// takes to compute the tables.
+static uint64_t hash_bytes(uint64_t h, const void *data, size_t size)
+{
+  const uint8_t *p = data;
+  for (size_t i = 0; i < size; i++)
+    h = (h ^ p[i]) * 0x100000001b3ULL;
+  return h;
+}
+
+static uint64_t build_key(void)
+{
+  uint64_t sizes[] = { sizeof(void *), sizeof(SnapshotHeader),
+                       sizeof(SectionHeader) };
+  uint64_t h = hash_bytes(0xcbf29ce484222325ULL, BuildFlags, strlen(BuildFlags));
+  return hash_bytes(h, sizes, sizeof(sizes));
+}
+
+static size_t padded(size_t size)
+{
+  return (size + 7) & ~(size_t)7;
+}
+
+// find_section() returns the header of the named section of the mapped
+// snapshot, or NULL. The section bounds were checked by check_file().
+static const SectionHeader *find_section(const char *name)
+{
+  const uint8_t *p = snap.data + sizeof(SnapshotHeader);
+  const uint8_t *end = snap.data + snap.size;
+
+  while (p < end) {
+    const SectionHeader *sh = (const SectionHeader *)p;
+    if (strncmp(sh->name, name, NAME_SIZE) == 0)
+      return sh;
+    p += sizeof(SectionHeader) + padded(sh->size);
+  }
+
+  return NULL;
+}
+
+static bool check_file(void)
+{
+  const SnapshotHeader *h = (const SnapshotHeader *)snap.data;
+
+  if (   snap.size < sizeof(SnapshotHeader)
+      || memcmp(h->magic, "CFSN", 4) != 0
+      || h->version != SNAPSHOT_VERSION
+      || h->buildKey != build_key())
+    return false;
+
+  const uint8_t *p = snap.data + sizeof(SnapshotHeader);
+  const uint8_t *end = snap.data + snap.size;
+
+  for (uint64_t i = 0; i < h->sectionCount; i++) {
+    if ((size_t)(end - p) < sizeof(SectionHeader))
+      return false;
+    uint64_t size = ((const SectionHeader *)p)->size;
+    if ((uint64_t)(end - p) - sizeof(SectionHeader) < padded(size))
+      return false;
+    p += sizeof(SectionHeader) + padded(size);
+  }
+
+  return   p == end
+        && h->checksum == hash_bytes(build_key(), snap.data + sizeof(*h),
+                                     snap.size - sizeof(*h));
+}
+
+// snapshot_open() is called before the first *_init() function. With a
+// NULL or empty file name, snapshots are disabled and the call only starts
+// the startup timer.
+
+void snapshot_open(const char *file)
+{
+  snap.startTime = micros();
+
+  if (!file || !*file)
+    return;
+
+  snap.file = strdup(file);
+
+  FD fd = open_file(file);
+  if (fd == FD_ERR)
+    return;
+  snap.size = file_size(fd);
+  snap.data = snap.size ? map_file(fd, &snap.mapping) : NULL;
+  close_file(fd);
+
+  if (snap.data && !(snap.loaded = check_file())) {
+    unmap_file(snap.data, snap.mapping);
+    snap.data = NULL;
+  }
+}
+
+static void add_section(const char *name, const void *data, size_t size)
+{
+  assert(strlen(name) < NAME_SIZE);
+
+  int i = 0;
+  while (i < snap.numSections && strcmp(snap.sections[i].name, name) != 0)
+    i++;
+  if (i == snap.numSections) {
+    assert(snap.numSections < MAX_SECTIONS);
+    snap.numSections++;
+  }
+
+  strcpy(snap.sections[i].name, name);
+  snap.sections[i].data = data;
+  snap.sections[i].size = size;
+}
+
+// snapshot_restore() copies the named table from the snapshot into data
+// and returns true, or returns false if the table has to be computed. In
+// that case the caller passes the computed table to snapshot_record().
+
+bool snapshot_restore(const char *name, void *data, size_t size)
+{
+  if (!snap.loaded)
+    return false;
+
+  const SectionHeader *sh = find_section(name);
+  if (!sh || sh->size != size)
+    return false;
+
+  memcpy(data, sh + 1, size);
+  add_section(name, data, size);
+  snap.numRestored++;
+  return true;
+}
+
+void snapshot_record(const char *name, const void *data, size_t size)
+{
+  if (!snap.file)
+    return;
+
+  add_section(name, data, size);
+  snap.numComputed++;
+}
+
+// sync_file() flushes F and makes sure that its data has reached the disk.
+
+static bool sync_file(FILE *F)
+{
+  if (fflush(F))
+    return false;
+#ifdef _WIN32
+  return _commit(_fileno(F)) == 0;
+#else
+  return fsync(fileno(F)) == 0;
+#endif
+}
+
+// replace_file() renames from to to, replacing to if it already exists.
+
+static bool replace_file(const char *from, const char *to)
+{
+#ifdef _WIN32
+  return MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+  return rename(from, to) == 0;
+#endif
+}
+
+static void write_file(void)
+{
+  static const uint8_t zeros[8];
+  SnapshotHeader h = { "CFSN", SNAPSHOT_VERSION, build_key(), build_key(),
+                       snap.numSections };
+
+  for (int i = 0; i < snap.numSections; i++) {
+    SectionHeader sh = { { 0 }, snap.sections[i].size };
+    strcpy(sh.name, snap.sections[i].name);
+    h.checksum = hash_bytes(h.checksum, &sh, sizeof(sh));
+    h.checksum = hash_bytes(h.checksum, snap.sections[i].data, sh.size);
+    h.checksum = hash_bytes(h.checksum, zeros, padded(sh.size) - sh.size);
+  }
+
+  // Write to a temporary file and rename it over the snapshot only once
+  // it is complete, so that an interrupted write never leaves a truncated
+  // snapshot behind.
+  char *tmpFile = malloc(strlen(snap.file) + 5);
+  if (!tmpFile) {
+    fprintf(stderr, "Unable to write snapshot %s\n", snap.file);
+    return;
+  }
+  sprintf(tmpFile, "%s.tmp", snap.file);
+
+  FILE *F = fopen(tmpFile, "wb");
+  bool ok = F && fwrite(&h, sizeof(h), 1, F) == 1;
+
+  for (int i = 0; ok && i < snap.numSections; i++) {
+    SectionHeader sh = { { 0 }, snap.sections[i].size };
+    strcpy(sh.name, snap.sections[i].name);
+    ok =   fwrite(&sh, sizeof(sh), 1, F) == 1
+        && fwrite(snap.sections[i].data, 1, sh.size, F) == sh.size
+        && fwrite(zeros, 1, padded(sh.size) - sh.size, F) == padded(sh.size) - sh.size;
+  }
+
+  ok = ok && sync_file(F);
+  if (F && fclose(F))
+    ok = false;
+  ok = ok && replace_file(tmpFile, snap.file);
+  if (!ok) {
+    if (F)
+      remove(tmpFile);
+    fprintf(stderr, "Unable to write snapshot %s\n", snap.file);
+  }
+  free(tmpFile);
+}
+
+// snapshot_close() is called after the last *_init() function. It writes
+// a new snapshot if any table had to be computed and stops the timer.
+
+void snapshot_close(void)
+{
+  if (snap.data)
+    unmap_file(snap.data, snap.mapping);
+  snap.data = NULL;
+
+  if (snap.numComputed)
+    write_file();
+
+  snap.elapsed = micros() - snap.startTime;
+}
+
+// snapshot_print_info() reports the time spent in the *_init() functions,
+// for comparing startups with and without a snapshot.
+
+void snapshot_print_info(void)
+{
+  printf("info string Startup time %.3f ms, ", snap.elapsed / 1000.0);
+  if (!snap.file)
+    printf("no snapshot\n");
+  else
+    printf("snapshot %s: %d tables loaded, %d computed\n",
+           snap.file, snap.numRestored, snap.numComputed);
+  fflush(stdout);
+}
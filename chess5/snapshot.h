@@ -0,0 +1,40 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2008 Tord Romstad (Glaurung author)
+  Copyright (C) 2008-2015 Marco Costalba, Joona Kiiski, Tord Romstad
+  Copyright (C) 2015-2016 Marco Costalba, Joona Kiiski, Gary Linscott, Tord Romstad
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Startup snapshots. The expensive tables built by the *_init() functions
+// can be stored in one file and mapped back at the next start instead of
+// being recomputed. The file is selected with the CFISH_SNAPSHOT
+// environment variable: if it holds a valid snapshot for this build it is
+// loaded, otherwise the tables are computed as usual and written to it.
+
+void snapshot_open(const char *file);
+void snapshot_close(void);
+bool snapshot_restore(const char *name, void *data, size_t size);
+void snapshot_record(const char *name, const void *data, size_t size);
+void snapshot_print_info(void);
+
+#endif
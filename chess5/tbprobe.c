@@ -3,6 +3,7 @@
   This file may be redistributed and/or modified without restrictions.
 */
 
+#include <inttypes.h>
 #include <stdatomic.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -113,6 +114,19 @@ static struct PieceEntry *pieceEntry;
 static struct PawnEntry *pawnEntry;
 static struct TbHashEntry tbHash[1 << TB_HASHBITS];
 
+// Results of WDL and DTZ table lookups are kept in a fixed-size cache that
+// is shared by all threads without locking. An entry is a single 64-bit
+// word: the upper 40 bits of the cache key, a 2-bit success code (0 means
+// empty, 1 success, 2 "probe the other side") and a 22-bit value. A racing
+// store can only replace another complete entry, never tear one.
+#define TB_CACHE_KEY_MASK   (~0ULL << 24)
+#define TB_CACHE_VALUE_MASK ((1ULL << 22) - 1)
+
+typedef _Atomic uint64_t TbCacheEntry;
+
+static TbCacheEntry *tbCache;
+static size_t tbCacheMask;
+
 static void init_indices(void);
 
 // Given a position, produce a text string of the form KQPvKRP, where
@@ -322,6 +336,7 @@ void TB_free(void)
   TB_init("");
   free(pieceEntry);
   free(pawnEntry);
+  TB_cache_resize(0);
 }
 
 void TB_release(void)
@@ -332,6 +347,35 @@ void TB_release(void)
     free_tb_entry((struct BaseEntry *)&pawnEntry[i]);
 }
 
+// TB_cache_resize() sets the size of the probe cache in MB, rounded down
+// to a power of two. A size of 0 disables the cache. It must only be called
+// while the search threads are idle, see process_delayed_settings().
+
+void TB_cache_resize(size_t mbSize)
+{
+  free(tbCache);
+  tbCache = NULL;
+  tbCacheMask = 0;
+
+  if (!mbSize)
+    return;
+
+  size_t count = 1ULL << msb((mbSize * 1024 * 1024) / sizeof(TbCacheEntry));
+  tbCache = calloc(count, sizeof(TbCacheEntry));
+  if (!tbCache) {
+    fprintf(stderr, "Failed to allocate %" PRIu64 "MB for the TB cache.\n",
+                    (uint64_t)mbSize);
+    exit(EXIT_FAILURE);
+  }
+  tbCacheMask = count - 1;
+}
+
+void TB_cache_clear(void)
+{
+  if (tbCache)
+    memset((void *)tbCache, 0, (tbCacheMask + 1) * sizeof(TbCacheEntry));
+}
+
 void TB_init(char *path)
 {
   if (!initialized) {
@@ -353,6 +397,7 @@ void TB_init(char *path)
 
   numWdl = numDtm = numDtz = 0;
   tbNumPiece = tbNumPawn = 0;
+  TB_cache_clear();
   TB_MaxCardinality = TB_MaxCardinalityDTM = 0;
 
   // if path is an empty string or equals "<empty>", we are done.
@@ -1287,9 +1332,43 @@ INLINE int probe_table(Position *pos, int s, int *success, const int type)
   return v;
 }
 
+// probe_cached() looks the position up in the probe cache before decoding
+// the table. The cache key combines the position key, which does not depend
+// on the 50-move counter here, with the material key; DTZ lookups use a
+// different key than WDL lookups of the same position. Failed probes are
+// not cached, so tables that are loaded later are still found.
+INLINE int probe_cached(Position *pos, int s, int *success, const int type)
+{
+  if (!tbCache)
+    return probe_table(pos, s, success, type);
+
+  Key key =  pos->st->key ^ material_key()
+           ^ (type == DTZ ? 0x9e3779b97f4a7c15ULL : 0);
+  TbCacheEntry *entry = &tbCache[key & tbCacheMask];
+  uint64_t data = atomic_load_explicit(entry, memory_order_relaxed);
+
+  pos->tbCacheProbes++;
+  if (   (data & TB_CACHE_KEY_MASK) == (key & TB_CACHE_KEY_MASK)
+      && (data >> 22 & 3))
+  {
+    pos->tbCacheHits++;
+    if ((data >> 22 & 3) == 2)
+      *success = -1;
+    return (int)(data & TB_CACHE_VALUE_MASK) - 2;
+  }
+
+  int v = probe_table(pos, s, success, type);
+  if (*success != 0)
+    atomic_store_explicit(entry,  (key & TB_CACHE_KEY_MASK)
+                                | (uint64_t)(*success < 0 ? 2 : 1) << 22
+                                | (uint64_t)(v + 2),
+                          memory_order_relaxed);
+  return v;
+}
+
 static NOINLINE int probe_wdl_table(Position *pos, int *success)
 {
-  return probe_table(pos, 0, success, WDL);
+  return probe_cached(pos, 0, success, WDL);
 }
 
 static NOINLINE int probe_dtm_table(Position *pos, int won, int *success)
@@ -1299,7 +1378,7 @@ static NOINLINE int probe_dtm_table(Position *pos, int won, int *success)
 
 static NOINLINE int probe_dtz_table(Position *pos, int wdl, int *success)
 {
-  return probe_table(pos, wdl, success, DTZ);
+  return probe_cached(pos, wdl, success, DTZ);
 }
 
 // Add missing underpromotion captures to list of captures.
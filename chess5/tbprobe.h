@@ -9,6 +9,8 @@ extern int TB_MaxCardinalityDTM;
 void TB_init(char *path);
 void TB_free(void);
 void TB_release(void);
+void TB_cache_resize(size_t mbSize);
+void TB_cache_clear(void);
 int TB_probe_wdl(Position *pos, int *success);
 int TB_probe_dtz(Position *pos, int *success);
 Value TB_probe_dtm(Position *pos, int wdl, int *success);
@@ -25,6 +25,7 @@
 #include "movepick.h"
 #include "numa.h"
 #include "pawns.h"
+#include "prof.h"
 #include "search.h"
 #include "settings.h"
 #include "thread.h"
@@ -52,6 +53,10 @@ static THREAD_FUNC thread_init(void *arg)
 {
   int idx = (intptr_t)arg;
 
+#ifdef PROF
+  prof_bind_thread(idx);
+#endif
+
   int node;
   if (settings.numaEnabled)
     node = bind_thread_to_numa_node(idx);
@@ -452,3 +457,24 @@ uint64_t threads_tb_hits(void)
     hits += Threads.pos[idx]->tbHits;
   return hits;
 }
+
+
+// threads_tb_cache_hits() and threads_tb_cache_probes() return the number
+// of TB table lookups answered by the probe cache and the number of
+// lookups that went through it.
+
+uint64_t threads_tb_cache_hits(void)
+{
+  uint64_t hits = 0;
+  for (int idx = 0; idx < Threads.numThreads; idx++)
+    hits += Threads.pos[idx]->tbCacheHits;
+  return hits;
+}
+
+uint64_t threads_tb_cache_probes(void)
+{
+  uint64_t probes = 0;
+  for (int idx = 0; idx < Threads.numThreads; idx++)
+    probes += Threads.pos[idx]->tbCacheProbes;
+  return probes;
+}
@@ -98,6 +98,8 @@ void threads_start_thinking(Position *pos, LimitsType *);
 void threads_set_number(int num);
 uint64_t threads_nodes_searched(void);
 uint64_t threads_tb_hits(void);
+uint64_t threads_tb_cache_hits(void);
+uint64_t threads_tb_cache_probes(void);
 
 extern ThreadPool Threads;
 
@@ -0,0 +1,217 @@
+/*
+  bookpack converts a PolyGlot .bin book into the packed format described
+  in packbook.h:
+
+    bookpack <input.bin> <output.pkb>
+
+  The packed file can be loaded like any other book file or embedded with
+  USE_EMBEDDED_BOOK and EMBEDDED_BOOK_FILE.
+*/
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../packbook.h"
+
+typedef struct {
+  uint64_t key;
+  uint16_t move;
+  uint16_t weight;
+  uint32_t order;
+} Entry;
+
+typedef struct {
+  uint8_t *data;
+  size_t size, capacity;
+  uint64_t bits;
+  int numBits;
+} Writer;
+
+static uint64_t read_be(const uint8_t *p, int bytes)
+{
+  uint64_t v = 0;
+  for (int i = 0; i < bytes; i++)
+    v = (v << 8) | p[i];
+  return v;
+}
+
+static void put_byte(Writer *w, uint8_t b)
+{
+  if (w->size == w->capacity) {
+    w->capacity = w->capacity ? 2 * w->capacity : 65536;
+    w->data = realloc(w->data, w->capacity);
+    if (!w->data) {
+      fprintf(stderr, "Out of memory\n");
+      exit(EXIT_FAILURE);
+    }
+  }
+  w->data[w->size++] = b;
+}
+
+static void put_le(Writer *w, uint64_t v, int bytes)
+{
+  for (int i = 0; i < bytes; i++)
+    put_byte(w, (uint8_t)(v >> (8 * i)));
+}
+
+static void put_bits(Writer *w, uint64_t v, int n)
+{
+  for (int i = 0; i < n; i++) {
+    w->bits |= ((v >> i) & 1) << w->numBits;
+    if (++w->numBits == 8) {
+      put_byte(w, (uint8_t)w->bits);
+      w->bits = 0;
+      w->numBits = 0;
+    }
+  }
+}
+
+static void flush_bits(Writer *w)
+{
+  if (w->numBits) {
+    put_byte(w, (uint8_t)w->bits);
+    w->bits = 0;
+    w->numBits = 0;
+  }
+}
+
+static int bit_width(uint64_t v)
+{
+  int n = 0;
+  while (v) {
+    n++;
+    v >>= 1;
+  }
+  return n;
+}
+
+// Keep the PolyGlot order (by key, then as stored) in case the input is not
+// perfectly sorted.
+static int entry_cmp(const void *a, const void *b)
+{
+  const Entry *x = a, *y = b;
+  if (x->key != y->key)
+    return x->key < y->key ? -1 : 1;
+  return x->order < y->order ? -1 : x->order > y->order;
+}
+
+int main(int argc, char **argv)
+{
+  if (argc != 3) {
+    fprintf(stderr, "Usage: %s <input.bin> <output.pkb>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  FILE *F = fopen(argv[1], "rb");
+  if (!F) {
+    fprintf(stderr, "Unable to open file %s\n", argv[1]);
+    return EXIT_FAILURE;
+  }
+  fseek(F, 0, SEEK_END);
+  long inSize = ftell(F);
+  fseek(F, 0, SEEK_SET);
+  uint8_t *in = malloc(inSize > 0 ? inSize : 1);
+  if (!in || fread(in, 1, inSize, F) != (size_t)inSize) {
+    fprintf(stderr, "Unable to read file %s\n", argv[1]);
+    return EXIT_FAILURE;
+  }
+  fclose(F);
+
+  uint32_t count = inSize / 16;
+  if (count == 0 || inSize % 16) {
+    fprintf(stderr, "%s is not a PolyGlot book\n", argv[1]);
+    return EXIT_FAILURE;
+  }
+
+  Entry *entries = malloc(count * sizeof(Entry));
+  for (uint32_t i = 0; i < count; i++) {
+    const uint8_t *p = in + 16 * i;
+    entries[i].key = read_be(p, 8);
+    entries[i].move = read_be(p + 8, 2) & ((1 << PKB_MOVE_BITS) - 1);
+    entries[i].weight = read_be(p + 10, 2);
+    entries[i].order = i;
+  }
+  free(in);
+  qsort(entries, count, sizeof(Entry), entry_cmp);
+
+  uint32_t blockCount = (count + PKB_BLOCK_ENTRIES - 1) / PKB_BLOCK_ENTRIES;
+  uint32_t *offsets = malloc(blockCount * sizeof(uint32_t));
+
+  // Encode the blocks first; the index is written in front of them later.
+  size_t dataStart = PKB_HEADER_SIZE + (size_t)blockCount * PKB_INDEX_ENTRY_SIZE;
+  Writer blocks = { 0 };
+
+  for (uint32_t b = 0; b < blockCount; b++) {
+    uint32_t first = b * PKB_BLOCK_ENTRIES;
+    uint32_t last = first + PKB_BLOCK_ENTRIES < count ? first + PKB_BLOCK_ENTRIES : count;
+    uint64_t maxDelta = 0;
+    uint16_t maxWeight = 0;
+
+    for (uint32_t i = first; i < last; i++) {
+      if (i > first && entries[i].key - entries[i - 1].key > maxDelta)
+        maxDelta = entries[i].key - entries[i - 1].key;
+      if (entries[i].weight > maxWeight)
+        maxWeight = entries[i].weight;
+    }
+
+    int deltaBits = bit_width(maxDelta);
+    int weightBits = bit_width(maxWeight);
+
+    offsets[b] = dataStart + blocks.size;
+    put_byte(&blocks, deltaBits);
+    put_byte(&blocks, weightBits);
+
+    for (uint32_t i = first; i < last; i++) {
+      if (i > first) {
+        uint64_t delta = entries[i].key - entries[i - 1].key;
+        put_bits(&blocks, delta != 0, 1);
+        if (delta)
+          put_bits(&blocks, delta, deltaBits);
+      }
+      put_bits(&blocks, entries[i].move, PKB_MOVE_BITS);
+      put_bits(&blocks, entries[i].weight, weightBits);
+    }
+    flush_bits(&blocks);
+  }
+
+  if (dataStart + blocks.size > UINT32_MAX) {
+    fprintf(stderr, "Book too large\n");
+    return EXIT_FAILURE;
+  }
+
+  Writer out = { 0 };
+  for (int i = 0; i < 4; i++)
+    put_byte(&out, PKB_MAGIC[i]);
+  put_le(&out, count, 4);
+  put_le(&out, blockCount, 4);
+  put_le(&out, PKB_BLOCK_ENTRIES, 4);
+  for (uint32_t b = 0; b < blockCount; b++) {
+    put_le(&out, entries[b * PKB_BLOCK_ENTRIES].key, 8);
+    put_le(&out, offsets[b], 4);
+  }
+
+  F = fopen(argv[2], "wb");
+  if (   !F
+      || fwrite(out.data, 1, out.size, F) != out.size
+      || fwrite(blocks.data, 1, blocks.size, F) != blocks.size
+      || fclose(F))
+  {
+    fprintf(stderr, "Unable to write file %s\n", argv[2]);
+    return EXIT_FAILURE;
+  }
+
+  size_t outSize = out.size + blocks.size;
+  printf("%s: %" PRIu32 " entries, %" PRIu32 " blocks, %ld -> %zu bytes (%.1f%%)\n",
+         argv[2], count, blockCount, inSize, outSize, 100.0 * outSize / inSize);
+
+  free(out.data);
+  free(blocks.data);
+  free(offsets);
+  free(entries);
+
+  return EXIT_SUCCESS;
+}
@@ -27,6 +27,7 @@
 
 #include "bitboard.h"
 #include "numa.h"
+#include "prof.h"
 #include "settings.h"
 #include "thread.h"
 #include "tt.h"
@@ -122,7 +123,7 @@ void tt_clear_worker(int idx)
 // considered more valuable than TTEntry t2 if its replace value is greater
 // than that of t2.
 
-TTEntry *tt_probe(Key key, bool *found)
+INLINE TTEntry *probe(Key key, bool *found)
 {
   TTEntry *tte = tt_first_entry(key);
   uint16_t key16 = key; // Use the low 16 bits as key inside the cluster
@@ -150,6 +151,15 @@ TTEntry *tt_probe(Key key, bool *found)
   return replace;
 }
 
+TTEntry *tt_probe(Key key, bool *found)
+{
+  PROF_BEGIN(TT_PROBE);
+  TTEntry *tte = probe(key, found);
+  PROF_END(TT_PROBE);
+
+  return tte;
+}
+
 
 // Returns an approximation of the hashtable occupation during a search. The
 // hash is x permill full, as per UCI protocol.
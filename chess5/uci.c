@@ -26,6 +26,7 @@
 #include "position.h"
 #include "search.h"
 #include "settings.h"
+#include "snapshot.h"
 #include "thread.h"
 #include "timeman.h"
 #include "uci.h"
@@ -345,6 +346,7 @@ void uci_loop(int argc, char **argv)
       benchmark(&pos, str_buf);
     }
     else if (strcmp(token, "compiler") == 0)  print_compiler_info();
+    else if (strcmp(token, "startup") == 0)   snapshot_print_info();
     #ifndef NO_NNUE
     else if (strcmp(token, "export_net") == 0) nnue_export_net();
     #endif
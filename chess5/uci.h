@@ -54,6 +54,7 @@ enum {
   OPT_SYZ_50_MOVE,
   OPT_SYZ_PROBE_LIMIT,
   OPT_SYZ_USE_DTM,
+  OPT_SYZ_CACHE,
   OPT_BOOK_FILE,
   OPT_BOOK_FILE2,
   OPT_BOOK_BEST_MOVE,
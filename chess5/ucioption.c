@@ -77,6 +77,11 @@ static void on_tb_path(Option *opt)
   TB_init(opt->valString);
 }
 
+static void on_tb_cache(Option *opt)
+{
+  delayedSettings.tbCacheSize = opt->value;
+}
+
 static void on_large_pages(Option *opt)
 {
   delayedSettings.largePages = opt->value;
@@ -128,6 +133,7 @@ static Option optionsMap[] = {
   { "Syzygy50MoveRule", OPT_TYPE_CHECK, 1, 0, 0, NULL, NULL, 0, NULL },
   { "SyzygyProbeLimit", OPT_TYPE_SPIN, 7, 0, 7, NULL, NULL, 0, NULL },
   { "SyzygyUseDTM", OPT_TYPE_CHECK, 1, 0, 0, NULL, NULL, 0, NULL },
+  { "SyzygyCache", OPT_TYPE_SPIN, 4, 0, 1024, NULL, on_tb_cache, 0, NULL },
   { "BookFile", OPT_TYPE_STRING, 0, 0, 0, DEFAULT_BOOK_FILE, on_book_file, 0, NULL },
   { "BookFile2", OPT_TYPE_STRING, 0, 0, 0, "<empty>", on_book_file2, 0, NULL },
   { "BestBookMove", OPT_TYPE_CHECK, 0, 0, 0, NULL, on_best_book_move, 0, NULL }, //balsa3750.bin bestbookmove = false, 0